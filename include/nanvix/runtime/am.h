@@ -0,0 +1,182 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef NANVIX_RUNTIME_AM_H_
+#define NANVIX_RUNTIME_AM_H_
+
+	#include <nanvix/sys/mailbox.h>
+
+#if __TARGET_HAS_MAILBOX
+
+	#include <posix/stddef.h>
+	#include <posix/stdint.h>
+	#include <posix/sys/types.h>
+
+	/**
+	 * @brief Maximum number of handlers.
+	 */
+	#ifndef AM_HANDLER_MAX
+	#define AM_HANDLER_MAX 16
+	#endif
+
+	/**
+	 * @brief Size of the header of an active message.
+	 */
+	#define AM_HEADER_SIZE 12
+
+	/**
+	 * @brief Maximum size of the payload of an active message.
+	 */
+	#define AM_PAYLOAD_MAX (KMAILBOX_MESSAGE_SIZE - AM_HEADER_SIZE)
+
+	/**
+	 * @brief Handler of active messages.
+	 *
+	 * @param source  Node that sent the message.
+	 * @param payload Payload of the message.
+	 * @param size    Size of @p payload.
+	 * @param reply   Store location for a reply of up to AM_PAYLOAD_MAX
+	 * bytes.
+	 *
+	 * @returns The size of the reply written to @p reply, or a negative
+	 * error code that is delivered to the caller. The return value is
+	 * discarded for messages sent with am_send().
+	 */
+	typedef ssize_t (*am_handler_t)(int source, const void *payload, size_t size, void *reply);
+
+	/**
+	 * @brief Registers a handler.
+	 *
+	 * @param handler ID of the handler.
+	 * @param fn      Handler function.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int am_register(int handler, am_handler_t fn);
+
+	/**
+	 * @brief Unregisters a handler.
+	 *
+	 * @param handler ID of the handler.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int am_unregister(int handler);
+
+	/**
+	 * @brief Sends an active message.
+	 *
+	 * The message is delivered to the standard input mailbox hooked up
+	 * in port @p port of node @p remote, and runs the handler @p
+	 * handler there. Messages from a thread to a given port run in the
+	 * order in which they were sent.
+	 *
+	 * @param remote  Target node.
+	 * @param port    Port of the standard input mailbox of the target.
+	 * @param handler ID of the handler.
+	 * @param payload Payload.
+	 * @param size    Size of @p payload.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int am_send(int remote, int port, int handler, const void *payload, size_t size);
+
+	/**
+	 * @brief Runs a handler remotely and waits for its reply.
+	 *
+	 * The reply is delivered to the standard input mailbox of the
+	 * calling thread. Active messages that arrive meanwhile are
+	 * dispatched, so two threads may call each other. Handlers must
+	 * not call am_call() themselves.
+	 *
+	 * @param remote     Target node.
+	 * @param port       Port of the standard input mailbox of the target.
+	 * @param handler    ID of the handler.
+	 * @param payload    Payload.
+	 * @param size       Size of @p payload.
+	 * @param reply      Store location for the reply.
+	 * @param reply_size Size of @p reply.
+	 *
+	 * @returns Upon successful completion, the size of the reply is
+	 * returned. Upon failure, a negative error code is returned
+	 * instead, which may come from the handler.
+	 */
+	extern ssize_t am_call(
+		int remote,
+		int port,
+		int handler,
+		const void *payload,
+		size_t size,
+		void *reply,
+		size_t reply_size
+	);
+
+	/**
+	 * @brief Dispatches active messages without blocking.
+	 *
+	 * Messages are taken from the standard input mailbox of the calling
+	 * thread, which must not be used for anything else.
+	 *
+	 * @returns The number of dispatched messages.
+	 */
+	extern int am_progress(void);
+
+	/**
+	 * @brief Starts the handler thread.
+	 *
+	 * The handler thread dispatches active messages that arrive at its
+	 * own standard input mailbox, until am_thread_stop() is called.
+	 *
+	 * @returns Upon successful completion, the port of the standard
+	 * input mailbox of the handler thread is returned. Upon failure, a
+	 * negative error code is returned instead.
+	 */
+	extern int am_thread_start(void);
+
+	/**
+	 * @brief Stops the handler thread.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int am_thread_stop(void);
+
+	/**
+	 * @brief Closes the output mailboxes of the active message layer.
+	 *
+	 * Output mailboxes are opened on first use and kept open until it
+	 * is called.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int am_cleanup(void);
+
+#endif /* __TARGET_HAS_MAILBOX */
+
+#endif /* NANVIX_RUNTIME_AM_H_ */
@@ -81,4 +81,30 @@
 	 */
 	extern int barrier_wait(barrier_t barrier);
 
+	/**
+	 * @brief Announces the arrival of the calling peer at a barrier.
+	 *
+	 * @param barrier Target barrier.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon failure,
+	 * a negative error code is returned instead.
+	 *
+	 * @note The calling peer may do work that does not depend on other
+	 * peers before calling barrier_wait_arrived().
+	 */
+	extern int barrier_arrive(barrier_t barrier);
+
+	/**
+	 * @brief Waits for the other peers at a barrier.
+	 *
+	 * @param barrier Target barrier.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon failure,
+	 * a negative error code is returned instead.
+	 *
+	 * @note The calling peer must have arrived at @p barrier with
+	 * barrier_arrive().
+	 */
+	extern int barrier_wait_arrived(barrier_t barrier);
+
 #endif /* NANVIX_RUNTIME_BARRIER_H_ */
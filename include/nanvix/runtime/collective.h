@@ -0,0 +1,261 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef NANVIX_RUNTIME_COLLECTIVE_H_
+#define NANVIX_RUNTIME_COLLECTIVE_H_
+
+	#include <nanvix/sys/portal.h>
+	#include <nanvix/sys/sync.h>
+
+#if (__TARGET_HAS_PORTAL && __TARGET_HAS_SYNC)
+
+	#include <posix/stddef.h>
+	#include <posix/stdint.h>
+
+	/**
+	 * @brief Size of the pieces in which collective data is transferred.
+	 *
+	 * It is rounded down to a multiple of the largest element type, so
+	 * that pieces never split an element.
+	 */
+	#define NANVIX_COLLECTIVE_CHUNK_SIZE \
+		(KPORTAL_MESSAGE_DATA_SIZE & ~(sizeof(uint64_t) - 1))
+
+	/**
+	 * @brief Largest message (in bytes) moved with tree algorithms.
+	 *
+	 * Smaller messages are latency-bound and use binomial trees.
+	 * Larger messages are bandwidth-bound and use pipelined rings.
+	 */
+	#ifndef NANVIX_COLLECTIVE_TREE_MAX
+	#define NANVIX_COLLECTIVE_TREE_MAX NANVIX_COLLECTIVE_CHUNK_SIZE
+	#endif
+
+	/**
+	 * @name Element types.
+	 */
+	/**@{*/
+	#define NANVIX_COLLECTIVE_INT8   0 /**< int8_t   */
+	#define NANVIX_COLLECTIVE_UINT8  1 /**< uint8_t  */
+	#define NANVIX_COLLECTIVE_INT32  2 /**< int32_t  */
+	#define NANVIX_COLLECTIVE_UINT32 3 /**< uint32_t */
+	#define NANVIX_COLLECTIVE_INT64  4 /**< int64_t  */
+	#define NANVIX_COLLECTIVE_UINT64 5 /**< uint64_t */
+	#define NANVIX_COLLECTIVE_FLOAT  6 /**< float    */
+	#define NANVIX_COLLECTIVE_DOUBLE 7 /**< double   */
+	/**@}*/
+
+	/**
+	 * @name Reduction operators.
+	 */
+	/**@{*/
+	#define NANVIX_COLLECTIVE_SUM  0 /**< Sum.     */
+	#define NANVIX_COLLECTIVE_PROD 1 /**< Product. */
+	#define NANVIX_COLLECTIVE_MIN  2 /**< Minimum. */
+	#define NANVIX_COLLECTIVE_MAX  3 /**< Maximum. */
+	/**@}*/
+
+	/**
+	 * @brief Group of nodes that take part in collective operations.
+	 *
+	 * All nodes of a group hook up an input portal in the same port,
+	 * and keep one output portal to each other node. A group may be
+	 * used by a single thread of each node at a time.
+	 */
+	struct nanvix_collective
+	{
+		int nnodes;                                                         /**< Number of nodes.             */
+		int rank;                                                           /**< Rank of the local node.      */
+		int port;                                                           /**< Port of the input portals.   */
+		int inportal;                                                       /**< Input portal.                */
+		int nodes[PROCESSOR_CLUSTERS_NUM];                                  /**< Logic IDs of the nodes.      */
+		int outportals[PROCESSOR_CLUSTERS_NUM];                             /**< Output portals to each node. */
+		uint64_t scratch[NANVIX_COLLECTIVE_CHUNK_SIZE / sizeof(uint64_t)]; /**< Buffer for reductions.       */
+	};
+
+	/**
+	 * @brief Initializes a group for collective operations.
+	 *
+	 * All nodes in @p nodes must call it with the same arguments.
+	 *
+	 * @param coll   Target group.
+	 * @param nodes  Logic IDs of the nodes, or NULL for all clusters.
+	 * @param nnodes Number of nodes in @p nodes.
+	 * @param port   Port used by the group in all nodes.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_collective_init(
+		struct nanvix_collective *coll,
+		const int *nodes,
+		int nnodes,
+		int port
+	);
+
+	/**
+	 * @brief Releases the underlying resources of a group.
+	 *
+	 * @param coll Target group.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_collective_finalize(struct nanvix_collective *coll);
+
+	/**
+	 * @brief Broadcasts data from a root node to all nodes of a group.
+	 *
+	 * @param coll  Target group.
+	 * @param buf   Data to send in the root, store location elsewhere.
+	 * @param count Number of elements in @p buf.
+	 * @param type  Type of the elements.
+	 * @param root  Rank of the root node.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_collective_broadcast(
+		struct nanvix_collective *coll,
+		void *buf,
+		size_t count,
+		int type,
+		int root
+	);
+
+	/**
+	 * @brief Scatters data from a root node to all nodes of a group.
+	 *
+	 * @param coll    Target group.
+	 * @param sendbuf Data to scatter, significant only in the root.
+	 * @param recvbuf Store location for the piece of the local node.
+	 * @param count   Number of elements sent to each node.
+	 * @param type    Type of the elements.
+	 * @param root    Rank of the root node.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_collective_scatter(
+		struct nanvix_collective *coll,
+		const void *sendbuf,
+		void *recvbuf,
+		size_t count,
+		int type,
+		int root
+	);
+
+	/**
+	 * @brief Gathers data from all nodes of a group in a root node.
+	 *
+	 * @param coll    Target group.
+	 * @param sendbuf Data of the local node.
+	 * @param recvbuf Store location for all data, significant only in the root.
+	 * @param count   Number of elements sent by each node.
+	 * @param type    Type of the elements.
+	 * @param root    Rank of the root node.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_collective_gather(
+		struct nanvix_collective *coll,
+		const void *sendbuf,
+		void *recvbuf,
+		size_t count,
+		int type,
+		int root
+	);
+
+	/**
+	 * @brief Gathers data from all nodes of a group in all nodes.
+	 *
+	 * @param coll    Target group.
+	 * @param sendbuf Data of the local node.
+	 * @param recvbuf Store location for all data.
+	 * @param count   Number of elements sent by each node.
+	 * @param type    Type of the elements.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_collective_allgather(
+		struct nanvix_collective *coll,
+		const void *sendbuf,
+		void *recvbuf,
+		size_t count,
+		int type
+	);
+
+	/**
+	 * @brief Reduces data of all nodes of a group in a root node.
+	 *
+	 * @param coll    Target group.
+	 * @param sendbuf Data of the local node.
+	 * @param recvbuf Store location for the result. It is used as
+	 *                working space in nodes other than the root.
+	 * @param count   Number of elements in @p sendbuf.
+	 * @param type    Type of the elements.
+	 * @param op      Reduction operator.
+	 * @param root    Rank of the root node.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_collective_reduce(
+		struct nanvix_collective *coll,
+		const void *sendbuf,
+		void *recvbuf,
+		size_t count,
+		int type,
+		int op,
+		int root
+	);
+
+	/**
+	 * @brief Reduces data of all nodes of a group in all nodes.
+	 *
+	 * @param coll    Target group.
+	 * @param sendbuf Data of the local node.
+	 * @param recvbuf Store location for the result.
+	 * @param count   Number of elements in @p sendbuf.
+	 * @param type    Type of the elements.
+	 * @param op      Reduction operator.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_collective_allreduce(
+		struct nanvix_collective *coll,
+		const void *sendbuf,
+		void *recvbuf,
+		size_t count,
+		int type,
+		int op
+	);
+
+#endif /* __TARGET_HAS_PORTAL && __TARGET_HAS_SYNC */
+
+#endif /* NANVIX_RUNTIME_COLLECTIVE_H_ */
@@ -0,0 +1,177 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NANVIX_RUNTIME_PERFSESSION_H_
+#define NANVIX_RUNTIME_PERFSESSION_H_
+
+	#include <nanvix/kernel/kernel.h>
+
+#if (CORE_HAS_PERF)
+
+	#include <nanvix/sys/perf.h>
+	#include <nanvix/sys/thread.h>
+	#include <nanvix/sys/tls.h>
+	#include <posix/stdbool.h>
+	#include <posix/stdint.h>
+
+	/**
+	 * @brief Number of hardware monitors that a session may use at once.
+	 */
+	#ifndef NANVIX_PERF_SESSION_MONITORS
+	#define NANVIX_PERF_SESSION_MONITORS PERF_MONITORS_NUM
+	#endif
+
+	/**
+	 * @brief Maximum number of events in a session.
+	 */
+	#define NANVIX_PERF_SESSION_EVENTS_MAX PERF_EVENTS_MAX
+
+	/**
+	 * @brief Number of per-thread slots in a session.
+	 */
+	#define NANVIX_PERF_SESSION_THREADS NANVIX_TLS_THREADS
+
+	/**
+	 * @brief Selects the aggregation of all threads.
+	 */
+	#define NANVIX_PERF_SESSION_ALL (-1)
+
+	/**
+	 * @brief Per-thread samples of a session.
+	 */
+	struct nanvix_perf_samples
+	{
+		bool running;                                      /**< Is a run in progress?         */
+		int group;                                         /**< Group of the current run.     */
+		uint64_t nruns;                                    /**< Number of completed runs.     */
+		uint64_t nsamples[NANVIX_PERF_SESSION_EVENTS_MAX]; /**< Runs that sampled each event. */
+		uint64_t values[NANVIX_PERF_SESSION_EVENTS_MAX];   /**< Accumulated values.           */
+	};
+
+	/**
+	 * @brief Performance monitoring session.
+	 *
+	 * A session watches a set of events around a code region. When
+	 * the set has more events than hardware monitors, events are split
+	 * into groups and each run of the region samples one group, in a
+	 * round-robin fashion.
+	 */
+	struct nanvix_perf_session
+	{
+		int nevents;                                                     /**< Number of events. */
+		int ngroups;                                                     /**< Number of groups. */
+		int events[NANVIX_PERF_SESSION_EVENTS_MAX];                      /**< Watched events.   */
+		struct nanvix_perf_samples threads[NANVIX_PERF_SESSION_THREADS]; /**< Samples.          */
+		spinlock_t lock;                                                 /**< Lock.             */
+	};
+
+	/**
+	 * @brief Result of an event in a session.
+	 */
+	struct nanvix_perf_result
+	{
+		int event;         /**< Event.                                 */
+		uint64_t nruns;    /**< Number of completed runs.              */
+		uint64_t nsamples; /**< Number of runs that sampled the event. */
+		uint64_t value;    /**< Accumulated value.                     */
+		uint64_t estimate; /**< Value extrapolated to all runs.        */
+	};
+
+	/**
+	 * @brief Initializes a performance monitoring session.
+	 *
+	 * @param session Target session.
+	 * @param events  Events to watch.
+	 * @param nevents Number of events in @p events.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_perf_session_init(
+		struct nanvix_perf_session *session,
+		const int *events,
+		int nevents
+	);
+
+	/**
+	 * @brief Starts a run of a session in the calling thread.
+	 *
+	 * @param session Target session.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_perf_session_start(struct nanvix_perf_session *session);
+
+	/**
+	 * @brief Stops a run of a session in the calling thread.
+	 *
+	 * @param session Target session.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_perf_session_stop(struct nanvix_perf_session *session);
+
+	/**
+	 * @brief Gets the results of a session.
+	 *
+	 * @param session Target session.
+	 * @param thread  Thread slot or NANVIX_PERF_SESSION_ALL.
+	 * @param results Store location for one result per event.
+	 *
+	 * @returns Upon successful completion, the number of results
+	 * written to @p results is returned. Upon failure, a negative error
+	 * code is returned instead.
+	 */
+	extern int nanvix_perf_session_results(
+		struct nanvix_perf_session *session,
+		int thread,
+		struct nanvix_perf_result *results
+	);
+
+	/**
+	 * @brief Prints the results of a session to the standard output.
+	 *
+	 * @param session Target session.
+	 * @param thread  Thread slot or NANVIX_PERF_SESSION_ALL.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_perf_session_print(struct nanvix_perf_session *session, int thread);
+
+	/**
+	 * @brief Discards all samples of a session.
+	 *
+	 * @param session Target session.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_perf_session_reset(struct nanvix_perf_session *session);
+
+#endif /* CORE_HAS_PERF */
+
+#endif /* NANVIX_RUNTIME_PERFSESSION_H_ */
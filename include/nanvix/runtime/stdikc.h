@@ -37,13 +37,21 @@
 	/**
 	 * @brief Waits/Releases the standard kernel fence.
 	 *
+	 * All threads that joined the standard sync facility in the local
+	 * cluster must call it, and only one barrier per cluster is
+	 * crossed.
+	 *
 	 * @return Upon successful completion, zero is returned. Upon
 	 * failure, a negative error code is returned instead.
 	 */
 	extern int stdsync_fence(void);
 
 	/**
-	 * @brief Initializes the kernel standard sync facility.
+	 * @brief Joins the calling thread to the kernel standard sync facility.
+	 *
+	 * The first thread of the cluster to join creates the barrier
+	 * among clusters. It must not be called while threads of the
+	 * cluster wait in stdsync_fence().
 	 *
 	 * @return Upon successful completion, a non-negative number is
 	 * returned. Upon failure, a negative error code is returned
@@ -52,7 +60,7 @@
 	extern int __stdsync_setup(void);
 
 	/**
-	 * @brief Initializes the kernel standard sync facility.
+	 * @brief Detaches the calling thread from the kernel standard sync facility.
 	 *
 	 * @return Upon successful completion, a non-negative number is
 	 * returned. Upon failure, a negative error code is returned
@@ -60,6 +68,15 @@
 	 */
 	extern int __stdsync_cleanup(void);
 
+	/**
+	 * @brief Builds a list of node IDs.
+	 *
+	 * @param nodes       Store location for the node IDs.
+	 * @param nioclusters Number of IO Clusters.
+	 * @param ncclusters  Number of Compute Clusters.
+	 */
+	extern void build_node_list(int *nodes, int nioclusters, int ncclusters);
+
 /*============================================================================*
  * Kernel Standard Mailbox                                                    *
  *============================================================================*/
@@ -67,8 +84,13 @@
 	/**
 	 * @brief Gets the port number of the standard input mailbox.
 	 *
+	 * The port is derived from the ID of the calling thread, so remote
+	 * peers can predict it. The standard input mailbox of a thread is
+	 * created on first use.
+	 *
 	 * @returns The port number where the standard input mailbox is
-	 * hooked up.
+	 * hooked up, or a negative number if the calling thread has no
+	 * port.
 	 */
 	extern int stdinbox_get_port(void);
 
@@ -104,8 +126,13 @@
 	/**
 	 * @brief Gets the port number of the standard input portal.
 	 *
+	 * The port is derived from the ID of the calling thread, so remote
+	 * peers can predict it. The standard input portal of a thread is
+	 * created on first use.
+	 *
 	 * @returns The port number where the standard input portal is
-	 * hooked up.
+	 * hooked up, or a negative number if the calling thread has no
+	 * port.
 	 */
 	extern int stdinportal_get_port(void);
 
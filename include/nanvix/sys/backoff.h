@@ -0,0 +1,97 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @addtogroup nanvix Nanvix System
+ */
+/**@{*/
+
+#ifndef NANVIX_SYS_BACKOFF_H_
+#define NANVIX_SYS_BACKOFF_H_
+
+	#include <nanvix/kernel/kernel.h>
+	#include <posix/stdint.h>
+
+	/**
+	 * @name Wait policies.
+	 */
+	/**@{*/
+	#define NANVIX_BACKOFF_SPIN         0 /**< Retry at once.                    */
+	#define NANVIX_BACKOFF_EXPONENTIAL  1 /**< Delay exponentially, then yield.  */
+	#define NANVIX_BACKOFF_YIELD        2 /**< Yield the core before each retry. */
+	#define NANVIX_BACKOFF_POLICIES_NUM 3 /**< Number of policies.               */
+	/**@}*/
+
+	/**
+	 * @brief Policy of new communicators.
+	 */
+	#ifndef NANVIX_BACKOFF_DEFAULT
+	#define NANVIX_BACKOFF_DEFAULT NANVIX_BACKOFF_EXPONENTIAL
+	#endif
+
+	/**
+	 * @name Bounds of the exponential delay (in loop iterations).
+	 */
+	/**@{*/
+	#ifndef NANVIX_BACKOFF_DELAY_MIN
+	#define NANVIX_BACKOFF_DELAY_MIN 16
+	#endif
+	#ifndef NANVIX_BACKOFF_DELAY_MAX
+	#define NANVIX_BACKOFF_DELAY_MAX 4096
+	#endif
+	/**@}*/
+
+	/**
+	 * @brief Asserts whether or not a wait policy is valid.
+	 */
+	#define NANVIX_BACKOFF_IS_VALID(policy) \
+		WITHIN(policy, 0, NANVIX_BACKOFF_POLICIES_NUM)
+
+	/**
+	 * @brief State of a retry loop.
+	 */
+	struct nanvix_backoff
+	{
+		int policy;     /**< Wait policy.   */
+		uint32_t delay; /**< Current delay. */
+	};
+
+	/**
+	 * @brief Initializes the state of a retry loop.
+	 *
+	 * @param backoff Target state.
+	 * @param policy  Wait policy.
+	 */
+	extern void nanvix_backoff_init(struct nanvix_backoff *backoff, int policy);
+
+	/**
+	 * @brief Waits before the next retry of a loop.
+	 *
+	 * @param backoff Target state.
+	 */
+	extern void nanvix_backoff_wait(struct nanvix_backoff *backoff);
+
+#endif /* NANVIX_SYS_BACKOFF_H_ */
+
+/**@}*/
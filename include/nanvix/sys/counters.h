@@ -0,0 +1,150 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @addtogroup nanvix Nanvix System
+ */
+/**@{*/
+
+#ifndef NANVIX_SYS_COUNTERS_H_
+#define NANVIX_SYS_COUNTERS_H_
+
+	#include <nanvix/kernel/kernel.h>
+	#include <nanvix/sys/tls.h>
+	#include <posix/stdint.h>
+
+	/**
+	 * @brief If the configuration of IKC statistics is missing, then
+	 * enable them.
+	 */
+	#ifndef __NANVIX_IKC_STATS
+	#define __NANVIX_IKC_STATS 1
+	#endif
+
+	/**
+	 * @brief Maximum number of counters in a set.
+	 */
+	#define NANVIX_COUNTERS_MAX 6
+
+	/**
+	 * @brief Number of shards in a counter set.
+	 *
+	 * There is one shard per thread slot, and one more for counting
+	 * points that already hold a lock.
+	 */
+	#define NANVIX_COUNTERS_SHARDS (NANVIX_TLS_THREADS + 1)
+
+	/**
+	 * @brief Shard of counting points that already hold a lock.
+	 */
+	#define NANVIX_COUNTERS_LOCKED NANVIX_TLS_THREADS
+
+	/**
+	 * @brief Shard of a counter set.
+	 *
+	 * Each shard is only written by the thread that owns its slot, so
+	 * counters are incremented without locks. Shards are aligned to a
+	 * cache line, so that threads do not false-share.
+	 */
+	struct nanvix_counters_shard
+	{
+		uint64_t values[NANVIX_COUNTERS_MAX]; /**< Counters. */
+	} ALIGN(CACHE_LINE_SIZE);
+
+	/**
+	 * @brief Set of sharded counters.
+	 */
+	struct nanvix_counters
+	{
+		struct nanvix_counters_shard shards[NANVIX_COUNTERS_SHARDS]; /**< Shards. */
+	};
+
+	/**
+	 * @brief Increments a counter in a shard.
+	 *
+	 * @param counters Target counter set.
+	 * @param shard    Target shard.
+	 * @param counter  Target counter.
+	 *
+	 * @note The shard should be only written by the caller. Increments
+	 * on an invalid shard or counter are dropped.
+	 */
+	static inline void nanvix_counters_inc(struct nanvix_counters *counters, int shard, int counter)
+	{
+		/* Invalid shard. */
+		if (UNLIKELY(!WITHIN(shard, 0, NANVIX_COUNTERS_SHARDS)))
+			return;
+
+		/* Invalid counter. */
+		if (UNLIKELY(!WITHIN(counter, 0, NANVIX_COUNTERS_MAX)))
+			return;
+
+		counters->shards[shard].values[counter]++;
+	}
+
+	/**
+	 * @brief Gets the value of a counter.
+	 *
+	 * @param counters Target counter set.
+	 * @param counter  Target counter.
+	 *
+	 * @returns The sum of @p counter over all shards of @p counters.
+	 *
+	 * @note Increments that race with this call may or may not be
+	 * accounted.
+	 */
+	extern uint64_t nanvix_counters_get(const struct nanvix_counters *counters, int counter);
+
+	/**
+	 * @brief Zeroes all counters of a set.
+	 *
+	 * @param counters Target counter set.
+	 */
+	extern void nanvix_counters_reset(struct nanvix_counters *counters);
+
+	/**
+	 * @name Counting points.
+	 *
+	 * NANVIX_COUNTERS_INC() counts in the shard of the calling thread,
+	 * which costs a kthread_self() kernel call, so it should be used
+	 * once per operation. NANVIX_COUNTERS_INC_LOCKED() counts in a
+	 * shared shard and must be called with a lock held that serializes
+	 * all its callers on the set.
+	 */
+	/**@{*/
+	#if (__NANVIX_IKC_STATS)
+		#define NANVIX_COUNTERS_INC(counters, counter) \
+			nanvix_counters_inc(&(counters), nanvix_tls_slot(kthread_self()), (counter))
+		#define NANVIX_COUNTERS_INC_LOCKED(counters, counter) \
+			nanvix_counters_inc(&(counters), NANVIX_COUNTERS_LOCKED, (counter))
+	#else
+		#define NANVIX_COUNTERS_INC(counters, counter)        ((void) 0)
+		#define NANVIX_COUNTERS_INC_LOCKED(counters, counter) ((void) 0)
+	#endif /* __NANVIX_IKC_STATS */
+	/**@}*/
+
+#endif /* NANVIX_SYS_COUNTERS_H_ */
+
+/**@}*/
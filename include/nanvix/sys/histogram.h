@@ -0,0 +1,178 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @addtogroup nanvix Nanvix System
+ */
+/**@{*/
+
+#ifndef NANVIX_SYS_HISTOGRAM_H_
+#define NANVIX_SYS_HISTOGRAM_H_
+
+	#include <nanvix/kernel/kernel.h>
+	#include <posix/stdint.h>
+
+	/**
+	 * @brief If the configuration of IKC statistics is missing, then
+	 * enable them.
+	 */
+	#ifndef __NANVIX_IKC_STATS
+	#define __NANVIX_IKC_STATS 1
+	#endif
+
+	/**
+	 * @brief Log2 of the number of sub-buckets per power of two.
+	 *
+	 * Values are kept with a relative error of at most 1/2^SUB_BITS.
+	 */
+	#ifndef NANVIX_HISTOGRAM_SUB_BITS
+	#define NANVIX_HISTOGRAM_SUB_BITS 2
+	#endif
+
+	/**
+	 * @brief Number of powers of two covered by a histogram.
+	 *
+	 * Larger values are accounted in the last bucket.
+	 */
+	#ifndef NANVIX_HISTOGRAM_OCTAVES
+	#define NANVIX_HISTOGRAM_OCTAVES 32
+	#endif
+
+	/**
+	 * @brief Number of buckets in a histogram.
+	 */
+	#define NANVIX_HISTOGRAM_BUCKETS \
+		(NANVIX_HISTOGRAM_OCTAVES << NANVIX_HISTOGRAM_SUB_BITS)
+
+	/**
+	 * @brief Log-bucketed latency histogram.
+	 */
+	struct nanvix_histogram
+	{
+		uint64_t count;                             /**< Number of samples. */
+		uint64_t sum;                               /**< Sum of samples.    */
+		uint64_t min;                               /**< Smallest sample.   */
+		uint64_t max;                               /**< Largest sample.    */
+		uint32_t buckets[NANVIX_HISTOGRAM_BUCKETS]; /**< Buckets.           */
+		spinlock_t lock;                            /**< Lock.              */
+	};
+
+	/**
+	 * @brief Percentile summary of a histogram.
+	 *
+	 * Percentiles are reported as the highest value of the bucket that
+	 * holds them, never above the largest sample.
+	 */
+	struct nanvix_histogram_summary
+	{
+		uint64_t count; /**< Number of samples. */
+		uint64_t min;   /**< Smallest sample.   */
+		uint64_t max;   /**< Largest sample.    */
+		uint64_t mean;  /**< Mean.              */
+		uint64_t p50;   /**< 50th percentile.   */
+		uint64_t p90;   /**< 90th percentile.   */
+		uint64_t p99;   /**< 99th percentile.   */
+		uint64_t p999;  /**< 99.9th percentile. */
+	};
+
+	/**
+	 * @brief Initializes a histogram.
+	 *
+	 * @param h Target histogram.
+	 */
+	extern void nanvix_histogram_init(struct nanvix_histogram *h);
+
+	/**
+	 * @brief Records a sample in a histogram.
+	 *
+	 * @param h     Target histogram.
+	 * @param value Sample.
+	 */
+	extern void nanvix_histogram_record(struct nanvix_histogram *h, uint64_t value);
+
+	/**
+	 * @brief Summarizes a histogram.
+	 *
+	 * @param h       Target histogram.
+	 * @param summary Store location for the summary.
+	 */
+	extern void nanvix_histogram_summary(
+		struct nanvix_histogram *h,
+		struct nanvix_histogram_summary *summary
+	);
+
+	/**
+	 * @brief Discards all samples of a histogram.
+	 *
+	 * @param h Target histogram.
+	 */
+	extern void nanvix_histogram_reset(struct nanvix_histogram *h);
+
+	/**
+	 * @brief Stamps an asynchronous operation when it is posted.
+	 *
+	 * @param t0 Store location for the stamp.
+	 */
+	extern void nanvix_histogram_post(uint64_t *t0);
+
+	/**
+	 * @brief Records the latency of a completed asynchronous operation.
+	 *
+	 * @param h  Target histogram.
+	 * @param t0 Stamp taken when the operation was posted. It is
+	 * cleared, and nothing is recorded if it is already clear.
+	 */
+	extern void nanvix_histogram_complete(struct nanvix_histogram *h, uint64_t *t0);
+
+	/**
+	 * @brief Records a latency sample of an IKC operation.
+	 *
+	 * Samples are dropped if IKC statistics are compiled out.
+	 */
+	#if (__NANVIX_IKC_STATS)
+		#define NANVIX_HISTOGRAM_RECORD(h, value) nanvix_histogram_record((h), (value))
+	#else
+		#define NANVIX_HISTOGRAM_RECORD(h, value) ((void) 0)
+	#endif /* __NANVIX_IKC_STATS */
+
+	/**
+	 * @name Latency samples of asynchronous IKC operations.
+	 *
+	 * An operation is stamped when it is posted and sampled when its
+	 * wait completes, so asynchronous users are accounted as well as
+	 * the synchronous wrappers built on them.
+	 */
+	/**@{*/
+	#if (__NANVIX_IKC_STATS)
+		#define NANVIX_HISTOGRAM_POST(t0)        nanvix_histogram_post(&(t0))
+		#define NANVIX_HISTOGRAM_COMPLETE(h, t0) nanvix_histogram_complete((h), &(t0))
+	#else
+		#define NANVIX_HISTOGRAM_POST(t0)        ((void) 0)
+		#define NANVIX_HISTOGRAM_COMPLETE(h, t0) ((void) 0)
+	#endif /* __NANVIX_IKC_STATS */
+	/**@}*/
+
+#endif /* NANVIX_SYS_HISTOGRAM_H_ */
+
+/**@}*/
@@ -0,0 +1,160 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @addtogroup nanvix Nanvix System
+ */
+/**@{*/
+
+#ifndef NANVIX_SYS_IKCQ_H_
+#define NANVIX_SYS_IKCQ_H_
+
+	#include <nanvix/kernel/kernel.h>
+	#include <posix/sys/types.h>
+	#include <posix/stdint.h>
+
+	/**
+	 * @brief Maximum number of operations in flight or waiting to be
+	 * reaped in a queue (power of two).
+	 */
+	#ifndef NANVIX_IKCQ_DEPTH
+	#define NANVIX_IKCQ_DEPTH 32
+	#endif
+
+	/**
+	 * @name Operations.
+	 *
+	 * Operations are grouped in pairs by type of communicator.
+	 */
+	/**@{*/
+	#define NANVIX_IKCQ_MAILBOX_READ  0 /**< kmailbox_read().      */
+	#define NANVIX_IKCQ_MAILBOX_WRITE 1 /**< kmailbox_write().     */
+	#define NANVIX_IKCQ_PORTAL_READ   2 /**< kportal_read().       */
+	#define NANVIX_IKCQ_PORTAL_WRITE  3 /**< kportal_write().      */
+	#define NANVIX_IKCQ_SYNC_WAIT     4 /**< ksync_wait().         */
+	#define NANVIX_IKCQ_SYNC_SIGNAL   5 /**< ksync_signal_async(). */
+	#define NANVIX_IKCQ_OPS_NUM       6 /**< Number of ops.        */
+	/**@}*/
+
+	/**
+	 * @brief Submission queue entry.
+	 */
+	struct nanvix_ikcq_sqe
+	{
+		int opcode;   /**< Operation (NANVIX_IKCQ_*).        */
+		int id;       /**< ID of the communicator.           */
+		void *buffer; /**< Data buffer (reads and writes).   */
+		size_t size;  /**< Size in bytes of the data buffer. */
+		uint64_t tag; /**< User tag.                         */
+	};
+
+	/**
+	 * @brief Completion queue entry.
+	 */
+	struct nanvix_ikcq_cqe
+	{
+		uint64_t tag; /**< User tag of the operation.     */
+		ssize_t ret;  /**< Return value of the operation. */
+	};
+
+	/**
+	 * @brief Submission/completion queue of IKC operations.
+	 *
+	 * Operations on different communicators progress independently,
+	 * and operations on the same communicator are started in order of
+	 * submission. A queue must not be shared by threads.
+	 */
+	struct nanvix_ikcq
+	{
+		unsigned sq_head;                             /**< First operation in flight. */
+		unsigned sq_tail;                             /**< Next submission slot.      */
+		unsigned cq_head;                             /**< First completion to reap.  */
+		unsigned cq_tail;                             /**< Next completion slot.      */
+		int states[NANVIX_IKCQ_DEPTH];                /**< States of operations.      */
+		size_t offsets[NANVIX_IKCQ_DEPTH];            /**< Bytes already written.     */
+		struct nanvix_ikcq_sqe sq[NANVIX_IKCQ_DEPTH]; /**< Submission queue.          */
+		struct nanvix_ikcq_cqe cq[NANVIX_IKCQ_DEPTH]; /**< Completion queue.          */
+	};
+
+	/**
+	 * @brief Initializes a queue.
+	 *
+	 * @param q Target queue.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_ikcq_init(struct nanvix_ikcq *q);
+
+	/**
+	 * @brief Submits operations to a queue.
+	 *
+	 * @param q     Target queue.
+	 * @param sqes  Operations to submit.
+	 * @param nsqes Number of operations in @p sqes.
+	 *
+	 * @returns Upon successful completion, the number of submitted
+	 * operations is returned, which is less than @p nsqes if the
+	 * queue is full. Upon failure, a negative error code is returned
+	 * instead.
+	 */
+	extern int nanvix_ikcq_submit(
+		struct nanvix_ikcq *q,
+		const struct nanvix_ikcq_sqe *sqes,
+		int nsqes
+	);
+
+	/**
+	 * @brief Progresses the operations in flight in a queue.
+	 *
+	 * @param q Target queue.
+	 *
+	 * @returns Upon successful completion, the number of operations
+	 * completed is returned. Upon failure, a negative error code is
+	 * returned instead.
+	 */
+	extern int nanvix_ikcq_progress(struct nanvix_ikcq *q);
+
+	/**
+	 * @brief Reaps completions from a queue.
+	 *
+	 * @param q    Target queue.
+	 * @param cqes Store location for completions.
+	 * @param max  Maximum number of completions to reap.
+	 * @param min  Number of completions to wait for.
+	 *
+	 * @returns Upon successful completion, the number of completions
+	 * written to @p cqes is returned. Upon failure, a negative error
+	 * code is returned instead.
+	 */
+	extern int nanvix_ikcq_reap(
+		struct nanvix_ikcq *q,
+		struct nanvix_ikcq_cqe *cqes,
+		int max,
+		int min
+	);
+
+#endif /* NANVIX_SYS_IKCQ_H_ */
+
+/**@}*/
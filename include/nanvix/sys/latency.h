@@ -0,0 +1,103 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @addtogroup nanvix Nanvix System
+ */
+/**@{*/
+
+#ifndef NANVIX_SYS_LATENCY_H_
+#define NANVIX_SYS_LATENCY_H_
+
+	#include <nanvix/kernel/kernel.h>
+	#include <posix/sys/types.h>
+
+	/**
+	 * @brief Fixed latency (in cycles) injected in each IKC delivery.
+	 *
+	 * Latency injection is meant for targets whose interconnect is
+	 * much faster than the real one, such as unix64, where clusters
+	 * are host processes that talk over shared memory. The delay is
+	 * paid by the receiver when a message is delivered, so senders
+	 * still overlap their transfers with computation.
+	 */
+	#ifndef __NANVIX_IKC_LATENCY
+	#define __NANVIX_IKC_LATENCY 0
+	#endif
+
+	/**
+	 * @brief Latency (in cycles) injected per KB of transferred data.
+	 */
+	#ifndef __NANVIX_IKC_LATENCY_PER_KB
+	#define __NANVIX_IKC_LATENCY_PER_KB 0
+	#endif
+
+	/**
+	 * @brief Is latency injection enabled?
+	 */
+	#define __NANVIX_IKC_LATENCY_ENABLED \
+		((__NANVIX_IKC_LATENCY > 0) || (__NANVIX_IKC_LATENCY_PER_KB > 0))
+
+	/**
+	 * @brief No receive posted.
+	 */
+	#define NANVIX_LATENCY_IDLE ((ssize_t) -1)
+
+	/**
+	 * @brief Delays the calling thread as if @p size bytes had crossed
+	 * the interconnect.
+	 *
+	 * @param size Number of transferred bytes.
+	 */
+	extern void nanvix_latency_inject(size_t size);
+
+	/**
+	 * @brief Completes a posted receive.
+	 *
+	 * @param posted Size of the posted receive, or NANVIX_LATENCY_IDLE.
+	 * @param ret    Return value of the wait that completed it.
+	 *
+	 * The receiver is delayed only if the message was delivered to
+	 * it, and @p posted is set back to NANVIX_LATENCY_IDLE.
+	 */
+	extern void nanvix_latency_deliver(ssize_t *posted, int ret);
+
+	/**
+	 * @name Injection points.
+	 */
+	/**@{*/
+	#if (__NANVIX_IKC_LATENCY_ENABLED)
+		#define NANVIX_LATENCY_INJECT(size)          nanvix_latency_inject(size)
+		#define NANVIX_LATENCY_POST(posted, size)    ((posted) = (ssize_t) (size))
+		#define NANVIX_LATENCY_DELIVER(posted, ret)  nanvix_latency_deliver(&(posted), (ret))
+	#else
+		#define NANVIX_LATENCY_INJECT(size)          ((void) 0)
+		#define NANVIX_LATENCY_POST(posted, size)    ((void) 0)
+		#define NANVIX_LATENCY_DELIVER(posted, ret)  ((void) 0)
+	#endif /* __NANVIX_IKC_LATENCY_ENABLED */
+	/**@}*/
+
+#endif /* NANVIX_SYS_LATENCY_H_ */
+
+/**@}*/
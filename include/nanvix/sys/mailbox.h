@@ -31,7 +31,11 @@
 #define NANVIX_SYS_MAILBOX_H_
 
 	#include <nanvix/kernel/kernel.h>
+	#include <nanvix/sys/backoff.h>
+	#include <nanvix/sys/histogram.h>
 	#include <posix/sys/types.h>
+	#include <posix/stdbool.h>
+	#include <posix/stdint.h>
 
 	/**
 	 * @brief If the configuration of IKC systems is missing, then disable
@@ -41,6 +45,77 @@
 	#define __NANVIX_IKC_USES_ONLY_MAILBOX 0
 	#endif
 
+	/**
+	 * @brief If the configuration of message coalescing is missing,
+	 * then enable it.
+	 *
+	 * When disabled, the coalescing checks are compiled out of the
+	 * read and write paths and coalescing requests are not supported.
+	 */
+	#ifndef __NANVIX_IKC_COALESCING
+	#define __NANVIX_IKC_COALESCING 1
+	#endif
+
+	/**
+	 * @name Latency histogram requests.
+	 *
+	 * These requests are served in user space and take a pointer to a
+	 * struct nanvix_histogram_summary and no argument, respectively.
+	 */
+	/**@{*/
+	#define KMAILBOX_IOCTL_GET_HISTOGRAM   0x1000 /**< Get latency percentiles. */
+	#define KMAILBOX_IOCTL_RESET_HISTOGRAM 0x1001 /**< Reset latency histogram. */
+	/**@}*/
+
+	/**
+	 * @name Wait policy requests.
+	 *
+	 * These requests are served in user space and take an int and a
+	 * pointer to an int, respectively. The policy (NANVIX_BACKOFF_*)
+	 * rules how kmailbox_awrite() and kmailbox_aread() wait before
+	 * retrying on a mailbox that is not ready.
+	 */
+	/**@{*/
+	#define KMAILBOX_IOCTL_SET_BACKOFF 0x1002 /**< Set wait policy. */
+	#define KMAILBOX_IOCTL_GET_BACKOFF 0x1003 /**< Get wait policy. */
+	/**@}*/
+
+	/**
+	 * @name Coalescing requests.
+	 *
+	 * These requests are served in user space and take a uint64_t and
+	 * a pointer to a uint64_t, respectively. A non-zero value enables
+	 * coalescing in the mailbox: small messages written to an output
+	 * mailbox are packed into one frame, which is flushed when full,
+	 * by kmailbox_flush(), before the caller blocks in a read, or once
+	 * the value (in clock cycles) has elapsed since the first packed
+	 * message. An expired frame is flushed by the next write, or by
+	 * the IKC progress engine if it runs. The input mailbox on the other
+	 * end must enable coalescing as well, so kmailbox_read() splits
+	 * frames back into messages.
+	 */
+	/**@{*/
+	#define KMAILBOX_IOCTL_SET_COALESCING 0x1004 /**< Set flush deadline. */
+	#define KMAILBOX_IOCTL_GET_COALESCING 0x1005 /**< Get flush deadline. */
+	/**@}*/
+
+	/**
+	 * @brief Maximum size of a message in a coalescing mailbox.
+	 */
+	#define KMAILBOX_COALESCE_MAX_SIZE (KMAILBOX_MESSAGE_SIZE - sizeof(uint16_t))
+
+	/**
+	 * @brief Number of messages kept in the local delivery ring of a
+	 * port.
+	 *
+	 * Messages written with kmailbox_write() to an output mailbox that
+	 * is opened to the local node are delivered through an in-memory
+	 * ring of the target port, bypassing the NoC.
+	 */
+	#ifndef KMAILBOX_LOCAL_RING_SIZE
+	#define KMAILBOX_LOCAL_RING_SIZE 4
+	#endif
+
 	/**
 	 * @brief Initializes the user-side of the mailbox system.
 	 */
@@ -142,6 +217,20 @@
 	 */
 	extern ssize_t kmailbox_read(int mbxid, void *buffer, size_t size);
 
+	/**
+	 * @brief Reads from an input mailbox without blocking.
+	 *
+	 * @param mbxid  ID of the target input mailbox.
+	 * @param buffer Target data buffer.
+	 * @param size   Size in bytes of the data buffer.
+	 *
+	 * @return Upon successful completion, the number of bytes read
+	 * from the input mailbox @p mbxid is returned. If no message is
+	 * available, -EAGAIN is returned. Upon failure, a negative error
+	 * code is returned instead.
+	 */
+	extern ssize_t kmailbox_tryread(int mbxid, void *buffer, size_t size);
+
 	/**
 	 * @brief Waits for an synchronous operation to complete.
 	 *
@@ -152,6 +241,41 @@
 	 */
 	extern int kmailbox_wait(int mbxid);
 
+	/**
+	 * @brief Flushes the messages packed in an output mailbox.
+	 *
+	 * @param mbxid ID of the target output mailbox.
+	 *
+	 * @return Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int kmailbox_flush(int mbxid);
+
+	/**
+	 * @brief Binds a mailbox to the local delivery ring of a port.
+	 *
+	 * @param mbxid  ID of the target mailbox.
+	 * @param node   Target NoC node.
+	 * @param port   Target port in @p node.
+	 * @param output Is @p mbxid an output mailbox?
+	 *
+	 * Mailboxes returned by kmailbox_create() and kmailbox_open() are
+	 * bound automatically. Mailboxes that other IKC modules get
+	 * straight from the kernel must be bound explicitly: an input
+	 * mailbox always, and an output mailbox only if it is opened to
+	 * the local node.
+	 *
+	 * The ring of a port is owned by the first node of the cluster
+	 * that binds an input mailbox to it. Mailboxes of other nodes in
+	 * the same port stay unbound and use the NoC.
+	 *
+	 * @return Upon successful completion, zero is returned. If the
+	 * ring is owned by another node, -EBUSY is returned and @p mbxid
+	 * is left unbound. Upon failure, a negative error code is
+	 * returned instead.
+	 */
+	extern int kmailbox_local_bind(int mbxid, int node, int port, bool output);
+
 	/**
 	 * @brief Performs control operations in a mailbox.
 	 *
@@ -32,12 +32,85 @@
 
 	#include <nanvix/kernel/kernel.h>
 
+	/**
+	 * @brief If the configuration of single-node builds is missing,
+	 * then assume that remote nodes exist.
+	 *
+	 * In a single-node build every peer is the local node, so IKC
+	 * paths that dispatch on locality are specialized at compile time
+	 * to the local one. Only the locality checks are folded: the
+	 * validation of IDs and resource states still runs on each call,
+	 * since it guards against bad arguments rather than remote peers.
+	 */
+	#ifndef __NANVIX_IKC_SINGLE_NODE
+	#define __NANVIX_IKC_SINGLE_NODE 0
+	#endif
+
+	/**
+	 * @brief Asserts whether or not an IKC peer is the local node.
+	 */
+	#define IKC_NODE_IS_LOCAL(node) \
+		(__NANVIX_IKC_SINGLE_NODE || node_is_local(node))
+
+	/**
+	 * @brief Is the NoC node number the same for all cores of a
+	 * cluster?
+	 *
+	 * On processors whose IO Clusters span several NoC nodes, the
+	 * node number depends on the calling core and cannot be cached.
+	 */
+	#define KNODE_NUM_IS_CLUSTER_WIDE                                    \
+		((PROCESSOR_NOC_IONODES_NUM == PROCESSOR_IOCLUSTERS_NUM) &&      \
+		 (PROCESSOR_NOC_CNODES_NUM == PROCESSOR_CCLUSTERS_NUM))
+
+	/**
+	 * @name Cached values of immutable NoC kernel calls.
+	 */
+	/**@{*/
+	extern int __knode_num;    /**< Logic ID of the local node.    */
+	extern int __kcluster_num; /**< Logic ID of the local cluster. */
+	/**@}*/
+
+	/**
+	 * @brief Gets the logic ID of the local NoC node.
+	 *
+	 * @returns The logic ID of the NoC node of the calling core.
+	 *
+	 * @note The kernel is only called once if the node number is the
+	 * same for all cores of the cluster.
+	 */
+	static inline int knode_get_num(void)
+	{
+		if (!KNODE_NUM_IS_CLUSTER_WIDE)
+			return (kcall0(NR_node_get_num));
+
+		/* Benign race: all threads store the same value. */
+		if (UNLIKELY(__knode_num < 0))
+			__knode_num = kcall0(NR_node_get_num);
+
+		return (__knode_num);
+	}
+
+	/**
+	 * @brief Gets the logic ID of the local cluster.
+	 *
+	 * @returns The logic ID of the local cluster.
+	 *
+	 * @note The kernel is only called once.
+	 */
+	static inline int kcluster_get_num(void)
+	{
+		/* Benign race: all threads store the same value. */
+		if (UNLIKELY(__kcluster_num < 0))
+			__kcluster_num = kcall0(NR_cluster_get_num);
+
+		return (__kcluster_num);
+	}
+
 	/**
 	 * @name NoC Kernel Calls
 	 */
 	/**@{*/
-	extern int knode_get_num(void);
-	extern int kcluster_get_num(void);
 	extern int kcomm_get_port(int, int);
 	extern void knoc_init(void);
 	/**@}*/
@@ -0,0 +1,133 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @addtogroup nanvix Nanvix System
+ */
+/**@{*/
+
+#ifndef NANVIX_SYS_PCHANNEL_H_
+#define NANVIX_SYS_PCHANNEL_H_
+
+	#include <nanvix/kernel/kernel.h>
+	#include <nanvix/sys/mailbox.h>
+	#include <posix/sys/types.h>
+
+#if __TARGET_HAS_PORTAL || __NANVIX_IKC_USES_ONLY_MAILBOX
+
+	/**
+	 * @brief Maximum number of persistent channels.
+	 */
+	#ifndef KPCHANNEL_MAX
+	#define KPCHANNEL_MAX 8
+	#endif
+
+	/**
+	 * @brief Number of ports for persistent channels.
+	 *
+	 * With portals, a channel takes a portal port. With the mailbox
+	 * implementation, a channel takes a mailbox port instead, so that
+	 * data moves with no portal header and no allow messages.
+	 */
+	#if __NANVIX_IKC_USES_ONLY_MAILBOX
+	#define KPCHANNEL_PORT_NR KMAILBOX_PORT_NR
+	#else
+	#define KPCHANNEL_PORT_NR KPORTAL_PORT_NR
+	#endif
+
+	/**
+	 * @brief Initializes the receiving end of a persistent channel.
+	 *
+	 * The channel moves @p size bytes from @p remote to @p buffer at
+	 * each transfer. This call blocks until the sending end, set up
+	 * with kpchannel_send_init(), announces the same size. The port is
+	 * taken by the channel until kpchannel_free().
+	 *
+	 * @param local  Local NoC node.
+	 * @param remote Remote NoC node.
+	 * @param port   Target port in @p local.
+	 * @param buffer Target data buffer.
+	 * @param size   Size in bytes of @p buffer.
+	 *
+	 * @returns Upon successful completion, the ID of the channel is
+	 * returned. Upon failure, a negative error code is returned
+	 * instead.
+	 */
+	extern int kpchannel_recv_init(int local, int remote, int port, void *buffer, size_t size);
+
+	/**
+	 * @brief Initializes the sending end of a persistent channel.
+	 *
+	 * @param local  Local NoC node.
+	 * @param remote Remote NoC node.
+	 * @param port   Target port in @p remote.
+	 * @param buffer Source data buffer.
+	 * @param size   Size in bytes of @p buffer.
+	 *
+	 * @returns Upon successful completion, the ID of the channel is
+	 * returned. Upon failure, a negative error code is returned
+	 * instead.
+	 */
+	extern int kpchannel_send_init(int local, int remote, int port, const void *buffer, size_t size);
+
+	/**
+	 * @brief Starts a transfer in a persistent channel.
+	 *
+	 * On the receiving end, the receive is posted. On the sending
+	 * end, the first piece of the buffer is sent.
+	 *
+	 * @param chid ID of the target channel.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int kpchannel_start(int chid);
+
+	/**
+	 * @brief Completes a transfer in a persistent channel.
+	 *
+	 * @param chid ID of the target channel.
+	 *
+	 * @returns Upon successful completion, the number of transferred
+	 * bytes is returned. Upon failure, a negative error code is
+	 * returned instead.
+	 */
+	extern ssize_t kpchannel_complete(int chid);
+
+	/**
+	 * @brief Releases a persistent channel.
+	 *
+	 * @param chid ID of the target channel.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int kpchannel_free(int chid);
+
+#endif /* __TARGET_HAS_PORTAL || __NANVIX_IKC_USES_ONLY_MAILBOX */
+
+#endif /* NANVIX_SYS_PCHANNEL_H_ */
+
+/**@}*/
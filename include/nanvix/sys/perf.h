@@ -31,6 +31,7 @@
 #define NANVIX_SYS_PERF_H_
 
 	#include <nanvix/kernel/kernel.h>
+	#include <posix/errno.h>
 	#include <posix/stdint.h>
 
 	/**
@@ -94,8 +95,17 @@
 	 *
 	 * @returns Upon successful completion, zero is returned. Upon
 	 * failure, a negative error code is returned instead.
+	 *
+	 * @note Inlined, as it brackets every timed IKC operation.
 	 */
-	extern int kclock(uint64_t *buffer);
+	static inline int kclock(uint64_t *buffer)
+	{
+		/* Invalid buffer. */
+		if (UNLIKELY(buffer == NULL))
+			return (-EINVAL);
+
+		return (kcall1(NR_clock, (word_t) buffer));
+	}
 
 	/**
 	 * @brief Gets performance statistics of the kernel.
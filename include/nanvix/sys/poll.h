@@ -0,0 +1,105 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @addtogroup nanvix Nanvix System
+ */
+/**@{*/
+
+#ifndef NANVIX_SYS_POLL_H_
+#define NANVIX_SYS_POLL_H_
+
+	#include <nanvix/kernel/kernel.h>
+	#include <posix/sys/types.h>
+	#include <posix/stdint.h>
+
+	/**
+	 * @name Types of communicators.
+	 */
+	/**@{*/
+	#define KPOLL_MAILBOX 0 /**< Input mailbox.               */
+	#define KPOLL_PORTAL  1 /**< Input portal.                */
+	#define KPOLL_SYNC    2 /**< Input synchronization point. */
+	/**@}*/
+
+	/**
+	 * @name Returned events.
+	 */
+	/**@{*/
+	#define KPOLLIN  (1 << 0) /**< Read completed.  */
+	#define KPOLLERR (1 << 1) /**< Read failed.     */
+	/**@}*/
+
+	/**
+	 * @brief Waits without a time limit.
+	 */
+	#define KPOLL_FOREVER (~0ULL)
+
+	/**
+	 * @brief Communicator watched by kpoll().
+	 *
+	 * Readiness is completion based: when a communicator is ready, its
+	 * message has already been read into @p buffer. Portals must be
+	 * allowed beforehand, and stay allowed while they are not ready.
+	 * Entries with a negative ID are ignored.
+	 */
+	struct kpollfd
+	{
+		int type;     /**< Type of the communicator (KPOLL_*). */
+		int id;       /**< ID of the communicator.             */
+		void *buffer; /**< Target data buffer.                 */
+		size_t size;  /**< Size in bytes of the data buffer.   */
+		int revents;  /**< Returned events.                    */
+		ssize_t ret;  /**< Return value of the read.           */
+	};
+
+	/**
+	 * @brief Waits on many communicators at once.
+	 *
+	 * @param fds     Communicators to watch.
+	 * @param nfds    Number of communicators in @p fds.
+	 * @param timeout Time limit in clock cycles, zero to not block or
+	 *                KPOLL_FOREVER.
+	 *
+	 * @returns Upon successful completion, the number of ready
+	 * communicators is returned, which is zero if the time limit
+	 * expired. Upon failure, a negative error code is returned instead.
+	 */
+	extern int kpoll(struct kpollfd *fds, int nfds, uint64_t timeout);
+
+	/**
+	 * @brief Waits on any of many communicators.
+	 *
+	 * @param fds  Communicators to watch.
+	 * @param nfds Number of communicators in @p fds.
+	 *
+	 * @returns Upon successful completion, the index in @p fds of the
+	 * only ready communicator is returned. Upon failure, a negative
+	 * error code is returned instead.
+	 */
+	extern int kwait_any(struct kpollfd *fds, int nfds);
+
+#endif /* NANVIX_SYS_POLL_H_ */
+
+/**@}*/
@@ -31,6 +31,8 @@
 #define NANVIX_SYS_PORTAL_H_
 
 	#include <nanvix/kernel/kernel.h>
+	#include <nanvix/sys/backoff.h>
+	#include <nanvix/sys/histogram.h>
 	#include <posix/sys/types.h>
 	#include <posix/stdint.h>
 
@@ -42,6 +44,30 @@
 		#define __NANVIX_IKC_USES_ONLY_MAILBOX 0
 	#endif /* __NANVIX_IKC_USES_ONLY_MAILBOX */
 
+	/**
+	 * @name Latency histogram requests.
+	 *
+	 * These requests are served in user space and take a pointer to a
+	 * struct nanvix_histogram_summary and no argument, respectively.
+	 */
+	/**@{*/
+	#define KPORTAL_IOCTL_GET_HISTOGRAM   0x1000 /**< Get latency percentiles. */
+	#define KPORTAL_IOCTL_RESET_HISTOGRAM 0x1001 /**< Reset latency histogram. */
+	/**@}*/
+
+	/**
+	 * @name Wait policy requests.
+	 *
+	 * These requests are served in user space and take an int and a
+	 * pointer to an int, respectively. The policy (NANVIX_BACKOFF_*)
+	 * rules how kportal_awrite() and kportal_aread() wait before
+	 * retrying on a portal that is not ready.
+	 */
+	/**@{*/
+	#define KPORTAL_IOCTL_SET_BACKOFF 0x1004 /**< Set wait policy. */
+	#define KPORTAL_IOCTL_GET_BACKOFF 0x1005 /**< Get wait policy. */
+	/**@}*/
+
 	/**
 	 * @brief Initializes the user-side of the portal system.
 	 */
@@ -115,6 +141,20 @@
 	 */
 	extern ssize_t kportal_read(int portalid, void * buffer, size_t size);
 
+	/**
+	 * @brief Reads data from a portal without blocking.
+	 *
+	 * @param portalid ID of the Target Portal.
+	 * @param buffer   Location from where data should be written.
+	 * @param size     Number of bytes to read.
+	 *
+	 * @returns Upon successful completion, the number of bytes read is
+	 * returned. If no data has arrived yet, -EAGAIN is returned and
+	 * the read remains allowed. Upon failure, a negative error code is
+	 * returned instead.
+	 */
+	extern ssize_t kportal_tryread(int portalid, void * buffer, size_t size);
+
 	/**
 	 * @brief Asynchronously reads data from a portal.
 	 *
@@ -139,6 +179,21 @@
 	 */
 	extern ssize_t kportal_write(int portalid, const void * buffer, size_t size);
 
+	/**
+	 * @brief Writes data to a portal without waiting for the remote.
+	 *
+	 * @param portalid ID of the Target Portal.
+	 * @param buffer   Location from where data should be read.
+	 * @param size     Number of bytes to write.
+	 *
+	 * @returns Upon successful completion, the number of bytes written
+	 * is returned, which may be less than @p size: the rest is written
+	 * by further calls. If the remote has not allowed the write yet,
+	 * -EAGAIN is returned. Upon failure, a negative error code is
+	 * returned instead.
+	 */
+	extern ssize_t kportal_trywrite(int portalid, const void * buffer, size_t size);
+
 	/**
 	 * @brief Asynchronously writes data to a portal.
 	 *
@@ -0,0 +1,93 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @addtogroup nanvix Nanvix System
+ */
+/**@{*/
+
+#ifndef NANVIX_SYS_PROGRESS_H_
+#define NANVIX_SYS_PROGRESS_H_
+
+	#include <nanvix/kernel/kernel.h>
+	#include <nanvix/sys/mailbox.h>
+	#include <posix/stdbool.h>
+
+#if __TARGET_HAS_MAILBOX && __NANVIX_IKC_USES_ONLY_MAILBOX
+
+	/**
+	 * @brief Starts the IKC progress engine.
+	 *
+	 * The progress engine is a thread that drains the shared inboxes
+	 * of the mailbox implementation of portals and syncs, dispatches
+	 * incoming messages to their endpoints and wakes up the threads
+	 * that wait on them. While it runs, readers sleep instead of
+	 * polling the shared inboxes themselves. It takes one core.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_ikc_progress_start(void);
+
+	/**
+	 * @brief Stops the IKC progress engine.
+	 *
+	 * Threads sleeping on the engine are woken up and go back to
+	 * polling the shared inboxes themselves.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_ikc_progress_stop(void);
+
+	/**
+	 * @brief Asserts whether the IKC progress engine is running.
+	 *
+	 * @returns True if the progress engine is running, and false
+	 * otherwise.
+	 */
+	extern bool nanvix_ikc_progress_is_running(void);
+
+	/**
+	 * @name Hooks of the progress engine.
+	 *
+	 * A progress hook receives at most one message per shared inbox
+	 * without blocking and returns the number of received messages.
+	 * The mailbox hook instead sends the coalescing frames whose
+	 * deadline expired and returns the number of sent frames. A
+	 * release hook wakes up all threads sleeping on the engine.
+	 */
+	/**@{*/
+	extern int kmailbox_progress(void);
+	extern int kportal_progress(void);
+	extern void kportal_progress_release(void);
+	extern int ksync_progress(void);
+	extern void ksync_progress_release(void);
+	/**@}*/
+
+#endif /* __TARGET_HAS_MAILBOX && __NANVIX_IKC_USES_ONLY_MAILBOX */
+
+#endif /* NANVIX_SYS_PROGRESS_H_ */
+
+/**@}*/
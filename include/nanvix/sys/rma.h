@@ -0,0 +1,193 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @addtogroup nanvix Nanvix System
+ */
+/**@{*/
+
+#ifndef NANVIX_SYS_RMA_H_
+#define NANVIX_SYS_RMA_H_
+
+	#include <nanvix/kernel/kernel.h>
+	#include <posix/sys/types.h>
+
+#if __TARGET_HAS_MAILBOX
+
+	/**
+	 * @brief Maximum number of exposed memory windows.
+	 */
+	#ifndef KRMA_WINDOW_MAX
+	#define KRMA_WINDOW_MAX 8
+	#endif
+
+	/**
+	 * @name Mailbox ports taken by the RMA layer.
+	 */
+	/**@{*/
+	#ifndef KRMA_REQUEST_PORT
+	#define KRMA_REQUEST_PORT (KMAILBOX_PORT_NR - 1) /**< Incoming requests. */
+	#endif
+	#ifndef KRMA_REPLY_PORT
+	#define KRMA_REPLY_PORT   (KMAILBOX_PORT_NR - 2) /**< Incoming replies.  */
+	#endif
+	/**@}*/
+
+#if __TARGET_HAS_PORTAL
+
+	/**
+	 * @name Portal ports taken by the RMA layer.
+	 */
+	/**@{*/
+	#ifndef KRMA_DATA_PORT
+	#define KRMA_DATA_PORT       (KPORTAL_PORT_NR - 1) /**< Payloads of writes. */
+	#endif
+	#ifndef KRMA_REPLY_DATA_PORT
+	#define KRMA_REPLY_DATA_PORT (KPORTAL_PORT_NR - 2) /**< Payloads of reads.  */
+	#endif
+	/**@}*/
+
+#endif /* __TARGET_HAS_PORTAL */
+
+	/**
+	 * @brief Sets up the RMA layer in the local node.
+	 *
+	 * All nodes that access each other's windows must set up the RMA
+	 * layer before the first access, and the ports KRMA_REQUEST_PORT
+	 * and KRMA_REPLY_PORT are taken until krma_cleanup(). Requests
+	 * travel in mailbox messages, and their payloads over portals at
+	 * KRMA_DATA_PORT and KRMA_REPLY_DATA_PORT, which are taken as well.
+	 * When portals are built on mailboxes, payloads travel in the
+	 * mailbox messages instead.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int krma_setup(void);
+
+	/**
+	 * @brief Tears down the RMA layer in the local node.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int krma_cleanup(void);
+
+	/**
+	 * @brief Exposes a memory window to remote access.
+	 *
+	 * Windows are identified by creation order, so nodes that create
+	 * their windows in the same order get matching IDs.
+	 *
+	 * @param base Base address of the window.
+	 * @param size Size in bytes of the window.
+	 *
+	 * @returns Upon successful completion, the ID of the window is
+	 * returned. Upon failure, a negative error code is returned
+	 * instead.
+	 */
+	extern int krma_window_create(void *base, size_t size);
+
+	/**
+	 * @brief Withdraws a memory window from remote access.
+	 *
+	 * @param winid ID of the target window.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int krma_window_free(int winid);
+
+	/**
+	 * @brief Writes to the window of a remote node.
+	 *
+	 * The call returns once @p buffer can be reused. The write is
+	 * applied at the remote node by krma_flush() or krma_fence() at
+	 * the latest, and a rejected write is reported by them.
+	 *
+	 * @param remote Target NoC node.
+	 * @param winid  ID of the target window in @p remote.
+	 * @param offset Offset in the target window.
+	 * @param buffer Source data buffer.
+	 * @param size   Size in bytes of @p buffer.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int kput(int remote, int winid, size_t offset, const void *buffer, size_t size);
+
+	/**
+	 * @brief Reads from the window of a remote node.
+	 *
+	 * The call returns once the data is in @p buffer. Writes issued
+	 * before to the same node are applied first.
+	 *
+	 * @param remote Target NoC node.
+	 * @param winid  ID of the target window in @p remote.
+	 * @param offset Offset in the target window.
+	 * @param buffer Target data buffer.
+	 * @param size   Size in bytes of @p buffer.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int kget(int remote, int winid, size_t offset, void *buffer, size_t size);
+
+	/**
+	 * @brief Waits for the writes issued to a remote node.
+	 *
+	 * @param remote Target NoC node.
+	 *
+	 * @returns Upon successful completion, zero is returned. If a
+	 * write was rejected by @p remote, or @p remote failed to send
+	 * the data of a read, -EFAULT is returned. Upon failure, a
+	 * negative error code is returned instead.
+	 */
+	extern int krma_flush(int remote);
+
+	/**
+	 * @brief Waits for the writes issued to all remote nodes.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int krma_fence(void);
+
+	/**
+	 * @brief Serves a pending RMA request, if any.
+	 *
+	 * The progress engine calls this function when it runs. Otherwise,
+	 * threads of the target node serve requests when they wait on RMA
+	 * operations, or by calling it.
+	 *
+	 * @returns The number of served requests.
+	 */
+	extern int krma_progress(void);
+
+#endif /* __TARGET_HAS_MAILBOX */
+
+#endif /* NANVIX_SYS_RMA_H_ */
+
+/**@}*/
@@ -31,6 +31,7 @@
 #define NANVIX_SYS_SYNC_H_
 
 	#include <nanvix/kernel/kernel.h>
+	#include <nanvix/sys/histogram.h>
 	#include <posix/sys/types.h>
 
 	/**
@@ -41,6 +42,17 @@
 	#define __NANVIX_IKC_USES_ONLY_MAILBOX 0
 	#endif
 
+	/**
+	 * @name Latency histogram requests.
+	 *
+	 * These requests are served in user space and take a pointer to a
+	 * struct nanvix_histogram_summary and no argument, respectively.
+	 */
+	/**@{*/
+	#define KSYNC_IOCTL_GET_HISTOGRAM   0x1000 /**< Get latency percentiles. */
+	#define KSYNC_IOCTL_RESET_HISTOGRAM 0x1001 /**< Reset latency histogram. */
+	/**@}*/
+
 	/**
 	 * @brief Initializes the user-side of the synchronization system.
 	 */
@@ -104,6 +116,17 @@
 	 */
 	extern int ksync_wait(int syncid);
 
+	/**
+	 * @brief Waits on a synchronization point without blocking.
+	 *
+	 * @param syncid ID of the target synchronization point.
+	 *
+	 * @returns Upon successful completion, zero is returned. If the
+	 * synchronization point is not complete yet, -EAGAIN is returned.
+	 * Upon failure, a negative error code is returned instead.
+	 */
+	extern int ksync_trywait(int syncid);
+
 	/**
 	 * @brief Signals Waits on a synchronization point.
 	 *
@@ -114,6 +137,20 @@
 	 */
 	extern int ksync_signal(int syncid);
 
+	/**
+	 * @brief Signals a synchronization point without waiting for
+	 * delivery.
+	 *
+	 * @param syncid ID of the target synchronization point.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 *
+	 * @note The signal is completed before the next signal to the same
+	 * nodes or when the synchronization point is closed.
+	 */
+	extern int ksync_signal_async(int syncid);
+
 	/**
 	 * @brief Performs control operations in a sync.
 	 *
@@ -37,11 +37,22 @@
 	 */
 	typedef int kthread_t;
 
+	/**
+	 * @brief Gets the ID of the calling thread.
+	 *
+	 * @returns The ID of the calling thread.
+	 *
+	 * @note Inlined, as it is called in every mutex operation.
+	 */
+	static inline kthread_t kthread_self(void)
+	{
+		return (kcall0(NR_thread_get_id));
+	}
+
 	/**
 	 * @name Thread Management Kernel Calls
 	 */
 	/**@{*/
-	extern kthread_t kthread_self(void);
 	extern int kthread_create(kthread_t *, void *(*)(void*), void *);
 	extern int kthread_exit(void *);
 	extern int kthread_join(kthread_t, void **);
@@ -0,0 +1,226 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * @addtogroup nanvix Nanvix System
+ */
+/**@{*/
+
+#ifndef NANVIX_SYS_TLS_H_
+#define NANVIX_SYS_TLS_H_
+
+	#include <nanvix/kernel/kernel.h>
+	#include <nanvix/sys/thread.h>
+	#include <posix/errno.h>
+
+	/**
+	 * @brief Maximum number of thread-local storage keys.
+	 */
+	#ifndef NANVIX_TLS_KEYS_MAX
+	#define NANVIX_TLS_KEYS_MAX 16
+	#endif
+
+	/**
+	 * @brief Number of per-thread storage blocks.
+	 */
+	#define NANVIX_TLS_THREADS (THREAD_MAX + 1)
+
+	/**
+	 * @brief Thread-local storage key.
+	 */
+	typedef int nanvix_tls_key_t;
+
+	/**
+	 * @brief Destructor of a thread-local value.
+	 */
+	typedef void (*nanvix_tls_destructor_t)(void *);
+
+	/**
+	 * @brief Storage block of a thread.
+	 *
+	 * Each block is owned by a single thread and is aligned to a cache
+	 * line, so that accesses of different threads do not false-share.
+	 */
+	struct nanvix_tls_block
+	{
+		void *values[NANVIX_TLS_KEYS_MAX]; /**< Values, one per key. */
+	} ALIGN(CACHE_LINE_SIZE);
+
+	/**
+	 * @brief Storage blocks.
+	 */
+	extern struct nanvix_tls_block __nanvix_tls_blocks[NANVIX_TLS_THREADS];
+
+	/**
+	 * @brief Creates a thread-local storage key.
+	 *
+	 * @param key        Store location for the key.
+	 * @param destructor Destructor of non-NULL values, or NULL.
+	 *
+	 * @returns Upon successful completion, zero is returned and the
+	 * value of the key is NULL in all threads. Upon failure, a negative
+	 * error code is returned instead.
+	 */
+	extern int nanvix_tls_key_create(nanvix_tls_key_t *key, nanvix_tls_destructor_t destructor);
+
+	/**
+	 * @brief Deletes a thread-local storage key.
+	 *
+	 * @param key Target key.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 *
+	 * @note Destructors are not called for the values of @p key.
+	 */
+	extern int nanvix_tls_key_delete(nanvix_tls_key_t key);
+
+	/**
+	 * @brief Runs the destructors of the calling thread and clears its
+	 * values.
+	 *
+	 * It is called by kthread_exit().
+	 */
+	extern void nanvix_tls_cleanup(void);
+
+	/**
+	 * @brief Clears the values of a thread without running destructors.
+	 *
+	 * @param tid ID of the target thread.
+	 *
+	 * It is called by kthread_join(), so that a block does not leak
+	 * the values of a thread that returned from its start routine.
+	 */
+	extern void nanvix_tls_reset(kthread_t tid);
+
+	/**
+	 * @brief Gets the per-thread slot of a thread.
+	 *
+	 * @param tid ID of the target thread.
+	 *
+	 * @returns The slot of @p tid, in [0, NANVIX_TLS_THREADS), or a
+	 * negative number if @p tid has no slot.
+	 */
+	static inline int nanvix_tls_slot(kthread_t tid)
+	{
+		int slot = (tid - (SYS_THREAD_MAX - 1));
+
+		/* Kernel thread ? 0 else slot. */
+		if (slot <= 0)
+			return (0);
+
+		/* Unknown thread. */
+		if (UNLIKELY(slot >= NANVIX_TLS_THREADS))
+			return (-1);
+
+		return (slot);
+	}
+
+	/**
+	 * @brief Gets the storage block of a thread.
+	 *
+	 * @param tid ID of the target thread.
+	 *
+	 * @returns The storage block of @p tid, or NULL if @p tid has no
+	 * slot.
+	 */
+	static inline struct nanvix_tls_block *nanvix_tls_block_of(kthread_t tid)
+	{
+		int slot;
+
+		/* Unknown thread. */
+		if (UNLIKELY((slot = nanvix_tls_slot(tid)) < 0))
+			return (NULL);
+
+		return (&__nanvix_tls_blocks[slot]);
+	}
+
+	/**
+	 * @brief Gets the storage block of the calling thread.
+	 *
+	 * @returns The storage block of the calling thread, or NULL if it
+	 * has no slot.
+	 *
+	 * @note Getting the ID of the calling thread is a kernel call, so
+	 * hot paths that access several keys should get the block once and
+	 * index it directly.
+	 */
+	static inline struct nanvix_tls_block *nanvix_tls_self(void)
+	{
+		return (nanvix_tls_block_of(kthread_self()));
+	}
+
+	/**
+	 * @brief Gets the value of a key in the calling thread.
+	 *
+	 * @param key Target key.
+	 *
+	 * @returns The value of @p key in the calling thread, or NULL if @p
+	 * key is invalid or has no value.
+	 */
+	static inline void *nanvix_tls_get(nanvix_tls_key_t key)
+	{
+		struct nanvix_tls_block *block;
+
+		/* Invalid key. */
+		if (UNLIKELY(!WITHIN(key, 0, NANVIX_TLS_KEYS_MAX)))
+			return (NULL);
+
+		/* Unknown thread. */
+		if (UNLIKELY((block = nanvix_tls_self()) == NULL))
+			return (NULL);
+
+		return (block->values[key]);
+	}
+
+	/**
+	 * @brief Sets the value of a key in the calling thread.
+	 *
+	 * @param key   Target key.
+	 * @param value Value.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	static inline int nanvix_tls_set(nanvix_tls_key_t key, const void *value)
+	{
+		struct nanvix_tls_block *block;
+
+		/* Invalid key. */
+		if (UNLIKELY(!WITHIN(key, 0, NANVIX_TLS_KEYS_MAX)))
+			return (-EINVAL);
+
+		/* Unknown thread. */
+		if (UNLIKELY((block = nanvix_tls_self()) == NULL))
+			return (-ESRCH);
+
+		block->values[key] = (void *) value;
+
+		return (0);
+	}
+
+#endif /* NANVIX_SYS_TLS_H_ */
+
+/**@}*/
@@ -0,0 +1,184 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @addtogroup nanvix Nanvix System
+ */
+/**@{*/
+
+#ifndef NANVIX_SYS_TRACE_H_
+#define NANVIX_SYS_TRACE_H_
+
+	#include <nanvix/kernel/kernel.h>
+	#include <posix/sys/types.h>
+	#include <posix/stdint.h>
+
+	/**
+	 * @brief If the configuration of IKC tracing is missing, then
+	 * disable it.
+	 */
+	#ifndef __NANVIX_IKC_TRACE
+	#define __NANVIX_IKC_TRACE 0
+	#endif
+
+	/**
+	 * @brief Number of events kept per thread.
+	 */
+	#ifndef NANVIX_TRACE_BUFFER_SIZE
+	#define NANVIX_TRACE_BUFFER_SIZE 128
+	#endif
+
+	/**
+	 * @name Dump format.
+	 */
+	/**@{*/
+	#define NANVIX_TRACE_MAGIC   0x5254564e /**< "NVTR" */
+	#define NANVIX_TRACE_VERSION 1          /**< Format version. */
+	/**@}*/
+
+	/**
+	 * @name Event phases.
+	 */
+	/**@{*/
+	#define NANVIX_TRACE_PHASE_BEGIN   0 /**< Begin of an operation. */
+	#define NANVIX_TRACE_PHASE_END     1 /**< End of an operation.   */
+	#define NANVIX_TRACE_PHASE_INSTANT 2 /**< Instant event.         */
+	/**@}*/
+
+	/**
+	 * @name Event types.
+	 */
+	/**@{*/
+	#define NANVIX_TRACE_KMAILBOX_AWRITE   0  /**< kmailbox_awrite(). */
+	#define NANVIX_TRACE_KMAILBOX_AREAD    1  /**< kmailbox_aread().  */
+	#define NANVIX_TRACE_KMAILBOX_WRITE    2  /**< kmailbox_write().  */
+	#define NANVIX_TRACE_KMAILBOX_READ     3  /**< kmailbox_read().   */
+	#define NANVIX_TRACE_KMAILBOX_WAIT     4  /**< kmailbox_wait().   */
+	#define NANVIX_TRACE_KPORTAL_AWRITE    5  /**< kportal_awrite().  */
+	#define NANVIX_TRACE_KPORTAL_AREAD     6  /**< kportal_aread().   */
+	#define NANVIX_TRACE_KPORTAL_WRITE     7  /**< kportal_write().   */
+	#define NANVIX_TRACE_KPORTAL_READ      8  /**< kportal_read().    */
+	#define NANVIX_TRACE_KPORTAL_WAIT      9  /**< kportal_wait().    */
+	#define NANVIX_TRACE_KSYNC_WAIT        10 /**< ksync_wait().      */
+	#define NANVIX_TRACE_KSYNC_SIGNAL      11 /**< ksync_signal().    */
+	#define NANVIX_TRACE_CHUNK_SEND        12 /**< Chunk sent.        */
+	#define NANVIX_TRACE_CHUNK_RECV        13 /**< Chunk received.    */
+	#define NANVIX_TRACE_ALLOW_WAIT        14 /**< Wait for allow.    */
+	#define NANVIX_TRACE_LOCK_CONTENTION   15 /**< Lock contention.   */
+	#define NANVIX_TRACE_EVENTS_NUM        16 /**< Number of types.   */
+	/**@}*/
+
+	/**
+	 * @brief Trace event.
+	 */
+	struct nanvix_trace_event
+	{
+		uint64_t timestamp; /**< Clock value.      */
+		uint32_t arg;       /**< Argument.         */
+		int16_t id;         /**< Communicator ID.  */
+		uint8_t type;       /**< Type.             */
+		uint8_t phase;      /**< Phase.            */
+	};
+
+	/**
+	 * @brief Header of a trace dump.
+	 */
+	struct nanvix_trace_header
+	{
+		uint32_t magic;    /**< NANVIX_TRACE_MAGIC.    */
+		uint16_t version;  /**< NANVIX_TRACE_VERSION.  */
+		uint16_t node;     /**< Logic ID of the node.  */
+		uint32_t nthreads; /**< Number of threads.     */
+		uint32_t freq;     /**< Clock frequency.       */
+	};
+
+	/**
+	 * @brief Header of the events of a thread in a trace dump.
+	 */
+	struct nanvix_trace_thread
+	{
+		uint32_t thread;  /**< Thread slot.      */
+		uint32_t nevents; /**< Number of events. */
+	};
+
+	/**
+	 * @brief Emits a trace event in the calling thread.
+	 *
+	 * @param type  Event type.
+	 * @param phase Event phase.
+	 * @param id    Communicator ID.
+	 * @param arg   Argument.
+	 */
+	extern void nanvix_trace_emit(int type, int phase, int id, uint32_t arg);
+
+	/**
+	 * @brief Dumps all traced events in binary format.
+	 *
+	 * @param buffer Store location for the dump.
+	 * @param size   Size of @p buffer.
+	 *
+	 * @returns Upon successful completion, the number of bytes written
+	 * to @p buffer is returned. Upon failure, a negative error code is
+	 * returned instead.
+	 */
+	extern ssize_t nanvix_trace_dump(void *buffer, size_t size);
+
+	/**
+	 * @brief Prints all traced events to the standard output.
+	 *
+	 * The binary dump is printed as hexadecimal lines prefixed by
+	 * "[trace]" and the local node number, which is the input format
+	 * of the host-side converter.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_trace_print(void);
+
+	/**
+	 * @brief Discards all traced events.
+	 */
+	extern void nanvix_trace_reset(void);
+
+	/**
+	 * @name Instrumentation points.
+	 */
+	/**@{*/
+	#if (__NANVIX_IKC_TRACE)
+		#define NANVIX_TRACE_BEGIN(type, id) \
+			nanvix_trace_emit((type), NANVIX_TRACE_PHASE_BEGIN, (id), 0)
+		#define NANVIX_TRACE_END(type, id, arg) \
+			nanvix_trace_emit((type), NANVIX_TRACE_PHASE_END, (id), (uint32_t) (arg))
+		#define NANVIX_TRACE_INSTANT(type, id, arg) \
+			nanvix_trace_emit((type), NANVIX_TRACE_PHASE_INSTANT, (id), (uint32_t) (arg))
+	#else
+		#define NANVIX_TRACE_BEGIN(type, id)        ((void) 0)
+		#define NANVIX_TRACE_END(type, id, arg)     ((void) 0)
+		#define NANVIX_TRACE_INSTANT(type, id, arg) ((void) 0)
+	#endif /* __NANVIX_IKC_TRACE */
+	/**@}*/
+
+#endif /* NANVIX_SYS_TRACE_H_ */
+
+/**@}*/
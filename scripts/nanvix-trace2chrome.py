@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+#
+# MIT License
+#
+# Copyright(c) 2011-2020 The Maintainers of Nanvix
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+
+#
+# Converts the output of nanvix_trace_print() into the Chrome trace event
+# format, which can be loaded in chrome://tracing or Perfetto.
+#
+# Usage: nanvix-trace2chrome.py [input] > trace.json
+#
+
+import json
+import struct
+import sys
+
+TRACE_MAGIC   = 0x5254564e
+TRACE_VERSION = 1
+
+# Must match include/nanvix/sys/trace.h.
+EVENT_NAMES = [
+    "kmailbox_awrite",
+    "kmailbox_aread",
+    "kmailbox_write",
+    "kmailbox_read",
+    "kmailbox_wait",
+    "kportal_awrite",
+    "kportal_aread",
+    "kportal_write",
+    "kportal_read",
+    "kportal_wait",
+    "ksync_wait",
+    "ksync_signal",
+    "chunk_send",
+    "chunk_recv",
+    "allow_wait",
+    "lock_contention",
+]
+
+PHASES = ["B", "E", "i"]
+
+HEADER_FMT = "IHHII"
+THREAD_FMT = "II"
+EVENT_FMT  = "QIhBB"
+
+def read_dumps(lines):
+    """Groups hexadecimal trace lines by node."""
+    dumps = {}
+    for line in lines:
+        fields = line.split()
+        if len(fields) != 3 or fields[0] != "[trace]":
+            continue
+        node = int(fields[1])
+        dumps.setdefault(node, bytearray()).extend(bytes.fromhex(fields[2]))
+    return dumps
+
+def parse_dump(data):
+    """Parses the binary dump of a node into trace events."""
+    for endian in ("<", ">"):
+        if struct.unpack_from(endian + "I", data, 0)[0] == TRACE_MAGIC:
+            break
+    else:
+        raise ValueError("bad trace magic")
+
+    magic, version, node, nthreads, freq = struct.unpack_from(endian + HEADER_FMT, data, 0)
+    if version != TRACE_VERSION:
+        raise ValueError("unsupported trace version %d" % version)
+
+    offset = struct.calcsize(endian + HEADER_FMT)
+    events = []
+    for _ in range(nthreads):
+        thread, nevents = struct.unpack_from(endian + THREAD_FMT, data, offset)
+        offset += struct.calcsize(endian + THREAD_FMT)
+        for _ in range(nevents):
+            timestamp, arg, cid, etype, phase = struct.unpack_from(endian + EVENT_FMT, data, offset)
+            offset += struct.calcsize(endian + EVENT_FMT)
+
+            name = EVENT_NAMES[etype] if etype < len(EVENT_NAMES) else "event%d" % etype
+            event = {
+                "name": name,
+                "cat": "ikc",
+                "ph": PHASES[phase] if phase < len(PHASES) else "i",
+                "ts": (timestamp * 1000000.0 / freq) if freq else float(timestamp),
+                "pid": node,
+                "tid": thread,
+                "args": {"id": cid, "arg": arg},
+            }
+            if event["ph"] == "i":
+                event["s"] = "t"
+            events.append(event)
+    return events
+
+def main(argv):
+    stream = open(argv[1]) if len(argv) > 1 else sys.stdin
+    events = []
+    for node, data in sorted(read_dumps(stream).items()):
+        events.extend(parse_dump(bytes(data)))
+    json.dump({"traceEvents": events, "displayTimeUnit": "ns"}, sys.stdout, indent=1)
+    sys.stdout.write("\n")
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
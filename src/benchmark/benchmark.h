@@ -0,0 +1,211 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef _BENCHMARK_H_
+#define _BENCHMARK_H_
+
+	#include <nanvix/sys/histogram.h>
+	#include <nanvix/sys/noc.h>
+	#include <nanvix/sys/perf.h>
+	#include <nanvix/sys/thread.h>
+	#include <posix/stddef.h>
+	#include <posix/stdint.h>
+
+	/**
+	 * @name Involved nodes.
+	 */
+	/**@{*/
+	#define NR_NODES       2
+	#define MASTER_NODENUM 0
+#ifdef __mppa256__
+	#define SLAVE_NODENUM  8
+#else
+	#define SLAVE_NODENUM  1
+#endif
+	/**@}*/
+
+	/**
+	 * @brief Number of discarded iterations before measuring.
+	 */
+	#ifndef BENCHMARK_NWARMUPS
+	#define BENCHMARK_NWARMUPS 3
+	#endif
+
+	/**
+	 * @brief Number of measured iterations.
+	 */
+	#ifndef BENCHMARK_NITERATIONS
+	#define BENCHMARK_NITERATIONS 30
+	#endif
+
+	/**
+	 * @name Nodes of the scaling benchmark.
+	 *
+	 * The first I/O node gathers the results.
+	 */
+	/**@{*/
+	#ifndef BENCHMARK_SCALING_NIOCLUSTERS
+	#define BENCHMARK_SCALING_NIOCLUSTERS 1                       /**< I/O clusters.     */
+	#endif
+	#ifndef BENCHMARK_SCALING_NCCLUSTERS
+	#define BENCHMARK_SCALING_NCCLUSTERS PROCESSOR_CCLUSTERS_NUM /**< Compute clusters. */
+	#endif
+	#define BENCHMARK_SCALING_NNODES \
+		(BENCHMARK_SCALING_NIOCLUSTERS + BENCHMARK_SCALING_NCCLUSTERS)
+	/**@}*/
+
+	/**
+	 * @brief Size of each transfer in the scaling benchmark.
+	 */
+	#ifndef BENCHMARK_SCALING_SIZE
+	#define BENCHMARK_SCALING_SIZE (4 * KB)
+	#endif
+
+	/**
+	 * @brief Name of the IKC backend under test.
+	 */
+	#if __NANVIX_IKC_USES_ONLY_MAILBOX
+	#define BENCHMARK_BACKEND "mailbox"
+	#else
+	#define BENCHMARK_BACKEND "native"
+	#endif
+
+	#define ___STRINGIFY(x) #x
+	#define ___TOSTRING(x) ___STRINGIFY(x)
+
+	/**
+	 * @brief Sleep policies of thread synchronization primitives.
+	 */
+	#define BENCHMARK_SLEEP_CONFIG                                    \
+		"mutex_sleep=" ___TOSTRING(__NANVIX_MUTEX_SLEEP)             \
+		" semaphore_sleep=" ___TOSTRING(__NANVIX_SEMAPHORE_SLEEP)    \
+		" condvar_sleep=" ___TOSTRING(__NANVIX_CONDVAR_SLEEP)
+
+	/**
+	 * @brief Writes a string to the standard output device.
+	 *
+	 * @param str Target string.
+	 */
+	extern void benchmark_puts(const char *str);
+
+	/**
+	 * @brief Gets the next size of a sweep.
+	 *
+	 * Sizes double from one up to @p max, which is always the last
+	 * size of the sweep.
+	 *
+	 * @param size Current size.
+	 * @param max  Largest size.
+	 *
+	 * @returns The next size, or a value above @p max after @p max.
+	 */
+	extern size_t benchmark_next_size(size_t size, size_t max);
+
+	/**
+	 * @brief Reports the latency of an operation.
+	 *
+	 * @param ikc    Communication abstraction.
+	 * @param op     Operation.
+	 * @param nnodes Number of involved nodes.
+	 * @param size   Size of the transferred data.
+	 * @param h      Samples, in cycles.
+	 */
+	extern void benchmark_report_latency(
+		const char *ikc,
+		const char *op,
+		int nnodes,
+		size_t size,
+		struct nanvix_histogram *h
+	);
+
+	/**
+	 * @brief Reports the bandwidth of an operation.
+	 *
+	 * @param ikc    Communication abstraction.
+	 * @param op     Operation.
+	 * @param nnodes Number of involved nodes.
+	 * @param size   Size of each transfer.
+	 * @param nbytes Number of transferred bytes.
+	 * @param cycles Elapsed cycles.
+	 */
+	extern void benchmark_report_bandwidth(
+		const char *ikc,
+		const char *op,
+		int nnodes,
+		size_t size,
+		uint64_t nbytes,
+		uint64_t cycles
+	);
+
+	/**
+	 * @brief Asserts a condition.
+	 *
+	 * @param x Condition to assert.
+	 */
+	#define benchmark_assert(x)                       \
+	{                                                 \
+		if (!(x))                                     \
+		{                                             \
+			benchmark_puts("assertation failed at "   \
+				__FILE__":" ___TOSTRING(__LINE__)"\n" \
+			);                                        \
+			kshutdown();                              \
+		}                                             \
+	}
+
+	/**
+	 * @brief Reports the contention of a lock.
+	 *
+	 * @param lock     Lock type.
+	 * @param nthreads Number of contending threads.
+	 * @param cs       Length of critical sections, in cycles.
+	 * @param counts   Acquisitions of each thread.
+	 * @param cycles   Elapsed cycles.
+	 * @param h        Handoff latencies, in cycles.
+	 */
+	extern void benchmark_report_contention(
+		const char *lock,
+		int nthreads,
+		uint64_t cs,
+		const uint64_t *counts,
+		uint64_t cycles,
+		struct nanvix_histogram *h
+	);
+
+	/**
+	 * @brief Waits for all involved nodes.
+	 */
+	extern void benchmark_barrier(void);
+
+	/**
+	 * @name Benchmark Units
+	 */
+	/**@{*/
+	extern void benchmark_ikc(void);
+	extern void benchmark_scaling(const int *nodes, int nnodes);
+	extern void benchmark_contention(void);
+	/**@}*/
+
+#endif /* _BENCHMARK_H_  */
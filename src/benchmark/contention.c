@@ -0,0 +1,428 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <nanvix/sys/condvar.h>
+#include <nanvix/sys/fmutex.h>
+#include <nanvix/sys/mutex.h>
+#include <nanvix/sys/semaphore.h>
+#include <nanvix/runtime/fence.h>
+#include <posix/stdbool.h>
+#include "benchmark.h"
+
+#if (CORES_NUM > 1)
+
+/*============================================================================*
+ * Constants                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Largest number of contending threads.
+ */
+#define BENCHMARK_CONTENTION_THREADS \
+	((CORES_NUM < THREAD_MAX) ? CORES_NUM : THREAD_MAX)
+
+/**
+ * @brief Duration of each run, in cycles.
+ */
+#ifndef BENCHMARK_CONTENTION_CYCLES
+#define BENCHMARK_CONTENTION_CYCLES (CLUSTER_FREQ / 100)
+#endif
+
+/**
+ * @brief Number of fences crossed in each run.
+ */
+#define BENCHMARK_CONTENTION_NFENCES (10 * BENCHMARK_NITERATIONS)
+
+/**
+ * @name Lock types.
+ */
+/**@{*/
+#define BENCHMARK_LOCK_MUTEX     0 /**< Normal mutex.      */
+#define BENCHMARK_LOCK_RECURSIVE 1 /**< Recursive mutex.   */
+#define BENCHMARK_LOCK_FMUTEX    2 /**< Fast mutex.        */
+#define BENCHMARK_LOCK_SEMAPHORE 3 /**< Binary semaphore.  */
+#define BENCHMARK_LOCK_CONDVAR   4 /**< Condition handoff. */
+#define BENCHMARK_LOCK_FENCE     5 /**< Fence.             */
+#define BENCHMARK_LOCK_NUM       6 /**< Number of types.   */
+/**@}*/
+
+/*============================================================================*
+ * Global variables                                                           *
+ *============================================================================*/
+
+/**
+ * @brief Names of lock types.
+ */
+PRIVATE const char *lock_names[BENCHMARK_LOCK_NUM] = {
+	"mutex-normal",
+	"mutex-recursive",
+	"fmutex",
+	"semaphore",
+	"condvar-handoff",
+	"fence"
+};
+
+/**
+ * @brief Lengths of critical sections, in cycles.
+ */
+PRIVATE const uint64_t cs_lengths[] = { 0, 256, 4096 };
+
+/**
+ * @brief Shared state of a run.
+ */
+PRIVATE struct
+{
+	int type;                                      /**< Lock type.                  */
+	int nthreads;                                  /**< Number of threads.          */
+	uint64_t cs;                                   /**< Critical section length.    */
+	struct nanvix_mutex mutex;                     /**< Mutex.                      */
+	struct nanvix_fmutex fmutex;                   /**< Fast mutex.                 */
+	struct nanvix_semaphore semaphore;             /**< Semaphore.                  */
+	struct nanvix_cond_var cond;                   /**< Condition variable.         */
+	struct fence_t fence;                          /**< Fence under test.           */
+	struct fence_t start;                          /**< Start line.                 */
+	volatile bool stop;                            /**< Stop handoffs?              */
+	volatile int turn;                             /**< Thread holding the token.   */
+	int last_owner;                                /**< Last thread in the section. */
+	uint64_t last_release;                         /**< When it left the section.   */
+	uint64_t counts[BENCHMARK_CONTENTION_THREADS]; /**< Acquisitions per thread.    */
+	struct nanvix_histogram handoffs;              /**< Handoff latencies.          */
+} run;
+
+/**
+ * @brief Arguments of threads.
+ */
+PRIVATE int args[BENCHMARK_CONTENTION_THREADS];
+
+/*============================================================================*
+ * Helpers                                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Busy waits for @p cycles cycles.
+ */
+PRIVATE void benchmark_contention_work(uint64_t cycles)
+{
+	uint64_t t0;
+	uint64_t t1;
+
+	if (cycles == 0)
+		return;
+
+	kclock(&t0);
+
+	do
+		kclock(&t1);
+	while ((t1 - t0) < cycles);
+}
+
+/**
+ * @brief Runs a critical section.
+ *
+ * The handoff latency is the time between the release of the section
+ * by a thread and its acquisition by another thread.
+ */
+PRIVATE void benchmark_contention_section(int me)
+{
+	uint64_t now;
+
+	kclock(&now);
+
+	if ((run.last_owner >= 0) && (run.last_owner != me))
+		nanvix_histogram_record(&run.handoffs, now - run.last_release);
+
+	run.counts[me]++;
+
+	benchmark_contention_work(run.cs);
+
+	run.last_owner = me;
+	kclock(&run.last_release);
+}
+
+/**
+ * @brief Acquires the lock under test.
+ */
+PRIVATE void benchmark_contention_lock(void)
+{
+	switch (run.type)
+	{
+		case BENCHMARK_LOCK_RECURSIVE:
+			benchmark_assert(nanvix_mutex_lock(&run.mutex) == 0);
+			/* Fall through. */
+
+		case BENCHMARK_LOCK_MUTEX:
+			benchmark_assert(nanvix_mutex_lock(&run.mutex) == 0);
+			break;
+
+		case BENCHMARK_LOCK_FMUTEX:
+			benchmark_assert(nanvix_fmutex_lock(&run.fmutex) == 0);
+			break;
+
+		case BENCHMARK_LOCK_SEMAPHORE:
+			benchmark_assert(nanvix_semaphore_down(&run.semaphore) == 0);
+			break;
+
+		default:
+			break;
+	}
+}
+
+/**
+ * @brief Releases the lock under test.
+ */
+PRIVATE void benchmark_contention_unlock(void)
+{
+	switch (run.type)
+	{
+		case BENCHMARK_LOCK_RECURSIVE:
+			benchmark_assert(nanvix_mutex_unlock(&run.mutex) == 0);
+			/* Fall through. */
+
+		case BENCHMARK_LOCK_MUTEX:
+			benchmark_assert(nanvix_mutex_unlock(&run.mutex) == 0);
+			break;
+
+		case BENCHMARK_LOCK_FMUTEX:
+			benchmark_assert(nanvix_fmutex_unlock(&run.fmutex) == 0);
+			break;
+
+		case BENCHMARK_LOCK_SEMAPHORE:
+			benchmark_assert(nanvix_semaphore_up(&run.semaphore) == 0);
+			break;
+
+		default:
+			break;
+	}
+}
+
+/*============================================================================*
+ * Workers                                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Contends for a lock until the run is over.
+ */
+PRIVATE void benchmark_contention_locks(int me)
+{
+	uint64_t now;
+	uint64_t deadline;
+
+	kclock(&now);
+	deadline = now + BENCHMARK_CONTENTION_CYCLES;
+
+	do
+	{
+		benchmark_contention_lock();
+			benchmark_contention_section(me);
+		benchmark_contention_unlock();
+
+		kclock(&now);
+	} while (now < deadline);
+}
+
+/**
+ * @brief Passes a token among threads with a condition variable.
+ *
+ * Each thread waits for its turn, runs the critical section and hands
+ * the token to the next thread.
+ */
+PRIVATE void benchmark_contention_handoff(int me)
+{
+	uint64_t now;
+	uint64_t deadline;
+
+	kclock(&now);
+	deadline = now + BENCHMARK_CONTENTION_CYCLES;
+
+	benchmark_assert(nanvix_mutex_lock(&run.mutex) == 0);
+
+		while (!run.stop)
+		{
+			while ((run.turn != me) && !run.stop)
+				benchmark_assert(nanvix_cond_wait(&run.cond, &run.mutex) == 0);
+
+			if (run.stop)
+				break;
+
+			benchmark_contention_section(me);
+
+			kclock(&now);
+			if (now >= deadline)
+				run.stop = true;
+
+			run.turn = (me + 1) % run.nthreads;
+			benchmark_assert(nanvix_cond_broadcast(&run.cond) == 0);
+		}
+
+	benchmark_assert(nanvix_mutex_unlock(&run.mutex) == 0);
+}
+
+/**
+ * @brief Crosses a fence repeatedly.
+ *
+ * Handoff latencies are the times that the first thread spends in
+ * each fence.
+ */
+PRIVATE void benchmark_contention_fences(int me)
+{
+	uint64_t t0;
+	uint64_t t1;
+
+	for (int i = 0; i < BENCHMARK_CONTENTION_NFENCES; i++)
+	{
+		benchmark_contention_work(run.cs);
+
+		kclock(&t0);
+			fence(&run.fence);
+		kclock(&t1);
+
+		run.counts[me]++;
+
+		if (me == 0)
+			nanvix_histogram_record(&run.handoffs, t1 - t0);
+	}
+}
+
+/**
+ * @brief Contending thread.
+ */
+PRIVATE void * benchmark_contention_worker(void *arg)
+{
+	int me;
+
+	me = *((int *) arg);
+
+	fence(&run.start);
+
+	switch (run.type)
+	{
+		case BENCHMARK_LOCK_CONDVAR:
+			benchmark_contention_handoff(me);
+			break;
+
+		case BENCHMARK_LOCK_FENCE:
+			benchmark_contention_fences(me);
+			break;
+
+		default:
+			benchmark_contention_locks(me);
+			break;
+	}
+
+	return (NULL);
+}
+
+/*============================================================================*
+ * Benchmark: Contention                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Runs @p nthreads threads that contend for a lock of type @p
+ * type, with critical sections of @p cs cycles.
+ */
+PRIVATE void benchmark_contention_run(int type, int nthreads, uint64_t cs)
+{
+	uint64_t t0;
+	uint64_t t1;
+	kthread_t tids[BENCHMARK_CONTENTION_THREADS];
+	struct nanvix_mutexattr mattr;
+
+	run.type       = type;
+	run.nthreads   = nthreads;
+	run.cs         = cs;
+	run.stop       = false;
+	run.turn       = 0;
+	run.last_owner = -1;
+
+	for (int i = 0; i < nthreads; i++)
+	{
+		run.counts[i] = 0;
+		args[i]       = i;
+	}
+
+	nanvix_histogram_init(&run.handoffs);
+
+	benchmark_assert(nanvix_mutexattr_init(&mattr) == 0);
+	benchmark_assert(nanvix_mutexattr_settype(&mattr,
+		(type == BENCHMARK_LOCK_RECURSIVE) ? NANVIX_MUTEX_RECURSIVE : NANVIX_MUTEX_NORMAL
+	) == 0);
+	benchmark_assert(nanvix_mutex_init(&run.mutex, &mattr) == 0);
+	benchmark_assert(nanvix_fmutex_init(&run.fmutex) == 0);
+	benchmark_assert(nanvix_semaphore_init(&run.semaphore, 1) == 0);
+	benchmark_assert(nanvix_cond_init(&run.cond) == 0);
+	fence_init(&run.fence, nthreads);
+	fence_init(&run.start, nthreads);
+
+	/* The calling thread contends as well. */
+	for (int i = 1; i < nthreads; i++)
+		benchmark_assert(kthread_create(&tids[i], benchmark_contention_worker, &args[i]) == 0);
+
+	kclock(&t0);
+		benchmark_contention_worker(&args[0]);
+
+		for (int i = 1; i < nthreads; i++)
+			benchmark_assert(kthread_join(tids[i], NULL) == 0);
+	kclock(&t1);
+
+	benchmark_report_contention(lock_names[type], nthreads, cs, run.counts, t1 - t0, &run.handoffs);
+
+	benchmark_assert(nanvix_cond_destroy(&run.cond) == 0);
+	benchmark_assert(nanvix_semaphore_destroy(&run.semaphore) == 0);
+	benchmark_assert(nanvix_mutex_destroy(&run.mutex) == 0);
+	benchmark_assert(nanvix_mutexattr_destroy(&mattr) == 0);
+}
+
+/*============================================================================*
+ * Benchmark Driver                                                           *
+ *============================================================================*/
+
+/**
+ * The benchmark_contention() function measures the throughput, the
+ * fairness and the handoff latency of thread synchronization
+ * primitives, for growing numbers of threads and critical sections.
+ */
+void benchmark_contention(void)
+{
+	for (int type = 0; type < BENCHMARK_LOCK_NUM; type++)
+	{
+		for (unsigned j = 0; j < (sizeof(cs_lengths) / sizeof(cs_lengths[0])); j++)
+		{
+			for (int n = 1; n <= BENCHMARK_CONTENTION_THREADS; n = (int) benchmark_next_size(n, BENCHMARK_CONTENTION_THREADS))
+				benchmark_contention_run(type, n, cs_lengths[j]);
+		}
+	}
+}
+
+#else
+
+/**
+ * The benchmark_contention() function does nothing, because the
+ * target has a single core.
+ */
+void benchmark_contention(void)
+{
+}
+
+#endif /* CORES_NUM > 1 */
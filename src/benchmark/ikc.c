@@ -0,0 +1,309 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <nanvix/sys/mailbox.h>
+#include <nanvix/sys/portal.h>
+#include <nanvix/sys/sync.h>
+#include <nanvix/sys/noc.h>
+#include "benchmark.h"
+
+/*============================================================================*
+ * Global variables                                                           *
+ *============================================================================*/
+
+#if __TARGET_HAS_PORTAL
+
+/**
+ * @brief Buffer of transfers.
+ */
+PRIVATE char buffer[KPORTAL_MAX_SIZE];
+
+#elif __TARGET_HAS_MAILBOX
+
+/**
+ * @brief Buffer of transfers.
+ */
+PRIVATE char buffer[KMAILBOX_MESSAGE_SIZE];
+
+#endif
+
+/*============================================================================*
+ * Benchmark: Mailbox Ping-Pong                                               *
+ *============================================================================*/
+
+#if __TARGET_HAS_MAILBOX
+
+/**
+ * @brief Benchmark: One-way latency of mailboxes.
+ *
+ * Each sample is half of a round trip.
+ */
+PRIVATE void benchmark_mailbox_pingpong(int local, int remote)
+{
+	int inbox;
+	int outbox;
+	uint64_t t0;
+	uint64_t t1;
+	struct nanvix_histogram h;
+
+	benchmark_assert((inbox = kmailbox_create(local, 0)) >= 0);
+	benchmark_assert((outbox = kmailbox_open(remote, 0)) >= 0);
+
+	for (size_t size = 1; size <= KMAILBOX_MESSAGE_SIZE; size = benchmark_next_size(size, KMAILBOX_MESSAGE_SIZE))
+	{
+		nanvix_histogram_init(&h);
+
+		for (int i = -BENCHMARK_NWARMUPS; i < BENCHMARK_NITERATIONS; i++)
+		{
+			if (local == MASTER_NODENUM)
+			{
+				kclock(&t0);
+					benchmark_assert(kmailbox_write(outbox, buffer, size) == (ssize_t) size);
+					benchmark_assert(kmailbox_read(inbox, buffer, size) == (ssize_t) size);
+				kclock(&t1);
+
+				if (i >= 0)
+					nanvix_histogram_record(&h, (t1 - t0) / 2);
+			}
+			else
+			{
+				benchmark_assert(kmailbox_read(inbox, buffer, size) == (ssize_t) size);
+				benchmark_assert(kmailbox_write(outbox, buffer, size) == (ssize_t) size);
+			}
+		}
+
+		if (local == MASTER_NODENUM)
+			benchmark_report_latency("mailbox", "pingpong", NR_NODES, size, &h);
+	}
+
+	benchmark_assert(kmailbox_close(outbox) == 0);
+	benchmark_assert(kmailbox_unlink(inbox) == 0);
+}
+
+#endif /* __TARGET_HAS_MAILBOX */
+
+/*============================================================================*
+ * Benchmark: Portal Ping-Pong                                                *
+ *============================================================================*/
+
+#if __TARGET_HAS_PORTAL
+
+/**
+ * @brief Benchmark: One-way latency of portals.
+ *
+ * Each sample is half of a round trip.
+ */
+PRIVATE void benchmark_portal_pingpong(int local, int remote)
+{
+	int inportal;
+	int outportal;
+	uint64_t t0;
+	uint64_t t1;
+	struct nanvix_histogram h;
+
+	benchmark_assert((inportal = kportal_create(local, 0)) >= 0);
+	benchmark_assert((outportal = kportal_open(local, remote, 0)) >= 0);
+
+	for (size_t size = 1; size <= KPORTAL_MAX_SIZE; size = benchmark_next_size(size, KPORTAL_MAX_SIZE))
+	{
+		nanvix_histogram_init(&h);
+
+		for (int i = -BENCHMARK_NWARMUPS; i < BENCHMARK_NITERATIONS; i++)
+		{
+			if (local == MASTER_NODENUM)
+			{
+				kclock(&t0);
+					benchmark_assert(kportal_write(outportal, buffer, size) == (ssize_t) size);
+					benchmark_assert(kportal_allow(inportal, remote, 0) == 0);
+					benchmark_assert(kportal_read(inportal, buffer, size) == (ssize_t) size);
+				kclock(&t1);
+
+				if (i >= 0)
+					nanvix_histogram_record(&h, (t1 - t0) / 2);
+			}
+			else
+			{
+				benchmark_assert(kportal_allow(inportal, remote, 0) == 0);
+				benchmark_assert(kportal_read(inportal, buffer, size) == (ssize_t) size);
+				benchmark_assert(kportal_write(outportal, buffer, size) == (ssize_t) size);
+			}
+		}
+
+		if (local == MASTER_NODENUM)
+			benchmark_report_latency("portal", "pingpong", NR_NODES, size, &h);
+	}
+
+	benchmark_assert(kportal_close(outportal) == 0);
+	benchmark_assert(kportal_unlink(inportal) == 0);
+}
+
+/*============================================================================*
+ * Benchmark: Portal Streaming                                                *
+ *============================================================================*/
+
+/**
+ * @brief Benchmark: Sustained bandwidth of portals.
+ *
+ * The master streams transfers to the slave, which acknowledges the
+ * last one, so the elapsed time covers the delivery of all data.
+ */
+PRIVATE void benchmark_portal_stream(int local, int remote)
+{
+	int inportal;
+	int outportal;
+	uint64_t t0;
+	uint64_t t1;
+
+	benchmark_assert((inportal = kportal_create(local, 0)) >= 0);
+	benchmark_assert((outportal = kportal_open(local, remote, 0)) >= 0);
+
+	for (size_t size = 1; size <= KPORTAL_MAX_SIZE; size = benchmark_next_size(size, KPORTAL_MAX_SIZE))
+	{
+		if (local == MASTER_NODENUM)
+		{
+			kclock(&t0);
+
+				for (int i = 0; i < BENCHMARK_NITERATIONS; i++)
+					benchmark_assert(kportal_write(outportal, buffer, size) == (ssize_t) size);
+
+				/* Acknowledgement. */
+				benchmark_assert(kportal_allow(inportal, remote, 0) == 0);
+				benchmark_assert(kportal_read(inportal, buffer, 1) == 1);
+
+			kclock(&t1);
+
+			benchmark_report_bandwidth("portal", "stream", NR_NODES, size, (uint64_t) size * BENCHMARK_NITERATIONS, t1 - t0);
+		}
+		else
+		{
+			for (int i = 0; i < BENCHMARK_NITERATIONS; i++)
+			{
+				benchmark_assert(kportal_allow(inportal, remote, 0) == 0);
+				benchmark_assert(kportal_read(inportal, buffer, size) == (ssize_t) size);
+			}
+
+			benchmark_assert(kportal_write(outportal, buffer, 1) == 1);
+		}
+	}
+
+	benchmark_assert(kportal_close(outportal) == 0);
+	benchmark_assert(kportal_unlink(inportal) == 0);
+}
+
+#endif /* __TARGET_HAS_PORTAL */
+
+/*============================================================================*
+ * Benchmark: Sync Ping-Pong                                                  *
+ *============================================================================*/
+
+#if __TARGET_HAS_SYNC
+
+/**
+ * @brief Benchmark: One-way latency of synchronization points.
+ *
+ * Each sample is half of a round trip.
+ */
+PRIVATE void benchmark_sync_pingpong(int local)
+{
+	int syncin;
+	int syncout;
+	uint64_t t0;
+	uint64_t t1;
+	struct nanvix_histogram h;
+	const int nodes[NR_NODES] = { MASTER_NODENUM, SLAVE_NODENUM };
+
+	benchmark_assert((syncin = ksync_create(nodes, NR_NODES, (local == MASTER_NODENUM) ? SYNC_ALL_TO_ONE : SYNC_ONE_TO_ALL)) >= 0);
+
+	/* Inputs must exist before signals are sent. */
+	benchmark_barrier();
+
+	benchmark_assert((syncout = ksync_open(nodes, NR_NODES, (local == MASTER_NODENUM) ? SYNC_ONE_TO_ALL : SYNC_ALL_TO_ONE)) >= 0);
+
+	nanvix_histogram_init(&h);
+
+	for (int i = -BENCHMARK_NWARMUPS; i < BENCHMARK_NITERATIONS; i++)
+	{
+		if (local == MASTER_NODENUM)
+		{
+			kclock(&t0);
+				benchmark_assert(ksync_signal(syncout) == 0);
+				benchmark_assert(ksync_wait(syncin) == 0);
+			kclock(&t1);
+
+			if (i >= 0)
+				nanvix_histogram_record(&h, (t1 - t0) / 2);
+		}
+		else
+		{
+			benchmark_assert(ksync_wait(syncin) == 0);
+			benchmark_assert(ksync_signal(syncout) == 0);
+		}
+	}
+
+	if (local == MASTER_NODENUM)
+		benchmark_report_latency("sync", "pingpong", NR_NODES, 0, &h);
+
+	benchmark_assert(ksync_close(syncout) == 0);
+	benchmark_assert(ksync_unlink(syncin) == 0);
+}
+
+#endif /* __TARGET_HAS_SYNC */
+
+/*============================================================================*
+ * Benchmark Driver                                                           *
+ *============================================================================*/
+
+/**
+ * The benchmark_ikc() function measures the latency and the bandwidth
+ * of IKC abstractions between the master and the slave nodes.
+ */
+void benchmark_ikc(void)
+{
+	int local;
+	int remote;
+
+	local  = knode_get_num();
+	remote = (local == MASTER_NODENUM) ? SLAVE_NODENUM : MASTER_NODENUM;
+
+	((void) remote);
+
+#if __TARGET_HAS_MAILBOX
+	benchmark_mailbox_pingpong(local, remote);
+	benchmark_barrier();
+#endif
+
+#if __TARGET_HAS_PORTAL
+	benchmark_portal_pingpong(local, remote);
+	benchmark_barrier();
+
+	benchmark_portal_stream(local, remote);
+	benchmark_barrier();
+#endif
+
+#if __TARGET_HAS_SYNC
+	benchmark_sync_pingpong(local);
+	benchmark_barrier();
+#endif
+}
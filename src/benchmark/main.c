@@ -0,0 +1,181 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <nanvix/sys/dev.h>
+#include <nanvix/sys/noc.h>
+#include <nanvix/runtime/barrier.h>
+#include <nanvix/runtime/stdikc.h>
+#include "benchmark.h"
+
+/**
+ * @brief Involved nodes.
+ */
+const int _nodenums[NR_NODES] ALIGN(sizeof(uint64_t)) = {
+	MASTER_NODENUM, SLAVE_NODENUM
+};
+
+#if __TARGET_HAS_SYNC
+
+/**
+ * @brief Barrier among involved nodes.
+ */
+PRIVATE barrier_t _barrier;
+
+#endif /* __TARGET_HAS_SYNC */
+
+#ifdef __mppa256__
+
+/**
+ * @brief Stub main().
+ */
+int main(int argc, const char *argv[])
+{
+	UNUSED(argc);
+	UNUSED(argv);
+
+	return (0);
+}
+
+#endif /* __mppa256__ */
+
+/*============================================================================*
+ * strlen()                                                                   *
+ *============================================================================*/
+
+/**
+ * @brief Returns the length of a string.
+ *
+ * @param str String to be evaluated.
+ *
+ * @returns The length of the string.
+ */
+size_t strlen(const char *str)
+{
+	const char *p;
+
+	/* Count the number of characters. */
+	for (p = str; *p != '\0'; p++)
+		/* noop */;
+
+	return (p - str);
+}
+
+/*============================================================================*
+ * benchmark_puts()                                                           *
+ *============================================================================*/
+
+/**
+ * The benchmark_puts() function writes to the standard output device
+ * the string pointed to by @p str.
+ */
+void benchmark_puts(const char *str)
+{
+	nanvix_write(0, str, strlen(str));
+}
+
+/*============================================================================*
+ * benchmark_barrier()                                                        *
+ *============================================================================*/
+
+/**
+ * The benchmark_barrier() function waits until all involved nodes
+ * reach it.
+ */
+void benchmark_barrier(void)
+{
+#if __TARGET_HAS_SYNC
+	benchmark_assert(barrier_wait(_barrier) == 0);
+#endif
+}
+
+/*============================================================================*
+ * main()                                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Launches IKC benchmarks.
+ *
+ * @param argc Argument counter.
+ * @param argv Argument variables.
+ */
+void ___start(int argc, const char *argv[])
+{
+	int index;
+	int nodenum;
+	int scaling_nodes[BENCHMARK_SCALING_NNODES];
+
+	/* Required. */
+	knoc_init();
+
+	((void) argc);
+	((void) argv);
+
+#if __TARGET_HAS_SYNC
+	/* All nodes start together, so scaling runs first. */
+	build_node_list(scaling_nodes, BENCHMARK_SCALING_NIOCLUSTERS, BENCHMARK_SCALING_NCCLUSTERS);
+	benchmark_scaling(scaling_nodes, BENCHMARK_SCALING_NNODES);
+#else
+	((void) scaling_nodes);
+#endif
+
+	index   = -1;
+	nodenum = knode_get_num();
+
+	/* Finds the index of local node on nodenums vector. */
+	for (int i = 0; i < NR_NODES; ++i)
+	{
+		if (nodenum == _nodenums[i])
+		{
+			index = i;
+			break;
+		}
+	}
+
+	/* Only involved nodes. */
+	if (index >= 0)
+	{
+	#if __TARGET_HAS_SYNC
+		_barrier = barrier_create(_nodenums, NR_NODES);
+		benchmark_assert(BARRIER_IS_VALID(_barrier));
+
+			benchmark_barrier();
+
+			benchmark_ikc();
+
+			/* Waits everyone finishes the routines. */
+			benchmark_barrier();
+
+		benchmark_assert(barrier_destroy(_barrier) == 0);
+	#endif /* __TARGET_HAS_SYNC */
+
+		/* Threads of a single node. */
+		if (nodenum == MASTER_NODENUM)
+			benchmark_contention();
+	}
+
+	/* Halt. */
+	kshutdown();
+	UNREACHABLE();
+}
@@ -0,0 +1,270 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <nanvix/sys/dev.h>
+#include "benchmark.h"
+
+/**
+ * @brief Length of a printed result line.
+ */
+#define BENCHMARK_LINE_SIZE 256
+
+/*============================================================================*
+ * Helpers                                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Appends a string to a line.
+ *
+ * @param line Target line.
+ * @param len  Current length of @p line.
+ * @param str  String to append.
+ *
+ * @returns The new length of @p line.
+ */
+PRIVATE int benchmark_line_puts(char *line, int len, const char *str)
+{
+	while ((*str != '\0') && (len < (BENCHMARK_LINE_SIZE - 1)))
+		line[len++] = *str++;
+
+	return (len);
+}
+
+/**
+ * @brief Appends an unsigned number to a line.
+ *
+ * @param line Target line.
+ * @param len  Current length of @p line.
+ * @param num  Number to append.
+ *
+ * @returns The new length of @p line.
+ */
+PRIVATE int benchmark_line_putu(char *line, int len, uint64_t num)
+{
+	int n;
+	char digits[21];
+
+	n = 0;
+	do
+	{
+		digits[n++] = '0' + (num % 10);
+		num /= 10;
+	} while (num > 0);
+
+	while ((n > 0) && (len < (BENCHMARK_LINE_SIZE - 1)))
+		line[len++] = digits[--n];
+
+	return (len);
+}
+
+/**
+ * @brief Starts a result line.
+ *
+ * @param line   Target line.
+ * @param ikc    Communication abstraction.
+ * @param op     Operation.
+ * @param nnodes Number of involved nodes.
+ * @param size   Size of the transferred data.
+ *
+ * @returns The length of @p line.
+ */
+PRIVATE int benchmark_line_start(char *line, const char *ikc, const char *op, int nnodes, size_t size)
+{
+	int len;
+
+	len = benchmark_line_puts(line, 0, "[benchmark] backend=" BENCHMARK_BACKEND " ikc=");
+	len = benchmark_line_puts(line, len, ikc);
+	len = benchmark_line_puts(line, len, " op=");
+	len = benchmark_line_puts(line, len, op);
+	len = benchmark_line_puts(line, len, " nodes=");
+	len = benchmark_line_putu(line, len, nnodes);
+	len = benchmark_line_puts(line, len, " size=");
+	len = benchmark_line_putu(line, len, size);
+
+	return (len);
+}
+
+/*============================================================================*
+ * benchmark_next_size()                                                      *
+ *============================================================================*/
+
+/**
+ * The benchmark_next_size() function returns the size that follows @p
+ * size in a sweep that ends at @p max.
+ */
+size_t benchmark_next_size(size_t size, size_t max)
+{
+	/* End of sweep. */
+	if (size >= max)
+		return (max + 1);
+
+	return (((size * 2) < max) ? (size * 2) : max);
+}
+
+/*============================================================================*
+ * benchmark_report_latency()                                                 *
+ *============================================================================*/
+
+/**
+ * The benchmark_report_latency() function writes a line with the
+ * percentiles of the samples in @p h to the standard output device.
+ */
+void benchmark_report_latency(
+	const char *ikc,
+	const char *op,
+	int nnodes,
+	size_t size,
+	struct nanvix_histogram *h
+)
+{
+	int len;
+	char line[BENCHMARK_LINE_SIZE];
+	struct nanvix_histogram_summary summary;
+
+	nanvix_histogram_summary(h, &summary);
+
+	len = benchmark_line_start(line, ikc, op, nnodes, size);
+	len = benchmark_line_puts(line, len, " n=");
+	len = benchmark_line_putu(line, len, summary.count);
+	len = benchmark_line_puts(line, len, " min=");
+	len = benchmark_line_putu(line, len, summary.min);
+	len = benchmark_line_puts(line, len, " mean=");
+	len = benchmark_line_putu(line, len, summary.mean);
+	len = benchmark_line_puts(line, len, " p50=");
+	len = benchmark_line_putu(line, len, summary.p50);
+	len = benchmark_line_puts(line, len, " p90=");
+	len = benchmark_line_putu(line, len, summary.p90);
+	len = benchmark_line_puts(line, len, " p99=");
+	len = benchmark_line_putu(line, len, summary.p99);
+	len = benchmark_line_puts(line, len, " max=");
+	len = benchmark_line_putu(line, len, summary.max);
+	len = benchmark_line_puts(line, len, " unit=cycles");
+	line[len++] = '\n';
+
+	nanvix_write(0, line, len);
+}
+
+/*============================================================================*
+ * benchmark_report_bandwidth()                                               *
+ *============================================================================*/
+
+/**
+ * The benchmark_report_bandwidth() function writes a line with the
+ * bandwidth of moving @p nbytes in @p cycles to the standard output
+ * device.
+ */
+void benchmark_report_bandwidth(
+	const char *ikc,
+	const char *op,
+	int nnodes,
+	size_t size,
+	uint64_t nbytes,
+	uint64_t cycles
+)
+{
+	int len;
+	uint64_t bandwidth;
+	char line[BENCHMARK_LINE_SIZE];
+
+	/* Bytes per second, in kilobytes. */
+	bandwidth = (cycles == 0) ? 0 : ((nbytes * CLUSTER_FREQ) / cycles) / KB;
+
+	len = benchmark_line_start(line, ikc, op, nnodes, size);
+	len = benchmark_line_puts(line, len, " bytes=");
+	len = benchmark_line_putu(line, len, nbytes);
+	len = benchmark_line_puts(line, len, " cycles=");
+	len = benchmark_line_putu(line, len, cycles);
+	len = benchmark_line_puts(line, len, " bandwidth=");
+	len = benchmark_line_putu(line, len, bandwidth);
+	len = benchmark_line_puts(line, len, " unit=KB/s");
+	line[len++] = '\n';
+
+	nanvix_write(0, line, len);
+}
+
+/*============================================================================*
+ * benchmark_report_contention()                                              *
+ *============================================================================*/
+
+/**
+ * The benchmark_report_contention() function writes a line with the
+ * throughput, the spread of acquisitions among threads and the handoff
+ * latency of a lock to the standard output device.
+ */
+void benchmark_report_contention(
+	const char *lock,
+	int nthreads,
+	uint64_t cs,
+	const uint64_t *counts,
+	uint64_t cycles,
+	struct nanvix_histogram *h
+)
+{
+	int len;
+	uint64_t min;
+	uint64_t max;
+	uint64_t total;
+	uint64_t rate;
+	char line[BENCHMARK_LINE_SIZE];
+	struct nanvix_histogram_summary summary;
+
+	min   = UINT64_MAX;
+	max   = 0;
+	total = 0;
+	for (int i = 0; i < nthreads; i++)
+	{
+		min    = (counts[i] < min) ? counts[i] : min;
+		max    = (counts[i] > max) ? counts[i] : max;
+		total += counts[i];
+	}
+
+	/* Acquisitions per second. */
+	rate = (cycles == 0) ? 0 : (total * CLUSTER_FREQ) / cycles;
+
+	nanvix_histogram_summary(h, &summary);
+
+	len = benchmark_line_puts(line, 0, "[benchmark] " BENCHMARK_SLEEP_CONFIG " lock=");
+	len = benchmark_line_puts(line, len, lock);
+	len = benchmark_line_puts(line, len, " threads=");
+	len = benchmark_line_putu(line, len, nthreads);
+	len = benchmark_line_puts(line, len, " cs=");
+	len = benchmark_line_putu(line, len, cs);
+	len = benchmark_line_puts(line, len, " acquires=");
+	len = benchmark_line_putu(line, len, total);
+	len = benchmark_line_puts(line, len, " rate=");
+	len = benchmark_line_putu(line, len, rate);
+	len = benchmark_line_puts(line, len, " min=");
+	len = benchmark_line_putu(line, len, min);
+	len = benchmark_line_puts(line, len, " max=");
+	len = benchmark_line_putu(line, len, max);
+	len = benchmark_line_puts(line, len, " handoff_p50=");
+	len = benchmark_line_putu(line, len, summary.p50);
+	len = benchmark_line_puts(line, len, " handoff_p99=");
+	len = benchmark_line_putu(line, len, summary.p99);
+	len = benchmark_line_puts(line, len, " unit=cycles");
+	line[len++] = '\n';
+
+	nanvix_write(0, line, len);
+}
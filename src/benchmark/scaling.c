@@ -0,0 +1,340 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <nanvix/sys/portal.h>
+#include <nanvix/sys/sync.h>
+#include <nanvix/sys/noc.h>
+#include <nanvix/runtime/barrier.h>
+#include "benchmark.h"
+
+#if __TARGET_HAS_PORTAL && __TARGET_HAS_SYNC
+
+/*============================================================================*
+ * Global variables                                                           *
+ *============================================================================*/
+
+/**
+ * @name Buffers of transfers.
+ */
+/**@{*/
+PRIVATE char sendbuf[BENCHMARK_SCALING_SIZE]; /**< Outgoing data. */
+PRIVATE char recvbuf[BENCHMARK_SCALING_SIZE]; /**< Incoming data. */
+/**@}*/
+
+/**
+ * @brief Barrier among all nodes of the scaling benchmark, which
+ * separates steps.
+ */
+PRIVATE barrier_t scaling_barrier;
+
+/*============================================================================*
+ * Benchmark: Barrier                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Benchmark: Latency of a barrier among @p n nodes.
+ */
+PRIVATE void benchmark_scaling_barrier(barrier_t barrier, int n, int index)
+{
+	uint64_t t0;
+	uint64_t t1;
+	struct nanvix_histogram h;
+
+	nanvix_histogram_init(&h);
+
+	for (int i = -BENCHMARK_NWARMUPS; i < BENCHMARK_NITERATIONS; i++)
+	{
+		kclock(&t0);
+			benchmark_assert(barrier_wait(barrier) == 0);
+		kclock(&t1);
+
+		if (i >= 0)
+			nanvix_histogram_record(&h, t1 - t0);
+	}
+
+	if (index == 0)
+		benchmark_report_latency("barrier", "wait", n, 0, &h);
+}
+
+/*============================================================================*
+ * Benchmark: Incast                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Benchmark: Throughput of @p n - 1 nodes writing to the first.
+ *
+ * The first node is an I/O node, which is where requests of services
+ * usually converge.
+ */
+PRIVATE void benchmark_scaling_incast(barrier_t barrier, const int *nodes, int n, int index)
+{
+	int local;
+	int portalid;
+	uint64_t t0;
+	uint64_t t1;
+
+	local = knode_get_num();
+
+	if (index == 0)
+	{
+		benchmark_assert((portalid = kportal_create(local, 0)) >= 0);
+
+		benchmark_assert(barrier_wait(barrier) == 0);
+
+		kclock(&t0);
+
+			for (int i = 0; i < BENCHMARK_NITERATIONS; i++)
+			{
+				for (int j = 1; j < n; j++)
+				{
+					benchmark_assert(kportal_allow(portalid, nodes[j], 0) == 0);
+					benchmark_assert(kportal_read(portalid, recvbuf, BENCHMARK_SCALING_SIZE) == BENCHMARK_SCALING_SIZE);
+				}
+			}
+
+		kclock(&t1);
+
+		benchmark_report_bandwidth(
+			"portal",
+			"incast",
+			n,
+			BENCHMARK_SCALING_SIZE,
+			(uint64_t) BENCHMARK_SCALING_SIZE * BENCHMARK_NITERATIONS * (n - 1),
+			t1 - t0
+		);
+
+		benchmark_assert(kportal_unlink(portalid) == 0);
+	}
+	else
+	{
+		benchmark_assert((portalid = kportal_open(local, nodes[0], 0)) >= 0);
+
+		benchmark_assert(barrier_wait(barrier) == 0);
+
+		for (int i = 0; i < BENCHMARK_NITERATIONS; i++)
+			benchmark_assert(kportal_write(portalid, sendbuf, BENCHMARK_SCALING_SIZE) == BENCHMARK_SCALING_SIZE);
+
+		benchmark_assert(kportal_close(portalid) == 0);
+	}
+}
+
+/*============================================================================*
+ * Benchmark: All-to-All                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Benchmark: Throughput of an all-to-all exchange among @p n
+ * nodes.
+ *
+ * In round r, node i sends to node i + r and receives from node i - r,
+ * so every node sends and receives once per round. Each node allows
+ * its inbound portal before writing, because a write waits for the
+ * remote to allow it. Writes are asynchronous and one portal message
+ * long, so that every node then reaches its own read.
+ */
+PRIVATE void benchmark_scaling_alltoall(barrier_t barrier, const int *nodes, int n, int index)
+{
+	int local;
+	int inportal;
+	int outportal;
+	int src;
+	int dst;
+	size_t chunk;
+	uint64_t t0;
+	uint64_t t1;
+	uint64_t cycles;
+
+	local  = knode_get_num();
+	cycles = 0;
+
+	benchmark_assert((inportal = kportal_create(local, 0)) >= 0);
+
+	benchmark_assert(barrier_wait(barrier) == 0);
+
+	for (int r = 1; r < n; r++)
+	{
+		dst = nodes[(index + r) % n];
+		src = nodes[(index - r + n) % n];
+
+		benchmark_assert((outportal = kportal_open(local, dst, 0)) >= 0);
+
+		kclock(&t0);
+
+			for (int i = 0; i < BENCHMARK_NITERATIONS; i++)
+			{
+				for (size_t k = 0; k < BENCHMARK_SCALING_SIZE; k += chunk)
+				{
+					chunk = BENCHMARK_SCALING_SIZE - k;
+					chunk = (chunk < KPORTAL_MESSAGE_DATA_SIZE) ? chunk : KPORTAL_MESSAGE_DATA_SIZE;
+
+					benchmark_assert(kportal_allow(inportal, src, 0) == 0);
+					benchmark_assert(kportal_awrite(outportal, &sendbuf[k], chunk) >= 0);
+					benchmark_assert(kportal_read(inportal, &recvbuf[k], chunk) == (ssize_t) chunk);
+					benchmark_assert(kportal_wait(outportal) == 0);
+				}
+			}
+
+		kclock(&t1);
+
+		cycles += (t1 - t0);
+
+		benchmark_assert(kportal_close(outportal) == 0);
+	}
+
+	/* Data sent and received by the first node. */
+	if (index == 0)
+	{
+		benchmark_report_bandwidth(
+			"portal",
+			"alltoall",
+			n,
+			BENCHMARK_SCALING_SIZE,
+			2 * (uint64_t) BENCHMARK_SCALING_SIZE * BENCHMARK_NITERATIONS * (n - 1),
+			cycles
+		);
+	}
+
+	benchmark_assert(barrier_wait(barrier) == 0);
+
+	benchmark_assert(kportal_unlink(inportal) == 0);
+}
+
+/*============================================================================*
+ * Benchmark: Sync Fan-Out                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Benchmark: Latency of a signal from the first node to the
+ * other @p n - 1 nodes, until all of them acknowledge it.
+ */
+PRIVATE void benchmark_scaling_fanout(barrier_t barrier, const int *nodes, int n, int index)
+{
+	int syncin;
+	int syncout;
+	uint64_t t0;
+	uint64_t t1;
+	struct nanvix_histogram h;
+
+	benchmark_assert((syncin = ksync_create(nodes, n, (index == 0) ? SYNC_ALL_TO_ONE : SYNC_ONE_TO_ALL)) >= 0);
+
+	/* Inputs must exist before signals are sent. */
+	benchmark_assert(barrier_wait(barrier) == 0);
+
+	benchmark_assert((syncout = ksync_open(nodes, n, (index == 0) ? SYNC_ONE_TO_ALL : SYNC_ALL_TO_ONE)) >= 0);
+
+	nanvix_histogram_init(&h);
+
+	for (int i = -BENCHMARK_NWARMUPS; i < BENCHMARK_NITERATIONS; i++)
+	{
+		if (index == 0)
+		{
+			kclock(&t0);
+				benchmark_assert(ksync_signal(syncout) == 0);
+				benchmark_assert(ksync_wait(syncin) == 0);
+			kclock(&t1);
+
+			if (i >= 0)
+				nanvix_histogram_record(&h, t1 - t0);
+		}
+		else
+		{
+			benchmark_assert(ksync_wait(syncin) == 0);
+			benchmark_assert(ksync_signal(syncout) == 0);
+		}
+	}
+
+	if (index == 0)
+		benchmark_report_latency("sync", "fanout", n, 0, &h);
+
+	benchmark_assert(ksync_close(syncout) == 0);
+	benchmark_assert(ksync_unlink(syncin) == 0);
+}
+
+/*============================================================================*
+ * Benchmark Driver                                                           *
+ *============================================================================*/
+
+/**
+ * The benchmark_scaling() function measures collective communication
+ * patterns on growing prefixes of the @p nnodes nodes listed in @p
+ * nodes, doubling the number of nodes up to @p nnodes. The first node
+ * reports the results.
+ */
+void benchmark_scaling(const int *nodes, int nnodes)
+{
+	int index;
+	barrier_t barrier;
+
+	index = -1;
+	for (int i = 0; i < nnodes; i++)
+	{
+		if (nodes[i] == knode_get_num())
+			index = i;
+	}
+
+	/* Not involved. */
+	if (index < 0)
+		return;
+
+	scaling_barrier = barrier_create(nodes, nnodes);
+	benchmark_assert(BARRIER_IS_VALID(scaling_barrier));
+
+	benchmark_assert(barrier_wait(scaling_barrier) == 0);
+
+	for (int n = 2; n <= nnodes; n = (int) benchmark_next_size(n, nnodes))
+	{
+		/* Only the first n nodes take part. */
+		if (index < n)
+		{
+			barrier = barrier_create(nodes, n);
+			benchmark_assert(BARRIER_IS_VALID(barrier));
+
+				benchmark_scaling_barrier(barrier, n, index);
+				benchmark_scaling_fanout(barrier, nodes, n, index);
+				benchmark_scaling_incast(barrier, nodes, n, index);
+				benchmark_scaling_alltoall(barrier, nodes, n, index);
+
+			benchmark_assert(barrier_destroy(barrier) == 0);
+		}
+
+		benchmark_assert(barrier_wait(scaling_barrier) == 0);
+	}
+
+	benchmark_assert(barrier_destroy(scaling_barrier) == 0);
+}
+
+#else
+
+/**
+ * The benchmark_scaling() function does nothing, because the target
+ * lacks portals or synchronization points.
+ */
+void benchmark_scaling(const int *nodes, int nnodes)
+{
+	((void) nodes);
+	((void) nnodes);
+}
+
+#endif /* __TARGET_HAS_PORTAL && __TARGET_HAS_SYNC */
@@ -0,0 +1,79 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <nanvix/sys/backoff.h>
+#include <nanvix/sys/thread.h>
+
+/*============================================================================*
+ * nanvix_backoff_init()                                                      *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_backoff_init() function initializes the state @p
+ * backoff of a retry loop that waits with the policy @p policy.
+ */
+PUBLIC void nanvix_backoff_init(struct nanvix_backoff *backoff, int policy)
+{
+	backoff->policy = policy;
+	backoff->delay  = NANVIX_BACKOFF_DELAY_MIN;
+}
+
+/*============================================================================*
+ * nanvix_backoff_wait()                                                      *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_backoff_wait() function waits before the next
+ * retry of the loop whose state is @p backoff. With the exponential
+ * policy, the calling thread busy-waits for a delay that doubles at
+ * each retry, without issuing kernel calls. Once the delay reaches its
+ * upper bound, the core is also yielded to other threads at each
+ * retry.
+ */
+PUBLIC void nanvix_backoff_wait(struct nanvix_backoff *backoff)
+{
+	switch (backoff->policy)
+	{
+		case NANVIX_BACKOFF_EXPONENTIAL:
+		{
+			for (volatile uint32_t i = 0; i < backoff->delay; i++)
+				/* noop */;
+
+			/* Delay exhausted. */
+			if (backoff->delay >= NANVIX_BACKOFF_DELAY_MAX)
+				kthread_yield();
+			else
+				backoff->delay <<= 1;
+		} break;
+
+		case NANVIX_BACKOFF_YIELD:
+			kthread_yield();
+			break;
+
+		/* Spin. */
+		default:
+			break;
+	}
+}
@@ -0,0 +1,73 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <nanvix/sys/counters.h>
+
+#if (__NANVIX_IKC_STATS)
+
+/*============================================================================*
+ * nanvix_counters_get()                                                      *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_counters_get() function sums the counter @p
+ * counter over all shards of the counter set @p counters.
+ */
+PUBLIC uint64_t nanvix_counters_get(const struct nanvix_counters *counters, int counter)
+{
+	uint64_t sum;
+
+	/* Invalid counter. */
+	if (!WITHIN(counter, 0, NANVIX_COUNTERS_MAX))
+		return (0);
+
+	sum = 0;
+	for (int i = 0; i < NANVIX_COUNTERS_SHARDS; i++)
+		sum += counters->shards[i].values[counter];
+
+	return (sum);
+}
+
+/*============================================================================*
+ * nanvix_counters_reset()                                                    *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_counters_reset() function zeroes all counters of
+ * all shards of the counter set @p counters. It should not be called
+ * while other threads are counting.
+ */
+PUBLIC void nanvix_counters_reset(struct nanvix_counters *counters)
+{
+	for (int i = 0; i < NANVIX_COUNTERS_SHARDS; i++)
+	{
+		for (int j = 0; j < NANVIX_COUNTERS_MAX; j++)
+			counters->shards[i].values[j] = 0;
+	}
+}
+
+#else
+extern int make_iso_compilers_happy;
+#endif /* __NANVIX_IKC_STATS */
@@ -0,0 +1,258 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/sys/histogram.h>
+#include <nanvix/sys/perf.h>
+
+/**
+ * @brief Number of sub-buckets per power of two.
+ */
+#define HISTOGRAM_SUB (1 << NANVIX_HISTOGRAM_SUB_BITS)
+
+/*============================================================================*
+ * Helpers                                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Gets the bucket of a value.
+ *
+ * @param value Target value.
+ *
+ * @returns The bucket of @p value.
+ */
+PRIVATE int histogram_bucket(uint64_t value)
+{
+	int msb;
+	int bucket;
+
+	/* Small values are exact. */
+	if (value < HISTOGRAM_SUB)
+		return ((int) value);
+
+	/* Most significant bit. */
+	for (msb = 0; (value >> msb) > 1; msb++)
+		/* noop */;
+
+	bucket = ((msb - NANVIX_HISTOGRAM_SUB_BITS + 1) << NANVIX_HISTOGRAM_SUB_BITS) +
+		(int) ((value >> (msb - NANVIX_HISTOGRAM_SUB_BITS)) & (HISTOGRAM_SUB - 1));
+
+	return ((bucket < NANVIX_HISTOGRAM_BUCKETS) ? bucket : (NANVIX_HISTOGRAM_BUCKETS - 1));
+}
+
+/**
+ * @brief Gets the highest value of a bucket.
+ *
+ * @param bucket Target bucket.
+ *
+ * @returns The highest value that falls into @p bucket.
+ */
+PRIVATE uint64_t histogram_bucket_max(int bucket)
+{
+	int shift;
+	uint64_t lower;
+
+	/* Small values are exact. */
+	if (bucket < HISTOGRAM_SUB)
+		return ((uint64_t) bucket);
+
+	shift = (bucket >> NANVIX_HISTOGRAM_SUB_BITS) - 1;
+	lower = ((uint64_t) (HISTOGRAM_SUB + (bucket & (HISTOGRAM_SUB - 1)))) << shift;
+
+	return (lower + (1ULL << shift) - 1);
+}
+
+/**
+ * @brief Gets a percentile of a histogram.
+ *
+ * @param h        Target histogram.
+ * @param permille Target percentile, in thousandths.
+ *
+ * @returns The highest value of the bucket that holds the @p permille
+ * percentile of @p h.
+ */
+PRIVATE uint64_t histogram_percentile(const struct nanvix_histogram *h, uint64_t permille)
+{
+	uint64_t rank;
+	uint64_t seen;
+
+	if (h->count == 0)
+		return (0);
+
+	/* Rank of the target sample, rounded up. */
+	rank = (h->count * permille + 999) / 1000;
+	seen = 0;
+
+	for (int i = 0; i < NANVIX_HISTOGRAM_BUCKETS; i++)
+	{
+		seen += h->buckets[i];
+
+		if (seen >= rank)
+		{
+			uint64_t value = histogram_bucket_max(i);
+			return ((value < h->max) ? value : h->max);
+		}
+	}
+
+	return (h->max);
+}
+
+/**
+ * @brief Discards all samples of a histogram.
+ *
+ * @param h Target histogram.
+ *
+ * @note The lock of @p h must be held.
+ */
+PRIVATE void do_histogram_reset(struct nanvix_histogram *h)
+{
+	h->count = 0;
+	h->sum   = 0;
+	h->min   = ~((uint64_t) 0);
+	h->max   = 0;
+
+	for (int i = 0; i < NANVIX_HISTOGRAM_BUCKETS; i++)
+		h->buckets[i] = 0;
+}
+
+/*============================================================================*
+ * nanvix_histogram_init()                                                    *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_histogram_init() function initializes the
+ * histogram @p h.
+ */
+PUBLIC void nanvix_histogram_init(struct nanvix_histogram *h)
+{
+	spinlock_init(&h->lock);
+	do_histogram_reset(h);
+}
+
+/*============================================================================*
+ * nanvix_histogram_record()                                                  *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_histogram_record() function accounts the sample
+ * @p value in the histogram @p h.
+ */
+PUBLIC void nanvix_histogram_record(struct nanvix_histogram *h, uint64_t value)
+{
+	int bucket;
+
+	bucket = histogram_bucket(value);
+
+	spinlock_lock(&h->lock);
+
+		h->count++;
+		h->sum += value;
+		h->buckets[bucket]++;
+
+		if (value < h->min)
+			h->min = value;
+		if (value > h->max)
+			h->max = value;
+
+	spinlock_unlock(&h->lock);
+}
+
+/*============================================================================*
+ * nanvix_histogram_summary()                                                 *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_histogram_summary() function stores in @p
+ * summary the sample count, extremes, mean and percentiles of the
+ * histogram @p h.
+ */
+PUBLIC void nanvix_histogram_summary(
+	struct nanvix_histogram *h,
+	struct nanvix_histogram_summary *summary
+)
+{
+	spinlock_lock(&h->lock);
+
+		summary->count = h->count;
+		summary->min   = (h->count > 0) ? h->min : 0;
+		summary->max   = h->max;
+		summary->mean  = (h->count > 0) ? (h->sum / h->count) : 0;
+		summary->p50   = histogram_percentile(h, 500);
+		summary->p90   = histogram_percentile(h, 900);
+		summary->p99   = histogram_percentile(h, 990);
+		summary->p999  = histogram_percentile(h, 999);
+
+	spinlock_unlock(&h->lock);
+}
+
+/*============================================================================*
+ * nanvix_histogram_reset()                                                   *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_histogram_reset() function discards all samples
+ * of the histogram @p h.
+ */
+PUBLIC void nanvix_histogram_reset(struct nanvix_histogram *h)
+{
+	spinlock_lock(&h->lock);
+		do_histogram_reset(h);
+	spinlock_unlock(&h->lock);
+}
+
+/*============================================================================*
+ * nanvix_histogram_post()                                                    *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_histogram_post() function stores in @p t0 the
+ * clock value at which an asynchronous operation is posted. A
+ * reposted operation is stamped again.
+ */
+PUBLIC void nanvix_histogram_post(uint64_t *t0)
+{
+	kclock(t0);
+}
+
+/*============================================================================*
+ * nanvix_histogram_complete()                                                *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_histogram_complete() function accounts in the
+ * histogram @p h the time elapsed since the stamp @p t0, and clears
+ * the stamp.
+ */
+PUBLIC void nanvix_histogram_complete(struct nanvix_histogram *h, uint64_t *t0)
+{
+	uint64_t t1;
+
+	/* Nothing was posted. */
+	if (*t0 == 0)
+		return;
+
+	kclock(&t1);
+	nanvix_histogram_record(h, t1 - *t0);
+
+	*t0 = 0;
+}
@@ -0,0 +1,81 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/sys/latency.h>
+
+#if (__NANVIX_IKC_LATENCY_ENABLED)
+
+#include <nanvix/sys/perf.h>
+#include <posix/stdint.h>
+
+/*============================================================================*
+ * nanvix_latency_inject()                                                    *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_latency_inject() function busy-waits for the
+ * fixed IKC latency plus the per-KB latency of @p size bytes. The
+ * clock is used instead of a loop count, so that the delay does not
+ * depend on the speed of the host.
+ */
+PUBLIC void nanvix_latency_inject(size_t size)
+{
+	uint64_t t0;
+	uint64_t t1;
+	uint64_t delay;
+
+	delay = (uint64_t) __NANVIX_IKC_LATENCY +
+		((uint64_t) __NANVIX_IKC_LATENCY_PER_KB*size)/KB;
+
+	kclock(&t0);
+
+	do
+		kclock(&t1);
+	while ((t1 - t0) < delay);
+}
+
+/*============================================================================*
+ * nanvix_latency_deliver()                                                   *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_latency_deliver() function injects the latency of
+ * the receive in @p posted if the wait that completed it returned zero.
+ * A positive return value means that the message was for another port,
+ * and it is read again with a new receive.
+ */
+PUBLIC void nanvix_latency_deliver(ssize_t * posted, int ret)
+{
+	ssize_t size;
+
+	size    = *posted;
+	*posted = NANVIX_LATENCY_IDLE;
+
+	if ((size != NANVIX_LATENCY_IDLE) && (ret == 0))
+		nanvix_latency_inject((size_t) size);
+}
+
+#else
+extern int make_iso_compilers_happy;
+#endif /* __NANVIX_IKC_LATENCY_ENABLED */
@@ -66,25 +66,6 @@ PUBLIC uint64_t nanvix_perf_read(int perf)
 	return (perf_read(perf));
 }
 
-/**
- * @todo TODO provide a detailed description for this function.
- */
-PUBLIC uint64_t kclock(uint64_t *buffer)
-{
-	int ret;
-
-	/* Invalid buffer. */
-	if (buffer == NULL)
-		return (-EINVAL);
-
-	ret = kcall1(
-		NR_clock,
-		(word_t) buffer
-	);
-
-	return (ret);
-}
-
 /**
  * @todo TODO provide a detailed description for this function.
  */
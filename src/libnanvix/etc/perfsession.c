@@ -0,0 +1,416 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/runtime/perfsession.h>
+
+#if (CORE_HAS_PERF)
+
+#include <nanvix/sys/dev.h>
+#include <posix/errno.h>
+
+/**
+ * @brief Length of a printed result line.
+ */
+#define PERF_SESSION_LINE_SIZE 128
+
+/*============================================================================*
+ * Helpers                                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Gets the samples of the calling thread.
+ *
+ * @param session Target session.
+ *
+ * @returns The samples of the calling thread in @p session, or NULL if
+ * the calling thread has no slot.
+ */
+PRIVATE struct nanvix_perf_samples *perf_session_samples(struct nanvix_perf_session *session)
+{
+	int slot;
+
+	/* Unknown thread. */
+	if ((slot = nanvix_tls_slot(kthread_self())) < 0)
+		return (NULL);
+
+	return (&session->threads[slot]);
+}
+
+/**
+ * @brief Extrapolates a sampled value to all runs.
+ *
+ * @param value    Accumulated value.
+ * @param nsamples Number of runs that sampled the value.
+ * @param nruns    Number of runs.
+ *
+ * @returns The extrapolated value.
+ */
+PRIVATE uint64_t perf_session_estimate(uint64_t value, uint64_t nsamples, uint64_t nruns)
+{
+	if (nsamples == 0)
+		return (0);
+
+	/* Avoid overflowing value * nruns. */
+	return ((value / nsamples) * nruns + ((value % nsamples) * nruns) / nsamples);
+}
+
+/**
+ * @brief Appends a string to a line.
+ *
+ * @param line Target line.
+ * @param len  Current length of @p line.
+ * @param str  String to append.
+ *
+ * @returns The new length of @p line.
+ */
+PRIVATE int perf_session_puts(char *line, int len, const char *str)
+{
+	while ((*str != '\0') && (len < (PERF_SESSION_LINE_SIZE - 1)))
+		line[len++] = *str++;
+
+	return (len);
+}
+
+/**
+ * @brief Appends an unsigned number to a line.
+ *
+ * @param line Target line.
+ * @param len  Current length of @p line.
+ * @param num  Number to append.
+ *
+ * @returns The new length of @p line.
+ */
+PRIVATE int perf_session_putu(char *line, int len, uint64_t num)
+{
+	int n;
+	char digits[21];
+
+	n = 0;
+	do
+	{
+		digits[n++] = '0' + (num % 10);
+		num /= 10;
+	} while (num > 0);
+
+	while ((n > 0) && (len < (PERF_SESSION_LINE_SIZE - 1)))
+		line[len++] = digits[--n];
+
+	return (len);
+}
+
+/*============================================================================*
+ * nanvix_perf_session_init()                                                 *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_perf_session_init() function initializes the
+ * session @p session to watch the @p nevents events listed in @p
+ * events. Events that cannot be monitored in the underlying core are
+ * rejected.
+ */
+PUBLIC int nanvix_perf_session_init(
+	struct nanvix_perf_session *session,
+	const int *events,
+	int nevents
+)
+{
+	/* Invalid session. */
+	if (session == NULL)
+		return (-EINVAL);
+
+	/* Invalid events. */
+	if (events == NULL)
+		return (-EINVAL);
+
+	/* Invalid number of events. */
+	if (!WITHIN(nevents, 1, NANVIX_PERF_SESSION_EVENTS_MAX + 1))
+		return (-EINVAL);
+
+	for (int i = 0; i < nevents; i++)
+	{
+		/* Unsupported event. */
+		if (nanvix_perf_query(events[i]) <= 0)
+			return (-ENOTSUP);
+
+		session->events[i] = events[i];
+	}
+
+	session->nevents = nevents;
+	session->ngroups = (nevents + NANVIX_PERF_SESSION_MONITORS - 1)
+		/ NANVIX_PERF_SESSION_MONITORS;
+	spinlock_init(&session->lock);
+
+	return (nanvix_perf_session_reset(session));
+}
+
+/*============================================================================*
+ * nanvix_perf_session_start()                                                *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_perf_session_start() function starts a run of
+ * the session @p session in the calling thread. The run watches the
+ * next group of events of the calling thread.
+ */
+PUBLIC int nanvix_perf_session_start(struct nanvix_perf_session *session)
+{
+	int ret;
+	int first;
+	int nmonitors;
+	struct nanvix_perf_samples *samples;
+
+	/* Invalid session. */
+	if (session == NULL)
+		return (-EINVAL);
+
+	/* Unknown thread. */
+	if ((samples = perf_session_samples(session)) == NULL)
+		return (-ESRCH);
+
+	/* Run already in progress. */
+	if (samples->running)
+		return (-EBUSY);
+
+	first     = samples->group * NANVIX_PERF_SESSION_MONITORS;
+	nmonitors = session->nevents - first;
+	if (nmonitors > NANVIX_PERF_SESSION_MONITORS)
+		nmonitors = NANVIX_PERF_SESSION_MONITORS;
+
+	for (int i = 0; i < nmonitors; i++)
+	{
+		if ((ret = nanvix_perf_start(i, session->events[first + i])) < 0)
+		{
+			/* Rollback. */
+			while (i-- > 0)
+				nanvix_perf_stop(i);
+
+			return (ret);
+		}
+	}
+
+	samples->running = true;
+
+	return (0);
+}
+
+/*============================================================================*
+ * nanvix_perf_session_stop()                                                 *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_perf_session_stop() function stops the run of
+ * the session @p session in the calling thread and accumulates the
+ * values of the watched events in the samples of the calling thread.
+ */
+PUBLIC int nanvix_perf_session_stop(struct nanvix_perf_session *session)
+{
+	int ret;
+	int first;
+	int nmonitors;
+	struct nanvix_perf_samples *samples;
+
+	/* Invalid session. */
+	if (session == NULL)
+		return (-EINVAL);
+
+	/* Unknown thread. */
+	if ((samples = perf_session_samples(session)) == NULL)
+		return (-ESRCH);
+
+	/* No run in progress. */
+	if (!samples->running)
+		return (-EINVAL);
+
+	ret       = 0;
+	first     = samples->group * NANVIX_PERF_SESSION_MONITORS;
+	nmonitors = session->nevents - first;
+	if (nmonitors > NANVIX_PERF_SESSION_MONITORS)
+		nmonitors = NANVIX_PERF_SESSION_MONITORS;
+
+	/* Stop monitors before reading to keep the window tight. */
+	for (int i = 0; i < nmonitors; i++)
+	{
+		int err = nanvix_perf_stop(i);
+		ret = (err < 0) ? err : ret;
+	}
+
+	spinlock_lock(&session->lock);
+
+		for (int i = 0; i < nmonitors; i++)
+		{
+			samples->values[first + i] += nanvix_perf_read(i);
+			samples->nsamples[first + i]++;
+		}
+
+		samples->nruns++;
+		samples->group   = (samples->group + 1) % session->ngroups;
+		samples->running = false;
+
+	spinlock_unlock(&session->lock);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * nanvix_perf_session_results()                                              *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_perf_session_results() function stores in @p
+ * results the results of the session @p session. If @p thread is
+ * NANVIX_PERF_SESSION_ALL, the samples of all threads are aggregated.
+ */
+PUBLIC int nanvix_perf_session_results(
+	struct nanvix_perf_session *session,
+	int thread,
+	struct nanvix_perf_result *results
+)
+{
+	int first;
+	int last;
+
+	/* Invalid session. */
+	if (session == NULL)
+		return (-EINVAL);
+
+	/* Invalid store location. */
+	if (results == NULL)
+		return (-EINVAL);
+
+	/* Invalid thread. */
+	if ((thread != NANVIX_PERF_SESSION_ALL) && !WITHIN(thread, 0, NANVIX_PERF_SESSION_THREADS))
+		return (-EINVAL);
+
+	first = (thread == NANVIX_PERF_SESSION_ALL) ? 0 : thread;
+	last  = (thread == NANVIX_PERF_SESSION_ALL) ? NANVIX_PERF_SESSION_THREADS : thread + 1;
+
+	spinlock_lock(&session->lock);
+
+		for (int i = 0; i < session->nevents; i++)
+		{
+			results[i].event    = session->events[i];
+			results[i].nruns    = 0;
+			results[i].nsamples = 0;
+			results[i].value    = 0;
+
+			for (int j = first; j < last; j++)
+			{
+				results[i].nruns    += session->threads[j].nruns;
+				results[i].nsamples += session->threads[j].nsamples[i];
+				results[i].value    += session->threads[j].values[i];
+			}
+
+			results[i].estimate = perf_session_estimate(
+				results[i].value,
+				results[i].nsamples,
+				results[i].nruns
+			);
+		}
+
+	spinlock_unlock(&session->lock);
+
+	return (session->nevents);
+}
+
+/*============================================================================*
+ * nanvix_perf_session_print()                                                *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_perf_session_print() function writes the results
+ * of the session @p session to the standard output device, one line
+ * per event.
+ */
+PUBLIC int nanvix_perf_session_print(struct nanvix_perf_session *session, int thread)
+{
+	int ret;
+	int len;
+	char line[PERF_SESSION_LINE_SIZE];
+	struct nanvix_perf_result results[NANVIX_PERF_SESSION_EVENTS_MAX];
+
+	if ((ret = nanvix_perf_session_results(session, thread, results)) < 0)
+		return (ret);
+
+	for (int i = 0; i < ret; i++)
+	{
+		len = perf_session_puts(line, 0, "[perf] thread=");
+		len = (thread == NANVIX_PERF_SESSION_ALL) ?
+			perf_session_puts(line, len, "all") :
+			perf_session_putu(line, len, thread);
+		len = perf_session_puts(line, len, " event=");
+		len = perf_session_putu(line, len, results[i].event);
+		len = perf_session_puts(line, len, " runs=");
+		len = perf_session_putu(line, len, results[i].nruns);
+		len = perf_session_puts(line, len, " samples=");
+		len = perf_session_putu(line, len, results[i].nsamples);
+		len = perf_session_puts(line, len, " value=");
+		len = perf_session_putu(line, len, results[i].value);
+		len = perf_session_puts(line, len, " estimate=");
+		len = perf_session_putu(line, len, results[i].estimate);
+		line[len++] = '\n';
+
+		if (nanvix_write(0, line, len) < 0)
+			return (-EIO);
+	}
+
+	return (0);
+}
+
+/*============================================================================*
+ * nanvix_perf_session_reset()                                                *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_perf_session_reset() function discards all
+ * samples collected so far in the session @p session.
+ */
+PUBLIC int nanvix_perf_session_reset(struct nanvix_perf_session *session)
+{
+	/* Invalid session. */
+	if (session == NULL)
+		return (-EINVAL);
+
+	spinlock_lock(&session->lock);
+
+		for (int i = 0; i < NANVIX_PERF_SESSION_THREADS; i++)
+		{
+			session->threads[i].running = false;
+			session->threads[i].group   = 0;
+			session->threads[i].nruns   = 0;
+
+			for (int j = 0; j < NANVIX_PERF_SESSION_EVENTS_MAX; j++)
+			{
+				session->threads[i].nsamples[j] = 0;
+				session->threads[i].values[j]   = 0;
+			}
+		}
+
+	spinlock_unlock(&session->lock);
+
+	return (0);
+}
+
+#else
+extern int make_iso_compilers_happy;
+#endif /* CORE_HAS_PERF */
@@ -0,0 +1,301 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/sys/trace.h>
+
+#if (__NANVIX_IKC_TRACE)
+
+#include <nanvix/sys/dev.h>
+#include <nanvix/sys/noc.h>
+#include <nanvix/sys/perf.h>
+#include <nanvix/sys/thread.h>
+#include <nanvix/sys/tls.h>
+#include <posix/errno.h>
+
+/**
+ * @brief Number of dump bytes printed per line.
+ */
+#define TRACE_BYTES_PER_LINE 32
+
+/**
+ * @brief Length of a printed line.
+ */
+#define TRACE_LINE_SIZE (32 + 2*TRACE_BYTES_PER_LINE)
+
+/**
+ * @brief Per-thread ring of events.
+ *
+ * Each ring has a single writer, the owner thread, so no locking is
+ * needed to emit an event. When the ring is full, the oldest events
+ * are overwritten.
+ */
+PRIVATE struct trace_ring
+{
+	volatile uint32_t head;                                    /**< Number of emitted events. */
+	struct nanvix_trace_event events[NANVIX_TRACE_BUFFER_SIZE]; /**< Events.                   */
+} trace_rings[NANVIX_TLS_THREADS];
+
+/*============================================================================*
+ * Helpers                                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Gets the number of events kept in a ring.
+ *
+ * @param head Number of emitted events in the ring.
+ *
+ * @returns The number of events kept in the ring.
+ */
+PRIVATE uint32_t trace_nevents(uint32_t head)
+{
+	return ((head < NANVIX_TRACE_BUFFER_SIZE) ? head : NANVIX_TRACE_BUFFER_SIZE);
+}
+
+/**
+ * @brief Appends a string to a line.
+ *
+ * @param line Target line.
+ * @param len  Current length of @p line.
+ * @param str  String to append.
+ *
+ * @returns The new length of @p line.
+ */
+PRIVATE int trace_puts(char *line, int len, const char *str)
+{
+	while ((*str != '\0') && (len < TRACE_LINE_SIZE))
+		line[len++] = *str++;
+
+	return (len);
+}
+
+/**
+ * @brief Appends an unsigned number to a line.
+ *
+ * @param line Target line.
+ * @param len  Current length of @p line.
+ * @param num  Number to append.
+ *
+ * @returns The new length of @p line.
+ */
+PRIVATE int trace_putu(char *line, int len, uint32_t num)
+{
+	int n;
+	char digits[11];
+
+	n = 0;
+	do
+	{
+		digits[n++] = '0' + (num % 10);
+		num /= 10;
+	} while (num > 0);
+
+	while ((n > 0) && (len < TRACE_LINE_SIZE))
+		line[len++] = digits[--n];
+
+	return (len);
+}
+
+/*============================================================================*
+ * nanvix_trace_emit()                                                        *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_trace_emit() function records an event of type
+ * @p type and phase @p phase on the communicator @p id in the ring of
+ * the calling thread.
+ */
+PUBLIC void nanvix_trace_emit(int type, int phase, int id, uint32_t arg)
+{
+	int slot;
+	uint64_t now;
+	uint32_t head;
+	struct trace_ring *ring;
+	struct nanvix_trace_event *event;
+
+	/* Unknown thread. */
+	if ((slot = nanvix_tls_slot(kthread_self())) < 0)
+		return;
+
+	kclock(&now);
+
+	ring  = &trace_rings[slot];
+	head  = ring->head;
+	event = &ring->events[head % NANVIX_TRACE_BUFFER_SIZE];
+
+	event->timestamp = now;
+	event->arg       = arg;
+	event->id        = (int16_t) id;
+	event->type      = (uint8_t) type;
+	event->phase     = (uint8_t) phase;
+
+	/* Publish the event. */
+	ring->head = head + 1;
+}
+
+/*============================================================================*
+ * nanvix_trace_dump()                                                        *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_trace_dump() function writes to @p buffer a
+ * header, followed by the events of each thread that has any, oldest
+ * first. If @p buffer is NULL, the size of the dump is returned and
+ * nothing is written.
+ */
+PUBLIC ssize_t nanvix_trace_dump(void *buffer, size_t size)
+{
+	char *p;
+	size_t len;
+	uint32_t nthreads;
+	uint32_t heads[NANVIX_TLS_THREADS];
+	struct nanvix_trace_header header;
+
+	/* Snapshot heads to have a consistent size. */
+	len      = sizeof(struct nanvix_trace_header);
+	nthreads = 0;
+	for (int i = 0; i < NANVIX_TLS_THREADS; i++)
+	{
+		heads[i] = trace_rings[i].head;
+
+		if (heads[i] == 0)
+			continue;
+
+		nthreads++;
+		len += sizeof(struct nanvix_trace_thread) +
+			trace_nevents(heads[i])*sizeof(struct nanvix_trace_event);
+	}
+
+	/* Query size. */
+	if (buffer == NULL)
+		return ((ssize_t) len);
+
+	/* Buffer too small. */
+	if (size < len)
+		return (-ENOMEM);
+
+	header.magic    = NANVIX_TRACE_MAGIC;
+	header.version  = NANVIX_TRACE_VERSION;
+	header.node     = (uint16_t) knode_get_num();
+	header.nthreads = nthreads;
+	header.freq     = CLUSTER_FREQ;
+
+	p = buffer;
+	kmemcpy(p, &header, sizeof(struct nanvix_trace_header));
+	p += sizeof(struct nanvix_trace_header);
+
+	for (int i = 0; i < NANVIX_TLS_THREADS; i++)
+	{
+		uint32_t first;
+		struct nanvix_trace_thread thread;
+
+		if (heads[i] == 0)
+			continue;
+
+		thread.thread  = i;
+		thread.nevents = trace_nevents(heads[i]);
+		first          = heads[i] - thread.nevents;
+
+		kmemcpy(p, &thread, sizeof(struct nanvix_trace_thread));
+		p += sizeof(struct nanvix_trace_thread);
+
+		for (uint32_t j = first; j < heads[i]; j++)
+		{
+			kmemcpy(p,
+				&trace_rings[i].events[j % NANVIX_TRACE_BUFFER_SIZE],
+				sizeof(struct nanvix_trace_event)
+			);
+			p += sizeof(struct nanvix_trace_event);
+		}
+	}
+
+	return ((ssize_t) len);
+}
+
+/*============================================================================*
+ * nanvix_trace_print()                                                       *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_trace_print() function writes the binary dump
+ * of all traced events to the standard output device, encoded in
+ * hexadecimal lines. Events emitted while printing are not included.
+ */
+PUBLIC int nanvix_trace_print(void)
+{
+	int len;
+	int prefix;
+	ssize_t size;
+	char line[TRACE_LINE_SIZE + 1];
+	const char *hex = "0123456789abcdef";
+	static char dump[
+		sizeof(struct nanvix_trace_header) + NANVIX_TLS_THREADS*(
+			sizeof(struct nanvix_trace_thread) +
+			NANVIX_TRACE_BUFFER_SIZE*sizeof(struct nanvix_trace_event)
+		)
+	];
+
+	if ((size = nanvix_trace_dump(dump, sizeof(dump))) < 0)
+		return ((int) size);
+
+	prefix = trace_puts(line, 0, "[trace] ");
+	prefix = trace_putu(line, prefix, knode_get_num());
+	prefix = trace_puts(line, prefix, " ");
+
+	for (ssize_t i = 0; i < size; i += TRACE_BYTES_PER_LINE)
+	{
+		len = prefix;
+
+		for (ssize_t j = i; (j < size) && (j < (i + TRACE_BYTES_PER_LINE)); j++)
+		{
+			line[len++] = hex[(dump[j] >> 4) & 0xf];
+			line[len++] = hex[dump[j] & 0xf];
+		}
+
+		line[len++] = '\n';
+
+		if (nanvix_write(0, line, len) < 0)
+			return (-EIO);
+	}
+
+	return (0);
+}
+
+/*============================================================================*
+ * nanvix_trace_reset()                                                       *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_trace_reset() function discards the events of
+ * all threads. It should not be called while other threads are
+ * emitting events.
+ */
+PUBLIC void nanvix_trace_reset(void)
+{
+	for (int i = 0; i < NANVIX_TLS_THREADS; i++)
+		trace_rings[i].head = 0;
+}
+
+#else
+extern int make_iso_compilers_happy;
+#endif /* __NANVIX_IKC_TRACE */
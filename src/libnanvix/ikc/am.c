@@ -0,0 +1,626 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <nanvix/runtime/am.h>
+
+#if __TARGET_HAS_MAILBOX
+
+#include <nanvix/runtime/stdikc.h>
+#include <nanvix/sys/backoff.h>
+#include <nanvix/sys/noc.h>
+#include <nanvix/sys/thread.h>
+#include <posix/errno.h>
+#include <posix/stdbool.h>
+
+/**
+ * @name Message types.
+ */
+/**@{*/
+#define AM_REQUEST  0 /**< Runs a handler.             */
+#define AM_CALL     1 /**< Runs a handler and replies. */
+#define AM_RESPONSE 2 /**< Reply of a handler.         */
+#define AM_STOP     3 /**< Stops the handler thread.   */
+/**@}*/
+
+/**
+ * @name States of the handler thread.
+ */
+/**@{*/
+#define AM_THREAD_STOPPED  0 /**< Not running.   */
+#define AM_THREAD_STARTING 1 /**< Being spawned. */
+#define AM_THREAD_RUNNING  2 /**< Running.       */
+#define AM_THREAD_STOPPING 3 /**< Being joined.  */
+/**@}*/
+
+/**
+ * @brief Active message.
+ */
+struct am_message
+{
+	uint8_t type;                 /**< Type.                     */
+	uint8_t handler;              /**< ID of the handler.        */
+	uint8_t source;               /**< Source node.              */
+	uint8_t port;                 /**< Port of the source inbox. */
+	uint16_t size;                /**< Size of the payload.      */
+	int16_t status;               /**< Status of a response.     */
+	uint32_t seq;                 /**< Correlation of calls.     */
+	char payload[AM_PAYLOAD_MAX]; /**< Payload.                  */
+};
+
+/**
+ * @brief Size of an active message.
+ */
+#define AM_MESSAGE_SIZE KMAILBOX_MESSAGE_SIZE
+
+/**
+ * @brief Registered handlers.
+ */
+PRIVATE am_handler_t am_handlers[AM_HANDLER_MAX];
+
+/**
+ * @brief Output mailboxes, opened on first use.
+ */
+PRIVATE int am_outboxes[PROCESSOR_NOC_NODES_NUM][KMAILBOX_PORT_NR] = {
+	[0 ... (PROCESSOR_NOC_NODES_NUM - 1)] = {
+		[0 ... (KMAILBOX_PORT_NR - 1)] = -1
+	}
+};
+
+/**
+ * @brief Sequence numbers of calls, per standard input port.
+ *
+ * Only the owner of a port issues calls from it, so no lock is
+ * needed.
+ */
+PRIVATE uint32_t am_seqs[KMAILBOX_PORT_NR];
+
+/**
+ * @name Handler thread.
+ */
+/**@{*/
+PRIVATE kthread_t am_thread_tid;                        /**< Thread ID.         */
+PRIVATE volatile int am_thread_port = -1;                /**< Port of its inbox. */
+PRIVATE int am_thread_state         = AM_THREAD_STOPPED; /**< State.             */
+/**@}*/
+
+/**
+ * @brief Protection of handlers, output mailboxes and the state of the
+ * handler thread.
+ */
+PRIVATE spinlock_t am_lock = SPINLOCK_UNLOCKED;
+
+/*============================================================================*
+ * Helpers                                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Gets an output mailbox, opening it on first use.
+ *
+ * @param remote Target node.
+ * @param port   Target port.
+ *
+ * @returns Upon successful completion, the ID of the output mailbox is
+ * returned. Upon failure, a negative error code is returned instead.
+ */
+PRIVATE int am_outbox(int remote, int port)
+{
+	int mbxid;
+	int other;
+
+	spinlock_lock(&am_lock);
+		mbxid = am_outboxes[remote][port];
+	spinlock_unlock(&am_lock);
+
+	if (mbxid >= 0)
+		return (mbxid);
+
+	/* Opened unlocked, as it may block. */
+	if ((mbxid = kmailbox_open(remote, port)) < 0)
+		return (mbxid);
+
+	spinlock_lock(&am_lock);
+		if ((other = am_outboxes[remote][port]) < 0)
+			am_outboxes[remote][port] = mbxid;
+	spinlock_unlock(&am_lock);
+
+	/* Opened by someone else meanwhile. */
+	if (other >= 0)
+	{
+		kmailbox_close(mbxid);
+		mbxid = other;
+	}
+
+	return (mbxid);
+}
+
+/**
+ * @brief Sends an active message.
+ *
+ * @param remote Target node.
+ * @param port   Target port.
+ * @param msg    Message to send.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+PRIVATE int am_post(int remote, int port, struct am_message * msg)
+{
+	int ret;
+	int mbxid;
+
+	if ((mbxid = am_outbox(remote, port)) < 0)
+		return (mbxid);
+
+	msg->source = (uint8_t) knode_get_num();
+
+	if ((ret = kmailbox_write(mbxid, msg, AM_MESSAGE_SIZE)) < 0)
+		return (ret);
+
+	return (0);
+}
+
+/**
+ * @brief Runs the handler of a message, replying to calls.
+ *
+ * @param msg Target message.
+ *
+ * @returns True if the message asks to stop the handler thread, and
+ * false otherwise.
+ */
+PRIVATE bool am_dispatch(struct am_message * msg)
+{
+	ssize_t ret;
+	am_handler_t fn;
+	struct am_message reply;
+
+	switch (msg->type)
+	{
+		case AM_REQUEST:
+		case AM_CALL:
+			break;
+
+		case AM_STOP:
+			return (true);
+
+		/* Stale response. */
+		default:
+			return (false);
+	}
+
+	spinlock_lock(&am_lock);
+		fn = (msg->handler < AM_HANDLER_MAX) ? am_handlers[msg->handler] : NULL;
+	spinlock_unlock(&am_lock);
+
+	ret = (fn == NULL) ?
+		-ENOTSUP : fn(msg->source, msg->payload, msg->size, reply.payload);
+
+	if (msg->type == AM_CALL)
+	{
+		/* Oversized reply. */
+		if (ret > (ssize_t) AM_PAYLOAD_MAX)
+			ret = -EINVAL;
+
+		reply.type    = AM_RESPONSE;
+		reply.handler = msg->handler;
+		reply.port    = msg->port;
+		reply.size    = (ret < 0) ? 0 : (uint16_t) ret;
+		reply.status  = (ret < 0) ? (int16_t) ret : 0;
+		reply.seq     = msg->seq;
+
+		am_post(msg->source, msg->port, &reply);
+	}
+
+	return (false);
+}
+
+/**
+ * @brief Checks the arguments of an outgoing message.
+ *
+ * @param remote  Target node.
+ * @param port    Target port.
+ * @param handler ID of the handler.
+ * @param payload Payload.
+ * @param size    Size of @p payload.
+ *
+ * @returns Non-zero if the arguments are valid, and zero otherwise.
+ */
+PRIVATE int am_valid(int remote, int port, int handler, const void * payload, size_t size)
+{
+	return (
+		WITHIN(remote, 0, PROCESSOR_NOC_NODES_NUM) &&
+		WITHIN(port, 0, KMAILBOX_PORT_NR)          &&
+		WITHIN(handler, 0, AM_HANDLER_MAX)         &&
+		(size <= AM_PAYLOAD_MAX)                   &&
+		((payload != NULL) || (size == 0))
+	);
+}
+
+/*============================================================================*
+ * am_register()                                                              *
+ *============================================================================*/
+
+/**
+ * @details The am_register() function registers @p fn as the handler
+ * @p handler in the local node.
+ */
+PUBLIC int am_register(int handler, am_handler_t fn)
+{
+	int ret;
+
+	/* Invalid handler. */
+	if (!WITHIN(handler, 0, AM_HANDLER_MAX) || (fn == NULL))
+		return (-EINVAL);
+
+	ret = 0;
+
+	spinlock_lock(&am_lock);
+
+		/* Handler taken. */
+		if (am_handlers[handler] != NULL)
+			ret = (-EBUSY);
+		else
+			am_handlers[handler] = fn;
+
+	spinlock_unlock(&am_lock);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * am_unregister()                                                            *
+ *============================================================================*/
+
+/**
+ * @details The am_unregister() function unregisters the handler @p
+ * handler in the local node. Messages for it are rejected afterwards.
+ */
+PUBLIC int am_unregister(int handler)
+{
+	int ret;
+
+	/* Invalid handler. */
+	if (!WITHIN(handler, 0, AM_HANDLER_MAX))
+		return (-EINVAL);
+
+	ret = 0;
+
+	spinlock_lock(&am_lock);
+
+		/* Handler not registered. */
+		if (am_handlers[handler] == NULL)
+			ret = (-EBADF);
+		else
+			am_handlers[handler] = NULL;
+
+	spinlock_unlock(&am_lock);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * am_send()                                                                  *
+ *============================================================================*/
+
+/**
+ * @details The am_send() function sends @p size bytes of @p payload to
+ * run the handler @p handler at port @p port of the node @p remote. It
+ * does not wait for the handler to run.
+ */
+PUBLIC int am_send(int remote, int port, int handler, const void * payload, size_t size)
+{
+	struct am_message msg;
+
+	/* Invalid arguments. */
+	if (!am_valid(remote, port, handler, payload, size))
+		return (-EINVAL);
+
+	msg.type    = AM_REQUEST;
+	msg.handler = (uint8_t) handler;
+	msg.port    = 0;
+	msg.size    = (uint16_t) size;
+	msg.status  = 0;
+	msg.seq     = 0;
+
+	if (size > 0)
+		kmemcpy(msg.payload, payload, size);
+
+	return (am_post(remote, port, &msg));
+}
+
+/*============================================================================*
+ * am_call()                                                                  *
+ *============================================================================*/
+
+/**
+ * @details The am_call() function runs the handler @p handler at port
+ * @p port of the node @p remote with @p size bytes of @p payload, and
+ * copies up to @p reply_size bytes of its reply to @p reply.
+ */
+PUBLIC ssize_t am_call(
+	int remote,
+	int port,
+	int handler,
+	const void * payload,
+	size_t size,
+	void * reply,
+	size_t reply_size
+)
+{
+	int ret;
+	int inbox;
+	int myport;
+	uint32_t seq;
+	struct am_message msg;
+
+	/* Invalid arguments. */
+	if (!am_valid(remote, port, handler, payload, size))
+		return (-EINVAL);
+
+	/* Invalid reply buffer. */
+	if ((reply == NULL) && (reply_size > 0))
+		return (-EINVAL);
+
+	if (((myport = stdinbox_get_port()) < 0) || ((inbox = stdinbox_get()) < 0))
+		return (-EAGAIN);
+
+	seq = ++am_seqs[myport];
+
+	msg.type    = AM_CALL;
+	msg.handler = (uint8_t) handler;
+	msg.port    = (uint8_t) myport;
+	msg.size    = (uint16_t) size;
+	msg.status  = 0;
+	msg.seq     = seq;
+
+	if (size > 0)
+		kmemcpy(msg.payload, payload, size);
+
+	if ((ret = am_post(remote, port, &msg)) < 0)
+		return (ret);
+
+	/* Serve other messages until the response arrives. */
+	do
+	{
+		if ((ret = kmailbox_read(inbox, &msg, AM_MESSAGE_SIZE)) < 0)
+			return (ret);
+
+		if (msg.type != AM_RESPONSE)
+			am_dispatch(&msg);
+	} while ((msg.type != AM_RESPONSE) || (msg.seq != seq));
+
+	/* Rejected. */
+	if (msg.status < 0)
+		return (msg.status);
+
+	if (msg.size < reply_size)
+		reply_size = msg.size;
+
+	if (reply_size > 0)
+		kmemcpy(reply, msg.payload, reply_size);
+
+	return (msg.size);
+}
+
+/*============================================================================*
+ * am_progress()                                                              *
+ *============================================================================*/
+
+/**
+ * @details The am_progress() function dispatches the active messages
+ * that are pending in the standard input mailbox of the calling
+ * thread, and returns when none is left.
+ */
+PUBLIC int am_progress(void)
+{
+	int n;
+	int inbox;
+	struct am_message msg;
+
+	if ((inbox = stdinbox_get()) < 0)
+		return (0);
+
+	for (n = 0; kmailbox_tryread(inbox, &msg, AM_MESSAGE_SIZE) == AM_MESSAGE_SIZE; n++)
+		am_dispatch(&msg);
+
+	return (n);
+}
+
+/*============================================================================*
+ * am_thread_start()                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Changes the state of the handler thread.
+ *
+ * @param from Expected state.
+ * @param to   New state.
+ *
+ * @returns True if the handler thread was in @p from, and false
+ * otherwise.
+ */
+PRIVATE bool am_thread_set_state(int from, int to)
+{
+	bool ret;
+
+	spinlock_lock(&am_lock);
+
+		if ((ret = (am_thread_state == from)))
+			am_thread_state = to;
+
+	spinlock_unlock(&am_lock);
+
+	return (ret);
+}
+
+/**
+ * @brief Dispatches active messages until asked to stop.
+ *
+ * @param arg Unused.
+ *
+ * @returns Always NULL.
+ */
+PRIVATE void * am_thread_loop(void * arg)
+{
+	int inbox;
+	struct am_message msg;
+
+	((void) arg);
+
+	if ((inbox = stdinbox_get()) < 0)
+	{
+		am_thread_port = (-EAGAIN);
+		return (NULL);
+	}
+
+	am_thread_port = stdinbox_get_port();
+
+	while (kmailbox_read(inbox, &msg, AM_MESSAGE_SIZE) >= 0)
+	{
+		if (am_dispatch(&msg))
+			break;
+	}
+
+	__stdmailbox_cleanup();
+
+	return (NULL);
+}
+
+/**
+ * @details The am_thread_start() function spawns a thread that runs
+ * the handlers of the active messages sent to its standard input
+ * mailbox.
+ */
+PUBLIC int am_thread_start(void)
+{
+	int port;
+	struct nanvix_backoff backoff;
+
+	/* Already running. */
+	if (!am_thread_set_state(AM_THREAD_STOPPED, AM_THREAD_STARTING))
+		return (-EBUSY);
+
+	am_thread_port = -1;
+
+	if (kthread_create(&am_thread_tid, am_thread_loop, NULL) != 0)
+	{
+		am_thread_set_state(AM_THREAD_STARTING, AM_THREAD_STOPPED);
+		return (-EAGAIN);
+	}
+
+	nanvix_backoff_init(&backoff, NANVIX_BACKOFF_DEFAULT);
+
+	/* Wait for the inbox of the thread. */
+	while ((port = am_thread_port) == -1)
+		nanvix_backoff_wait(&backoff);
+
+	if (port < 0)
+	{
+		kthread_join(am_thread_tid, NULL);
+		am_thread_set_state(AM_THREAD_STARTING, AM_THREAD_STOPPED);
+		return (port);
+	}
+
+	am_thread_set_state(AM_THREAD_STARTING, AM_THREAD_RUNNING);
+
+	return (port);
+}
+
+/*============================================================================*
+ * am_thread_stop()                                                           *
+ *============================================================================*/
+
+/**
+ * @details The am_thread_stop() function asks the handler thread to
+ * stop, and waits for it to exit. Messages sent to it before are
+ * dispatched first.
+ */
+PUBLIC int am_thread_stop(void)
+{
+	int ret;
+	struct am_message msg;
+
+	/* Not running. */
+	if (!am_thread_set_state(AM_THREAD_RUNNING, AM_THREAD_STOPPING))
+		return (-EINVAL);
+
+	msg.type    = AM_STOP;
+	msg.handler = 0;
+	msg.port    = 0;
+	msg.size    = 0;
+	msg.status  = 0;
+	msg.seq     = 0;
+
+	if ((ret = am_post(knode_get_num(), am_thread_port, &msg)) < 0)
+	{
+		am_thread_set_state(AM_THREAD_STOPPING, AM_THREAD_RUNNING);
+		return (ret);
+	}
+
+	kthread_join(am_thread_tid, NULL);
+
+	am_thread_set_state(AM_THREAD_STOPPING, AM_THREAD_STOPPED);
+
+	return (0);
+}
+
+/*============================================================================*
+ * am_cleanup()                                                               *
+ *============================================================================*/
+
+/**
+ * @details The am_cleanup() function closes all output mailboxes that
+ * were opened to send active messages.
+ */
+PUBLIC int am_cleanup(void)
+{
+	int ret;
+	int err;
+
+	ret = 0;
+
+	spinlock_lock(&am_lock);
+
+		for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; i++)
+		{
+			for (int j = 0; j < KMAILBOX_PORT_NR; j++)
+			{
+				if (am_outboxes[i][j] < 0)
+					continue;
+
+				if ((err = kmailbox_close(am_outboxes[i][j])) < 0)
+					ret = err;
+
+				am_outboxes[i][j] = -1;
+			}
+		}
+
+	spinlock_unlock(&am_lock);
+
+	return (ret);
+}
+
+#else
+extern int make_iso_compilers_happy;
+#endif /* __TARGET_HAS_MAILBOX */
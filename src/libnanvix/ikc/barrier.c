@@ -31,6 +31,16 @@
 #include <nanvix/runtime/stdikc.h>
 #include <nanvix/runtime/barrier.h>
 
+/**
+ * @brief Barriers released by the leader in barrier_arrive().
+ *
+ * Indexed by the output sync of the leader, because barriers are
+ * passed by value.
+ */
+PRIVATE bool barrier_released[KSYNC_MAX] = {
+	[0 ... (KSYNC_MAX - 1)] = false
+};
+
 #ifndef __unix64__
 
 /**
@@ -185,6 +195,70 @@ int barrier_wait(barrier_t barrier)
 	return (ret);
 }
 
+/**
+ * The barrier_arrive() function announces that the calling peer has
+ * reached the barrier @p barrier, without waiting for the others. A
+ * follower signals the leader asynchronously. The leader releases the
+ * followers at once if all of them have already arrived, otherwise the
+ * release is left to barrier_wait_arrived().
+ */
+int barrier_arrive(barrier_t barrier)
+{
+	int ret;
+
+	/* Invalid barrier. */
+	if (!BARRIER_IS_VALID(barrier))
+		return (-EINVAL);
+
+	/* Follower. */
+	if (knode_get_num() != barrier.leader)
+		return (ksync_signal_async(barrier.syncs[0]));
+
+	/* Leader. */
+	barrier_released[barrier.syncs[1]] = false;
+
+	/* Not all followers arrived, or cannot tell. */
+	if ((ret = ksync_trywait(barrier.syncs[0])) < 0)
+		return (((ret == -EAGAIN) || (ret == -ENOTSUP)) ? 0 : ret);
+
+	if ((ret = ksync_signal_async(barrier.syncs[1])) < 0)
+		return (ret);
+
+	barrier_released[barrier.syncs[1]] = true;
+
+	return (0);
+}
+
+/**
+ * The barrier_wait_arrived() function causes the calling peer, which
+ * has arrived at the barrier @p barrier, to block until all other
+ * participants have arrived too.
+ */
+int barrier_wait_arrived(barrier_t barrier)
+{
+	int ret;
+
+	/* Invalid barrier. */
+	if (!BARRIER_IS_VALID(barrier))
+		return (-EINVAL);
+
+	/* Follower. */
+	if (knode_get_num() != barrier.leader)
+		return (ksync_wait(barrier.syncs[1]));
+
+	/* Leader. */
+	if (barrier_released[barrier.syncs[1]])
+	{
+		barrier_released[barrier.syncs[1]] = false;
+		return (0);
+	}
+
+	if ((ret = ksync_wait(barrier.syncs[0])) < 0)
+		return (ret);
+
+	return (ksync_signal_async(barrier.syncs[1]));
+}
+
 #else
 extern int make_iso_compilers_happy;
 #endif /* __TARGET_HAS_MAILBOX */
@@ -0,0 +1,1073 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <nanvix/runtime/collective.h>
+
+#if (__TARGET_HAS_PORTAL && __TARGET_HAS_SYNC)
+
+#include <nanvix/sys/noc.h>
+#include <nanvix/runtime/stdikc.h>
+#include <posix/errno.h>
+
+/**
+ * @brief Pseudo-operator that stores received data as is.
+ */
+#define COLLECTIVE_COPY (-1)
+
+/**
+ * @brief Converts a rank relative to a root into an absolute rank.
+ */
+#define COLLECTIVE_RANK(coll, vrank, root) \
+	(((vrank) + (root)) % (coll)->nnodes)
+
+/**
+ * @brief Combines @p n elements of type @p T with the operator @p op.
+ */
+#define COLLECTIVE_REDUCE(T, acc, in, n, op)              \
+{                                                         \
+	T *a = (T *) (acc);                                   \
+	const T *b = (const T *) (in);                        \
+	switch (op)                                           \
+	{                                                     \
+		case NANVIX_COLLECTIVE_SUM:                       \
+			for (size_t i = 0; i < (n); i++)              \
+				a[i] += b[i];                             \
+			break;                                        \
+		case NANVIX_COLLECTIVE_PROD:                      \
+			for (size_t i = 0; i < (n); i++)              \
+				a[i] *= b[i];                             \
+			break;                                        \
+		case NANVIX_COLLECTIVE_MIN:                       \
+			for (size_t i = 0; i < (n); i++)              \
+				a[i] = (b[i] < a[i]) ? b[i] : a[i];       \
+			break;                                        \
+		case NANVIX_COLLECTIVE_MAX:                       \
+			for (size_t i = 0; i < (n); i++)              \
+				a[i] = (b[i] > a[i]) ? b[i] : a[i];       \
+			break;                                        \
+		default:                                          \
+			break;                                        \
+	}                                                     \
+}
+
+/*============================================================================*
+ * Helpers                                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Gets the size of an element type.
+ *
+ * @param type Target type.
+ *
+ * @returns The size of @p type in bytes, or zero if @p type is
+ * invalid.
+ */
+PRIVATE size_t collective_type_size(int type)
+{
+	switch (type)
+	{
+		case NANVIX_COLLECTIVE_INT8:
+		case NANVIX_COLLECTIVE_UINT8:
+			return (sizeof(uint8_t));
+		case NANVIX_COLLECTIVE_INT32:
+		case NANVIX_COLLECTIVE_UINT32:
+			return (sizeof(uint32_t));
+		case NANVIX_COLLECTIVE_INT64:
+		case NANVIX_COLLECTIVE_UINT64:
+			return (sizeof(uint64_t));
+		case NANVIX_COLLECTIVE_FLOAT:
+			return (sizeof(float));
+		case NANVIX_COLLECTIVE_DOUBLE:
+			return (sizeof(double));
+		default:
+			return (0);
+	}
+}
+
+/**
+ * @brief Combines received data into an accumulator.
+ *
+ * @param acc  Accumulator.
+ * @param in   Received data.
+ * @param size Size of @p in in bytes.
+ * @param type Type of the elements.
+ * @param op   Reduction operator.
+ */
+PRIVATE void collective_combine(void *acc, const void *in, size_t size, int type, int op)
+{
+	size_t n = size / collective_type_size(type);
+
+	switch (type)
+	{
+		case NANVIX_COLLECTIVE_INT8:
+			COLLECTIVE_REDUCE(int8_t, acc, in, n, op);
+			break;
+		case NANVIX_COLLECTIVE_UINT8:
+			COLLECTIVE_REDUCE(uint8_t, acc, in, n, op);
+			break;
+		case NANVIX_COLLECTIVE_INT32:
+			COLLECTIVE_REDUCE(int32_t, acc, in, n, op);
+			break;
+		case NANVIX_COLLECTIVE_UINT32:
+			COLLECTIVE_REDUCE(uint32_t, acc, in, n, op);
+			break;
+		case NANVIX_COLLECTIVE_INT64:
+			COLLECTIVE_REDUCE(int64_t, acc, in, n, op);
+			break;
+		case NANVIX_COLLECTIVE_UINT64:
+			COLLECTIVE_REDUCE(uint64_t, acc, in, n, op);
+			break;
+		case NANVIX_COLLECTIVE_FLOAT:
+			COLLECTIVE_REDUCE(float, acc, in, n, op);
+			break;
+		case NANVIX_COLLECTIVE_DOUBLE:
+			COLLECTIVE_REDUCE(double, acc, in, n, op);
+			break;
+		default:
+			break;
+	}
+}
+
+/**
+ * @brief Asserts the arguments of a collective operation.
+ *
+ * @param coll  Target group.
+ * @param type  Type of the elements.
+ * @param op    Reduction operator, or COLLECTIVE_COPY.
+ * @param root  Rank of the root node.
+ *
+ * @returns Non-zero if the arguments are valid and zero otherwise.
+ */
+PRIVATE int collective_valid(struct nanvix_collective *coll, int type, int op, int root)
+{
+	return (
+		(coll != NULL) &&
+		(coll->inportal >= 0) &&
+		(collective_type_size(type) != 0) &&
+		((op == COLLECTIVE_COPY) || WITHIN(op, NANVIX_COLLECTIVE_SUM, NANVIX_COLLECTIVE_MAX + 1)) &&
+		WITHIN(root, 0, coll->nnodes)
+	);
+}
+
+/**
+ * @brief Sends data to a node of a group.
+ *
+ * Data is sent in pieces with kportal_awrite(), so that nodes that
+ * forward it may do so as soon as each piece arrives.
+ *
+ * @param coll Target group.
+ * @param rank Rank of the target node.
+ * @param buf  Data to send.
+ * @param size Size of @p buf in bytes.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int collective_send(
+	struct nanvix_collective *coll,
+	int rank,
+	const void *buf,
+	size_t size
+)
+{
+	int ret;
+	size_t n;
+	int portalid;
+	const char *p;
+
+	p        = buf;
+	portalid = coll->outportals[rank];
+
+	for (size_t i = 0; i < size; i += n)
+	{
+		n = ((size - i) < NANVIX_COLLECTIVE_CHUNK_SIZE) ?
+			(size - i) : NANVIX_COLLECTIVE_CHUNK_SIZE;
+
+		/* Sends a piece of the message. */
+		if ((ret = kportal_awrite(portalid, p + i, n)) < 0)
+			return (ret);
+
+		/* Waits for the asynchronous operation to complete. */
+		if ((ret = kportal_wait(portalid)) < 0)
+			return (ret);
+	}
+
+	return (0);
+}
+
+/**
+ * @brief Receives data from a node of a group.
+ *
+ * If @p op is a reduction operator, each piece is received in the
+ * scratch buffer of the group and combined into @p buf. Otherwise, it
+ * is received in @p buf.
+ *
+ * @param coll Target group.
+ * @param rank Rank of the source node.
+ * @param buf  Store location for data.
+ * @param size Size of @p buf in bytes.
+ * @param type Type of the elements.
+ * @param op   Reduction operator, or COLLECTIVE_COPY.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int collective_recv(
+	struct nanvix_collective *coll,
+	int rank,
+	void *buf,
+	size_t size,
+	int type,
+	int op
+)
+{
+	int ret;
+	size_t n;
+	char *p;
+	void *dest;
+
+	p = buf;
+
+	for (size_t i = 0; i < size; i += n)
+	{
+		n = ((size - i) < NANVIX_COLLECTIVE_CHUNK_SIZE) ?
+			(size - i) : NANVIX_COLLECTIVE_CHUNK_SIZE;
+
+		dest = (op == COLLECTIVE_COPY) ? (void *) (p + i) : (void *) coll->scratch;
+
+		/* Every piece must be allowed. */
+		if ((ret = kportal_allow(coll->inportal, coll->nodes[rank], coll->port)) < 0)
+			return (ret);
+
+		/* Repeat while reading valid messages for another ports. */
+		do
+		{
+			if ((ret = kportal_aread(coll->inportal, dest, n)) < 0)
+				return (ret);
+		} while ((ret = kportal_wait(coll->inportal)) > 0);
+
+		/* Wait failed. */
+		if (ret < 0)
+			return (ret);
+
+		if (op != COLLECTIVE_COPY)
+			collective_combine(p + i, coll->scratch, n, type, op);
+	}
+
+	return (0);
+}
+
+/**
+ * @brief Exchanges data with the neighbors of the local node in a ring.
+ *
+ * The local node sends @p sendbuf to the next node and receives @p
+ * recvbuf from the previous one. Even ranks send first and odd ranks
+ * receive first, so the ring never deadlocks.
+ *
+ * @param coll     Target group.
+ * @param sendbuf  Data to send.
+ * @param sendsize Size of @p sendbuf in bytes.
+ * @param recvbuf  Store location for data.
+ * @param recvsize Size of @p recvbuf in bytes.
+ * @param type     Type of the elements.
+ * @param op       Reduction operator, or COLLECTIVE_COPY.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int collective_exchange(
+	struct nanvix_collective *coll,
+	const void *sendbuf,
+	size_t sendsize,
+	void *recvbuf,
+	size_t recvsize,
+	int type,
+	int op
+)
+{
+	int ret;
+	int next;
+	int prev;
+
+	next = (coll->rank + 1) % coll->nnodes;
+	prev = (coll->rank + coll->nnodes - 1) % coll->nnodes;
+
+	if ((coll->rank % 2) == 0)
+	{
+		if ((ret = collective_send(coll, next, sendbuf, sendsize)) < 0)
+			return (ret);
+
+		return (collective_recv(coll, prev, recvbuf, recvsize, type, op));
+	}
+
+	if ((ret = collective_recv(coll, prev, recvbuf, recvsize, type, op)) < 0)
+		return (ret);
+
+	return (collective_send(coll, next, sendbuf, sendsize));
+}
+
+/**
+ * @brief Gets a block of a vector that is split among all nodes.
+ *
+ * @param coll   Target group.
+ * @param count  Number of elements in the vector.
+ * @param block  Target block.
+ * @param offset Store location for the first element of the block.
+ * @param len    Store location for the number of elements of the block.
+ */
+PRIVATE void collective_block(
+	struct nanvix_collective *coll,
+	size_t count,
+	int block,
+	size_t *offset,
+	size_t *len
+)
+{
+	size_t base  = count / coll->nnodes;
+	size_t extra = count % coll->nnodes;
+	size_t b     = (size_t) block;
+
+	*offset = b*base + ((b < extra) ? b : extra);
+	*len    = base + ((b < extra) ? 1 : 0);
+}
+
+/**
+ * @brief Broadcasts data along a binomial tree.
+ *
+ * @param coll Target group.
+ * @param buf  Data to broadcast.
+ * @param size Size of @p buf in bytes.
+ * @param root Rank of the root node.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int collective_broadcast_tree(
+	struct nanvix_collective *coll,
+	void *buf,
+	size_t size,
+	int root
+)
+{
+	int ret;
+	int mask;
+	int vrank;
+
+	vrank = (coll->rank - root + coll->nnodes) % coll->nnodes;
+
+	/* Receive from parent. */
+	for (mask = 1; mask < coll->nnodes; mask <<= 1)
+	{
+		if (vrank & mask)
+		{
+			ret = collective_recv(coll,
+				COLLECTIVE_RANK(coll, vrank - mask, root),
+				buf, size, 0, COLLECTIVE_COPY
+			);
+
+			if (ret < 0)
+				return (ret);
+
+			break;
+		}
+	}
+
+	/* Send to children. */
+	for (mask >>= 1; mask > 0; mask >>= 1)
+	{
+		if ((vrank + mask) < coll->nnodes)
+		{
+			ret = collective_send(coll,
+				COLLECTIVE_RANK(coll, vrank + mask, root),
+				buf, size
+			);
+
+			if (ret < 0)
+				return (ret);
+		}
+	}
+
+	return (0);
+}
+
+/**
+ * @brief Broadcasts data along a pipelined chain.
+ *
+ * Each node forwards a piece to the next node as soon as it arrives,
+ * so all links of the chain are busy at once.
+ *
+ * @param coll Target group.
+ * @param buf  Data to broadcast.
+ * @param size Size of @p buf in bytes.
+ * @param root Rank of the root node.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int collective_broadcast_ring(
+	struct nanvix_collective *coll,
+	void *buf,
+	size_t size,
+	int root
+)
+{
+	int ret;
+	size_t n;
+	int vrank;
+	char *p;
+
+	p     = buf;
+	vrank = (coll->rank - root + coll->nnodes) % coll->nnodes;
+
+	for (size_t i = 0; i < size; i += n)
+	{
+		n = ((size - i) < NANVIX_COLLECTIVE_CHUNK_SIZE) ?
+			(size - i) : NANVIX_COLLECTIVE_CHUNK_SIZE;
+
+		/* Receive piece from previous node. */
+		if (vrank > 0)
+		{
+			ret = collective_recv(coll,
+				COLLECTIVE_RANK(coll, vrank - 1, root),
+				p + i, n, 0, COLLECTIVE_COPY
+			);
+
+			if (ret < 0)
+				return (ret);
+		}
+
+		/* Forward piece to next node. */
+		if (vrank < (coll->nnodes - 1))
+		{
+			ret = collective_send(coll,
+				COLLECTIVE_RANK(coll, vrank + 1, root),
+				p + i, n
+			);
+
+			if (ret < 0)
+				return (ret);
+		}
+	}
+
+	return (0);
+}
+
+/**
+ * @brief Reduces data along a binomial tree.
+ *
+ * @param coll Target group.
+ * @param buf  Accumulator, initialized with the local data.
+ * @param size Size of @p buf in bytes.
+ * @param type Type of the elements.
+ * @param op   Reduction operator.
+ * @param root Rank of the root node.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int collective_reduce_tree(
+	struct nanvix_collective *coll,
+	void *buf,
+	size_t size,
+	int type,
+	int op,
+	int root
+)
+{
+	int ret;
+	int vrank;
+
+	vrank = (coll->rank - root + coll->nnodes) % coll->nnodes;
+
+	for (int mask = 1; mask < coll->nnodes; mask <<= 1)
+	{
+		/* Send to parent. */
+		if (vrank & mask)
+			return (collective_send(coll, COLLECTIVE_RANK(coll, vrank & ~mask, root), buf, size));
+
+		/* Receive from child. */
+		if ((vrank | mask) < coll->nnodes)
+		{
+			ret = collective_recv(coll,
+				COLLECTIVE_RANK(coll, vrank | mask, root),
+				buf, size, type, op
+			);
+
+			if (ret < 0)
+				return (ret);
+		}
+	}
+
+	return (0);
+}
+
+/**
+ * @brief Reduces data along a pipelined chain.
+ *
+ * Pieces flow from the last node of the chain towards the root, and
+ * each node combines a piece with its own before forwarding it.
+ *
+ * @param coll Target group.
+ * @param buf  Accumulator, initialized with the local data.
+ * @param size Size of @p buf in bytes.
+ * @param type Type of the elements.
+ * @param op   Reduction operator.
+ * @param root Rank of the root node.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int collective_reduce_ring(
+	struct nanvix_collective *coll,
+	void *buf,
+	size_t size,
+	int type,
+	int op,
+	int root
+)
+{
+	int ret;
+	size_t n;
+	int vrank;
+	char *p;
+
+	p     = buf;
+	vrank = (coll->rank - root + coll->nnodes) % coll->nnodes;
+
+	for (size_t i = 0; i < size; i += n)
+	{
+		n = ((size - i) < NANVIX_COLLECTIVE_CHUNK_SIZE) ?
+			(size - i) : NANVIX_COLLECTIVE_CHUNK_SIZE;
+
+		/* Combine piece of next node. */
+		if (vrank < (coll->nnodes - 1))
+		{
+			ret = collective_recv(coll,
+				COLLECTIVE_RANK(coll, vrank + 1, root),
+				p + i, n, type, op
+			);
+
+			if (ret < 0)
+				return (ret);
+		}
+
+		/* Forward piece to previous node. */
+		if (vrank > 0)
+		{
+			ret = collective_send(coll,
+				COLLECTIVE_RANK(coll, vrank - 1, root),
+				p + i, n
+			);
+
+			if (ret < 0)
+				return (ret);
+		}
+	}
+
+	return (0);
+}
+
+/*============================================================================*
+ * nanvix_collective_init()                                                   *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_collective_init() function initializes the group
+ * @p coll with the @p nnodes nodes listed in @p nodes. If @p nodes is
+ * NULL, the group spans all clusters, as listed by build_node_list().
+ * The input portal of the group is hooked up at port @p port.
+ */
+PUBLIC int nanvix_collective_init(
+	struct nanvix_collective *coll,
+	const int *nodes,
+	int nnodes,
+	int port
+)
+{
+	int ret;
+	int local;
+
+	/* Invalid group. */
+	if (coll == NULL)
+		return (-EINVAL);
+
+	coll->inportal = -1;
+
+	/* All clusters. */
+	if (nodes == NULL)
+	{
+		nnodes = PROCESSOR_CLUSTERS_NUM;
+		build_node_list(coll->nodes, PROCESSOR_IOCLUSTERS_NUM, PROCESSOR_CCLUSTERS_NUM);
+	}
+
+	/* Invalid number of nodes. */
+	else if (!WITHIN(nnodes, 1, PROCESSOR_CLUSTERS_NUM + 1))
+		return (-EINVAL);
+
+	else
+	{
+		for (int i = 0; i < nnodes; i++)
+			coll->nodes[i] = nodes[i];
+	}
+
+	local        = knode_get_num();
+	coll->nnodes = nnodes;
+	coll->port   = port;
+	coll->rank   = -1;
+
+	for (int i = 0; i < nnodes; i++)
+	{
+		coll->outportals[i] = -1;
+
+		if (coll->nodes[i] == local)
+			coll->rank = i;
+	}
+
+	/* Local node is not in the group. */
+	if (coll->rank < 0)
+		return (-EINVAL);
+
+	if ((ret = kportal_create(local, port)) < 0)
+		return (ret);
+
+	coll->inportal = ret;
+
+	for (int i = 0; i < nnodes; i++)
+	{
+		if (i == coll->rank)
+			continue;
+
+		if ((ret = kportal_open(local, coll->nodes[i], port)) < 0)
+			goto error;
+
+		coll->outportals[i] = ret;
+	}
+
+	return (0);
+
+error:
+	nanvix_collective_finalize(coll);
+	return (ret);
+}
+
+/*============================================================================*
+ * nanvix_collective_finalize()                                               *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_collective_finalize() function closes the output
+ * portals and unlinks the input portal of the group @p coll.
+ */
+PUBLIC int nanvix_collective_finalize(struct nanvix_collective *coll)
+{
+	int ret;
+
+	/* Invalid group. */
+	if ((coll == NULL) || (coll->inportal < 0))
+		return (-EINVAL);
+
+	ret = 0;
+
+	for (int i = 0; i < coll->nnodes; i++)
+	{
+		if (coll->outportals[i] < 0)
+			continue;
+
+		if (kportal_close(coll->outportals[i]) < 0)
+			ret = (-EAGAIN);
+
+		coll->outportals[i] = -1;
+	}
+
+	if (kportal_unlink(coll->inportal) < 0)
+		ret = (-EAGAIN);
+
+	coll->inportal = -1;
+
+	return (ret);
+}
+
+/*============================================================================*
+ * nanvix_collective_broadcast()                                              *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_collective_broadcast() function broadcasts @p
+ * count elements of type @p type in @p buf from the node @p root to
+ * all nodes of the group @p coll. Small messages go along a binomial
+ * tree, and large ones along a pipelined chain.
+ */
+PUBLIC int nanvix_collective_broadcast(
+	struct nanvix_collective *coll,
+	void *buf,
+	size_t count,
+	int type,
+	int root
+)
+{
+	size_t size;
+
+	/* Invalid arguments. */
+	if (!collective_valid(coll, type, COLLECTIVE_COPY, root))
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if ((buf == NULL) && (count != 0))
+		return (-EINVAL);
+
+	size = count*collective_type_size(type);
+
+	/* Nothing to do. */
+	if ((size == 0) || (coll->nnodes == 1))
+		return (0);
+
+	if (size <= NANVIX_COLLECTIVE_TREE_MAX)
+		return (collective_broadcast_tree(coll, buf, size, root));
+
+	return (collective_broadcast_ring(coll, buf, size, root));
+}
+
+/*============================================================================*
+ * nanvix_collective_scatter()                                                *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_collective_scatter() function sends the i-th
+ * block of @p count elements in @p sendbuf of the node @p root to the
+ * i-th node of the group @p coll. The root sends blocks directly to
+ * each node.
+ */
+PUBLIC int nanvix_collective_scatter(
+	struct nanvix_collective *coll,
+	const void *sendbuf,
+	void *recvbuf,
+	size_t count,
+	int type,
+	int root
+)
+{
+	int ret;
+	size_t size;
+	const char *p;
+
+	/* Invalid arguments. */
+	if (!collective_valid(coll, type, COLLECTIVE_COPY, root))
+		return (-EINVAL);
+
+	/* Invalid buffers. */
+	if ((recvbuf == NULL) || ((coll->rank == root) && (sendbuf == NULL)))
+		return (-EINVAL);
+
+	size = count*collective_type_size(type);
+
+	/* Nothing to do. */
+	if (size == 0)
+		return (0);
+
+	if (coll->rank != root)
+		return (collective_recv(coll, root, recvbuf, size, type, COLLECTIVE_COPY));
+
+	p = sendbuf;
+
+	for (int i = 0; i < coll->nnodes; i++)
+	{
+		if (i == root)
+		{
+			kmemcpy(recvbuf, p + i*size, size);
+			continue;
+		}
+
+		if ((ret = collective_send(coll, i, p + i*size, size)) < 0)
+			return (ret);
+	}
+
+	return (0);
+}
+
+/*============================================================================*
+ * nanvix_collective_gather()                                                 *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_collective_gather() function stores the @p count
+ * elements in @p sendbuf of the i-th node of the group @p coll in the
+ * i-th block of @p recvbuf of the node @p root. Each node sends its
+ * block directly to the root.
+ */
+PUBLIC int nanvix_collective_gather(
+	struct nanvix_collective *coll,
+	const void *sendbuf,
+	void *recvbuf,
+	size_t count,
+	int type,
+	int root
+)
+{
+	int ret;
+	size_t size;
+	char *p;
+
+	/* Invalid arguments. */
+	if (!collective_valid(coll, type, COLLECTIVE_COPY, root))
+		return (-EINVAL);
+
+	/* Invalid buffers. */
+	if ((sendbuf == NULL) || ((coll->rank == root) && (recvbuf == NULL)))
+		return (-EINVAL);
+
+	size = count*collective_type_size(type);
+
+	/* Nothing to do. */
+	if (size == 0)
+		return (0);
+
+	if (coll->rank != root)
+		return (collective_send(coll, root, sendbuf, size));
+
+	p = recvbuf;
+
+	for (int i = 0; i < coll->nnodes; i++)
+	{
+		if (i == root)
+		{
+			kmemcpy(p + i*size, sendbuf, size);
+			continue;
+		}
+
+		if ((ret = collective_recv(coll, i, p + i*size, size, type, COLLECTIVE_COPY)) < 0)
+			return (ret);
+	}
+
+	return (0);
+}
+
+/*============================================================================*
+ * nanvix_collective_allgather()                                              *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_collective_allgather() function stores the @p
+ * count elements in @p sendbuf of the i-th node of the group @p coll
+ * in the i-th block of @p recvbuf of all nodes. Small messages are
+ * gathered and broadcast along a tree, and large ones circulate in a
+ * ring.
+ */
+PUBLIC int nanvix_collective_allgather(
+	struct nanvix_collective *coll,
+	const void *sendbuf,
+	void *recvbuf,
+	size_t count,
+	int type
+)
+{
+	int ret;
+	size_t size;
+	char *p;
+
+	/* Invalid arguments. */
+	if (!collective_valid(coll, type, COLLECTIVE_COPY, 0))
+		return (-EINVAL);
+
+	/* Invalid buffers. */
+	if ((sendbuf == NULL) || (recvbuf == NULL))
+		return (-EINVAL);
+
+	size = count*collective_type_size(type);
+
+	/* Nothing to do. */
+	if (size == 0)
+		return (0);
+
+	if ((size*coll->nnodes) <= NANVIX_COLLECTIVE_TREE_MAX)
+	{
+		if ((ret = nanvix_collective_gather(coll, sendbuf, recvbuf, count, type, 0)) < 0)
+			return (ret);
+
+		return (nanvix_collective_broadcast(coll, recvbuf, count*coll->nnodes, type, 0));
+	}
+
+	p = recvbuf;
+	kmemcpy(p + coll->rank*size, sendbuf, size);
+
+	for (int s = 0; s < (coll->nnodes - 1); s++)
+	{
+		int sendblock = (coll->rank - s + coll->nnodes) % coll->nnodes;
+		int recvblock = (coll->rank - s - 1 + coll->nnodes) % coll->nnodes;
+
+		ret = collective_exchange(coll,
+			p + sendblock*size, size,
+			p + recvblock*size, size,
+			type, COLLECTIVE_COPY
+		);
+
+		if (ret < 0)
+			return (ret);
+	}
+
+	return (0);
+}
+
+/*============================================================================*
+ * nanvix_collective_reduce()                                                 *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_collective_reduce() function combines the @p
+ * count elements in @p sendbuf of all nodes of the group @p coll with
+ * the operator @p op, and stores the result in @p recvbuf of the node
+ * @p root. Small messages are reduced along a binomial tree, and large
+ * ones along a pipelined chain.
+ */
+PUBLIC int nanvix_collective_reduce(
+	struct nanvix_collective *coll,
+	const void *sendbuf,
+	void *recvbuf,
+	size_t count,
+	int type,
+	int op,
+	int root
+)
+{
+	size_t size;
+
+	/* Invalid arguments. */
+	if (!collective_valid(coll, type, op, root) || (op == COLLECTIVE_COPY))
+		return (-EINVAL);
+
+	/* Invalid buffers. */
+	if ((sendbuf == NULL) || (recvbuf == NULL))
+		return (-EINVAL);
+
+	size = count*collective_type_size(type);
+
+	/* Nothing to do. */
+	if (size == 0)
+		return (0);
+
+	if (recvbuf != sendbuf)
+		kmemcpy(recvbuf, sendbuf, size);
+
+	if (coll->nnodes == 1)
+		return (0);
+
+	if (size <= NANVIX_COLLECTIVE_TREE_MAX)
+		return (collective_reduce_tree(coll, recvbuf, size, type, op, root));
+
+	return (collective_reduce_ring(coll, recvbuf, size, type, op, root));
+}
+
+/*============================================================================*
+ * nanvix_collective_allreduce()                                              *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_collective_allreduce() function combines the @p
+ * count elements in @p sendbuf of all nodes of the group @p coll with
+ * the operator @p op, and stores the result in @p recvbuf of all
+ * nodes. Small messages are reduced and broadcast along a binomial
+ * tree. Large messages are reduce-scattered and then allgathered in a
+ * ring, so that each link carries about twice the message size.
+ */
+PUBLIC int nanvix_collective_allreduce(
+	struct nanvix_collective *coll,
+	const void *sendbuf,
+	void *recvbuf,
+	size_t count,
+	int type,
+	int op
+)
+{
+	int ret;
+	size_t tsize;
+	size_t sendoff;
+	size_t sendlen;
+	size_t recvoff;
+	size_t recvlen;
+	char *p;
+
+	/* Invalid arguments. */
+	if (!collective_valid(coll, type, op, 0) || (op == COLLECTIVE_COPY))
+		return (-EINVAL);
+
+	/* Invalid buffers. */
+	if ((sendbuf == NULL) || (recvbuf == NULL))
+		return (-EINVAL);
+
+	tsize = collective_type_size(type);
+
+	/* Nothing to do. */
+	if (count == 0)
+		return (0);
+
+	if ((count*tsize) <= NANVIX_COLLECTIVE_TREE_MAX)
+	{
+		if ((ret = nanvix_collective_reduce(coll, sendbuf, recvbuf, count, type, op, 0)) < 0)
+			return (ret);
+
+		return (nanvix_collective_broadcast(coll, recvbuf, count, type, 0));
+	}
+
+	p = recvbuf;
+	if (recvbuf != sendbuf)
+		kmemcpy(recvbuf, sendbuf, count*tsize);
+
+	/* Reduce-scatter: rank r ends up with block r + 1 reduced. */
+	for (int s = 0; s < (coll->nnodes - 1); s++)
+	{
+		collective_block(coll, count, (coll->rank - s + coll->nnodes) % coll->nnodes, &sendoff, &sendlen);
+		collective_block(coll, count, (coll->rank - s - 1 + coll->nnodes) % coll->nnodes, &recvoff, &recvlen);
+
+		ret = collective_exchange(coll,
+			p + sendoff*tsize, sendlen*tsize,
+			p + recvoff*tsize, recvlen*tsize,
+			type, op
+		);
+
+		if (ret < 0)
+			return (ret);
+	}
+
+	/* Allgather of reduced blocks. */
+	for (int s = 0; s < (coll->nnodes - 1); s++)
+	{
+		collective_block(coll, count, (coll->rank + 1 - s + coll->nnodes) % coll->nnodes, &sendoff, &sendlen);
+		collective_block(coll, count, (coll->rank - s + coll->nnodes) % coll->nnodes, &recvoff, &recvlen);
+
+		ret = collective_exchange(coll,
+			p + sendoff*tsize, sendlen*tsize,
+			p + recvoff*tsize, recvlen*tsize,
+			type, COLLECTIVE_COPY
+		);
+
+		if (ret < 0)
+			return (ret);
+	}
+
+	return (0);
+}
+
+#else
+extern int make_iso_compilers_happy;
+#endif /* __TARGET_HAS_PORTAL && __TARGET_HAS_SYNC */
@@ -0,0 +1,482 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/sys/ikcq.h>
+
+#if __TARGET_HAS_MAILBOX
+
+#include <nanvix/sys/backoff.h>
+#include <nanvix/sys/mailbox.h>
+#include <nanvix/sys/portal.h>
+#include <nanvix/sys/sync.h>
+#include <posix/errno.h>
+
+/**
+ * @brief Asserts whether portals are available.
+ */
+#define IKCQ_HAS_PORTAL (__TARGET_HAS_PORTAL || __NANVIX_IKC_USES_ONLY_MAILBOX)
+
+/**
+ * @brief Asserts whether synchronization points are available.
+ */
+#define IKCQ_HAS_SYNC (__TARGET_HAS_SYNC || __NANVIX_IKC_USES_ONLY_MAILBOX)
+
+/**
+ * @brief Slot of a ring.
+ */
+#define IKCQ_SLOT(x) ((x) & (NANVIX_IKCQ_DEPTH - 1))
+
+/**
+ * @brief Type of communicator of an operation.
+ */
+#define IKCQ_CLASS(opcode) ((opcode) >> 1)
+
+/**
+ * @name States of an operation.
+ */
+/**@{*/
+#define IKCQ_STATE_QUEUED  0 /**< Waiting for the communicator. */
+#define IKCQ_STATE_STARTED 1 /**< Started.                      */
+#define IKCQ_STATE_DONE    2 /**< Completed.                    */
+#define IKCQ_STATE_PARKED  3 /**< Can only complete by waiting. */
+/**@}*/
+
+/*============================================================================*
+ * Helpers                                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Asserts whether an operation waits for an earlier one.
+ *
+ * @param q    Target queue.
+ * @param slot Position of the operation in the submission queue.
+ *
+ * @returns Non-zero if an earlier operation on the same communicator
+ * is not complete, and zero otherwise.
+ */
+PRIVATE int ikcq_is_blocked(struct nanvix_ikcq *q, unsigned slot)
+{
+	struct nanvix_ikcq_sqe *sqe = &q->sq[IKCQ_SLOT(slot)];
+
+	for (unsigned i = q->sq_head; i != slot; i++)
+	{
+		struct nanvix_ikcq_sqe *prev = &q->sq[IKCQ_SLOT(i)];
+
+		if (q->states[IKCQ_SLOT(i)] == IKCQ_STATE_DONE)
+			continue;
+
+		if ((IKCQ_CLASS(prev->opcode) == IKCQ_CLASS(sqe->opcode)) && (prev->id == sqe->id))
+			return (1);
+	}
+
+	return (0);
+}
+
+/**
+ * @brief Starts an operation.
+ *
+ * Writes to mailboxes are posted to the communicator. Other operations
+ * are only marked as started.
+ *
+ * @param sqe Target operation.
+ *
+ * @returns Zero if the operation was started, or a negative error
+ * code that completes it.
+ */
+PRIVATE ssize_t ikcq_start(struct nanvix_ikcq_sqe *sqe)
+{
+	ssize_t ret;
+
+	if (sqe->opcode != NANVIX_IKCQ_MAILBOX_WRITE)
+		return (0);
+
+	return (((ret = kmailbox_awrite(sqe->id, sqe->buffer, sqe->size)) < 0) ? ret : 0);
+}
+
+#if IKCQ_HAS_PORTAL
+
+/**
+ * @brief Writes to a portal the pieces of a message that are allowed.
+ *
+ * @param q    Target queue.
+ * @param slot Position of the operation in the submission queue.
+ *
+ * @returns The size of the message once it is written, or -EAGAIN if
+ * the remote has not allowed the rest yet.
+ */
+PRIVATE ssize_t ikcq_portal_write(struct nanvix_ikcq *q, unsigned slot)
+{
+	ssize_t ret;
+	size_t *offset = &q->offsets[IKCQ_SLOT(slot)];
+	struct nanvix_ikcq_sqe *sqe = &q->sq[IKCQ_SLOT(slot)];
+
+	while (*offset < sqe->size)
+	{
+		if ((ret = kportal_trywrite(sqe->id, (const char *) sqe->buffer + *offset, sqe->size - *offset)) < 0)
+			return (ret);
+
+		*offset += ret;
+	}
+
+	return ((ssize_t) sqe->size);
+}
+
+#endif
+
+/**
+ * @brief Tries to complete a started operation.
+ *
+ * @param q    Target queue.
+ * @param slot Position of the operation in the submission queue.
+ *
+ * @returns The return value of the operation, -EAGAIN if it is not
+ * complete yet, or -ENOTSUP if it can only complete by waiting.
+ */
+PRIVATE ssize_t ikcq_try(struct nanvix_ikcq *q, unsigned slot)
+{
+	struct nanvix_ikcq_sqe *sqe = &q->sq[IKCQ_SLOT(slot)];
+
+	switch (sqe->opcode)
+	{
+		case NANVIX_IKCQ_MAILBOX_READ:
+			return (kmailbox_tryread(sqe->id, sqe->buffer, sqe->size));
+
+		case NANVIX_IKCQ_MAILBOX_WRITE:
+			/* Mailbox writes cannot be probed. */
+			return (-ENOTSUP);
+
+#if IKCQ_HAS_PORTAL
+		case NANVIX_IKCQ_PORTAL_READ:
+			return (kportal_tryread(sqe->id, sqe->buffer, sqe->size));
+
+		case NANVIX_IKCQ_PORTAL_WRITE:
+			return (ikcq_portal_write(q, slot));
+#endif
+
+#if IKCQ_HAS_SYNC
+		case NANVIX_IKCQ_SYNC_WAIT:
+			/* Native syncs cannot be probed. */
+			return (ksync_trywait(sqe->id));
+
+		case NANVIX_IKCQ_SYNC_SIGNAL:
+			/* Native syncs signal synchronously. */
+			return (ksync_signal_async(sqe->id));
+#endif
+
+		default:
+			return (-EINVAL);
+	}
+}
+
+/**
+ * @brief Completes a parked operation by blocking on it.
+ *
+ * @param sqe Target operation.
+ *
+ * @returns The return value of the operation.
+ */
+PRIVATE ssize_t ikcq_wait(struct nanvix_ikcq_sqe *sqe)
+{
+	ssize_t ret;
+
+	switch (sqe->opcode)
+	{
+		case NANVIX_IKCQ_MAILBOX_WRITE:
+			return (((ret = kmailbox_wait(sqe->id)) < 0) ? ret : (ssize_t) sqe->size);
+
+#if IKCQ_HAS_SYNC
+		case NANVIX_IKCQ_SYNC_WAIT:
+			return (ksync_wait(sqe->id));
+#endif
+
+		default:
+			return (-ENOTSUP);
+	}
+}
+
+/**
+ * @brief Asserts whether an operation is parked when it cannot be
+ * probed.
+ *
+ * @param sqe Target operation.
+ *
+ * @returns Non-zero if the operation is parked, and zero otherwise.
+ */
+PRIVATE int ikcq_is_parkable(struct nanvix_ikcq_sqe *sqe)
+{
+	return ((sqe->opcode == NANVIX_IKCQ_MAILBOX_WRITE) || (sqe->opcode == NANVIX_IKCQ_SYNC_WAIT));
+}
+
+/**
+ * @brief Completes an operation.
+ *
+ * @param q    Target queue.
+ * @param slot Position of the operation in the submission queue.
+ * @param ret  Return value of the operation.
+ */
+PRIVATE void ikcq_complete(struct nanvix_ikcq *q, unsigned slot, ssize_t ret)
+{
+	struct nanvix_ikcq_cqe *cqe = &q->cq[IKCQ_SLOT(q->cq_tail++)];
+
+	cqe->tag = q->sq[IKCQ_SLOT(slot)].tag;
+	cqe->ret = ret;
+
+	q->states[IKCQ_SLOT(slot)] = IKCQ_STATE_DONE;
+}
+
+/**
+ * @brief Completes a parked operation by waiting for it.
+ *
+ * This is done only when every operation in flight is parked, so that
+ * waiting cannot hold back an operation that the remote waits for.
+ *
+ * @param q Target queue.
+ *
+ * @returns The number of completed operations.
+ */
+PRIVATE int ikcq_unpark(struct nanvix_ikcq *q)
+{
+	unsigned slot;
+
+	slot = q->sq_tail;
+
+	for (unsigned i = q->sq_head; i != q->sq_tail; i++)
+	{
+		int state = q->states[IKCQ_SLOT(i)];
+
+		if (state == IKCQ_STATE_DONE)
+			continue;
+
+		/* Waits for a parked operation. */
+		if ((state == IKCQ_STATE_QUEUED) && ikcq_is_blocked(q, i))
+			continue;
+
+		/* Something else to progress. */
+		if (state != IKCQ_STATE_PARKED)
+			return (0);
+
+		if (slot == q->sq_tail)
+			slot = i;
+	}
+
+	/* Nothing in flight. */
+	if (slot == q->sq_tail)
+		return (0);
+
+	ikcq_complete(q, slot, ikcq_wait(&q->sq[IKCQ_SLOT(slot)]));
+
+	return (1);
+}
+
+/*============================================================================*
+ * nanvix_ikcq_init()                                                         *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_ikcq_init() function initializes the queue @p q
+ * with no operations.
+ */
+PUBLIC int nanvix_ikcq_init(struct nanvix_ikcq *q)
+{
+	/* Invalid queue. */
+	if (q == NULL)
+		return (-EINVAL);
+
+	q->sq_head = 0;
+	q->sq_tail = 0;
+	q->cq_head = 0;
+	q->cq_tail = 0;
+
+	return (0);
+}
+
+/*============================================================================*
+ * nanvix_ikcq_submit()                                                       *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_ikcq_submit() function appends the @p nsqes
+ * operations in @p sqes to the queue @p q and starts the ones whose
+ * communicators are free. Operations that do not fit in flight or in
+ * the completion queue are not submitted.
+ */
+PUBLIC int nanvix_ikcq_submit(
+	struct nanvix_ikcq *q,
+	const struct nanvix_ikcq_sqe *sqes,
+	int nsqes
+)
+{
+	int n;
+
+	/* Invalid queue. */
+	if (q == NULL)
+		return (-EINVAL);
+
+	/* Invalid operations. */
+	if ((sqes == NULL) || (nsqes < 0))
+		return (-EINVAL);
+
+	for (n = 0; n < nsqes; n++)
+	{
+		/* Invalid operation. */
+		if (!WITHIN(sqes[n].opcode, 0, NANVIX_IKCQ_OPS_NUM))
+			return ((n > 0) ? n : -EINVAL);
+
+		/* Queue is full. */
+		if (((q->sq_tail - q->sq_head) + (q->cq_tail - q->cq_head)) >= NANVIX_IKCQ_DEPTH)
+			break;
+
+		q->sq[IKCQ_SLOT(q->sq_tail)]      = sqes[n];
+		q->states[IKCQ_SLOT(q->sq_tail)]  = IKCQ_STATE_QUEUED;
+		q->offsets[IKCQ_SLOT(q->sq_tail)] = 0;
+		q->sq_tail++;
+	}
+
+	nanvix_ikcq_progress(q);
+
+	return (n);
+}
+
+/*============================================================================*
+ * nanvix_ikcq_progress()                                                     *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_ikcq_progress() function scans the operations
+ * in flight in the queue @p q once, in order of submission. Queued
+ * operations are started when no earlier operation on the same
+ * communicator is in flight, and started operations are completed if
+ * possible, without blocking. Writes to portals send the pieces that
+ * the remote has allowed so far, and signals are sent asynchronously
+ * where the backend allows it. Writes to mailboxes and waits on
+ * native synchronization points cannot be probed, so they are parked
+ * and completed by nanvix_ikcq_reap().
+ */
+PUBLIC int nanvix_ikcq_progress(struct nanvix_ikcq *q)
+{
+	ssize_t ret;
+	int ncompleted;
+
+	/* Invalid queue. */
+	if (q == NULL)
+		return (-EINVAL);
+
+	ncompleted = 0;
+
+	for (unsigned i = q->sq_head; i != q->sq_tail; i++)
+	{
+		int *state = &q->states[IKCQ_SLOT(i)];
+
+		if ((*state == IKCQ_STATE_DONE) || (*state == IKCQ_STATE_PARKED))
+			continue;
+
+		if (*state == IKCQ_STATE_QUEUED)
+		{
+			if (ikcq_is_blocked(q, i))
+				continue;
+
+			/* Failed to start. */
+			if ((ret = ikcq_start(&q->sq[IKCQ_SLOT(i)])) < 0)
+			{
+				ikcq_complete(q, i, ret);
+				ncompleted++;
+				continue;
+			}
+
+			*state = IKCQ_STATE_STARTED;
+		}
+
+		if ((ret = ikcq_try(q, i)) == (-EAGAIN))
+			continue;
+
+		/* Completed by nanvix_ikcq_reap(). */
+		if ((ret == (-ENOTSUP)) && ikcq_is_parkable(&q->sq[IKCQ_SLOT(i)]))
+		{
+			*state = IKCQ_STATE_PARKED;
+			continue;
+		}
+
+		ikcq_complete(q, i, ret);
+		ncompleted++;
+	}
+
+	/* Releases completed operations. */
+	while ((q->sq_head != q->sq_tail) && (q->states[IKCQ_SLOT(q->sq_head)] == IKCQ_STATE_DONE))
+		q->sq_head++;
+
+	return (ncompleted);
+}
+
+/*============================================================================*
+ * nanvix_ikcq_reap()                                                         *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_ikcq_reap() function progresses the queue @p q
+ * until at least @p min completions are available, or no operation is
+ * left in flight, and then moves up to @p max completions to @p cqes.
+ * Parked operations are completed, oldest first, once nothing else
+ * is in flight.
+ */
+PUBLIC int nanvix_ikcq_reap(
+	struct nanvix_ikcq *q,
+	struct nanvix_ikcq_cqe *cqes,
+	int max,
+	int min
+)
+{
+	int n;
+	struct nanvix_backoff backoff;
+
+	/* Invalid queue. */
+	if (q == NULL)
+		return (-EINVAL);
+
+	/* Invalid store location. */
+	if ((cqes == NULL) || (max <= 0))
+		return (-EINVAL);
+
+	/* Invalid number of completions. */
+	if ((min < 0) || (min > max))
+		return (-EINVAL);
+
+	nanvix_backoff_init(&backoff, NANVIX_BACKOFF_DEFAULT);
+
+	nanvix_ikcq_progress(q);
+
+	while (((q->cq_tail - q->cq_head) < (unsigned) min) && (q->sq_head != q->sq_tail))
+	{
+		if ((nanvix_ikcq_progress(q) == 0) && (ikcq_unpark(q) == 0))
+			nanvix_backoff_wait(&backoff);
+	}
+
+	for (n = 0; (n < max) && (q->cq_head != q->cq_tail); n++)
+		cqes[n] = q->cq[IKCQ_SLOT(q->cq_head++)];
+
+	return (n);
+}
+
+#else
+extern int make_iso_compilers_happy;
+#endif /* __TARGET_HAS_MAILBOX */
@@ -29,14 +29,126 @@
 
 #if __TARGET_HAS_MAILBOX
 
+#include <nanvix/sys/counters.h>
+#include <nanvix/sys/latency.h>
+#include <nanvix/sys/mailbox.h>
+#include <nanvix/sys/perf.h>
+#include <nanvix/sys/progress.h>
+#include <nanvix/sys/trace.h>
 #include <posix/errno.h>
 
+/**
+ * @brief Latency histograms.
+ */
+PRIVATE struct nanvix_histogram kmailbox_histograms[KMAILBOX_MAX];
+
+/**
+ * @brief Clock values at which pending operations were posted.
+ */
+PRIVATE uint64_t kmailbox_posts[KMAILBOX_MAX];
+
+/**
+ * @brief Wait policies.
+ */
+PRIVATE int kmailbox_backoffs[KMAILBOX_MAX];
+
+#if (__NANVIX_IKC_LATENCY_ENABLED)
+
+/**
+ * @brief Sizes of the posted reads.
+ */
+PRIVATE ssize_t kmailbox_posted[KMAILBOX_MAX] = {
+	[0 ... (KMAILBOX_MAX - 1)] = NANVIX_LATENCY_IDLE
+};
+
+#endif /* __NANVIX_IKC_LATENCY_ENABLED */
+
+/**
+ * @brief Size of the length prefix of a coalesced message.
+ */
+#define KMAILBOX_COALESCE_HEADER_SIZE sizeof(uint16_t)
+
+/**
+ * @brief Coalescing frames.
+ *
+ * An output mailbox packs messages in its frame, and an input mailbox
+ * keeps in its frame the messages that were not read yet.
+ */
+PRIVATE struct
+{
+	spinlock_t lock;                   /**< Protection.                       */
+	bool output;                       /**< Output mailbox?                   */
+	bool flushing;                     /**< Is the frame in flight?           */
+	uint64_t deadline;                 /**< Flush deadline (zero if disabled). */
+	uint64_t t0;                       /**< Clock value of the first message. */
+	size_t used;                       /**< Bytes used in the frame.          */
+	size_t next;                       /**< Offset of the next message.       */
+	char frame[KMAILBOX_MESSAGE_SIZE]; /**< Frame.                            */
+} ALIGN(CACHE_LINE_SIZE) kmailbox_coalescers[KMAILBOX_MAX] = {
+	[0 ... (KMAILBOX_MAX - 1)] = { .lock = SPINLOCK_UNLOCKED }
+};
+
+/**
+ * @brief Number of output frames that hold messages.
+ */
+PRIVATE volatile int kmailbox_ndirty = 0;
+
+/**
+ * @brief Protection for the number of output frames that hold messages.
+ */
+PRIVATE spinlock_t kmailbox_ndirty_lock = SPINLOCK_UNLOCKED;
+
+/**
+ * @brief Local delivery rings, one per port.
+ *
+ * Threads of a cluster share memory, so a message between two of them
+ * is copied through a ring instead of crossing the NoC. A ring is not
+ * single-producer single-consumer: any thread of the cluster may open
+ * an output mailbox to a port, and several threads may read from its
+ * input mailbox. This library has no atomic read-modify-write
+ * primitive other than spinlocks, so writers and readers serialize on
+ * the lock of the ring. Readers peek at the ring without locking, so
+ * that polling an empty ring is lock-free.
+ *
+ * A cluster may have several NoC nodes, and each of them may create
+ * an input mailbox in the same port. A ring is therefore owned by the
+ * first node that binds an input mailbox to its port, and it only
+ * carries messages addressed to that node. Mailboxes of other nodes
+ * in the same port keep using the NoC.
+ */
+PRIVATE struct
+{
+	spinlock_t lock;                                                /**< Protection.             */
+	int node;                                                       /**< Owner node (-1 if free). */
+	volatile unsigned head;                                         /**< Next to read.           */
+	volatile unsigned tail;                                         /**< Next to write.          */
+	size_t sizes[KMAILBOX_LOCAL_RING_SIZE];                         /**< Message sizes.          */
+	char messages[KMAILBOX_LOCAL_RING_SIZE][KMAILBOX_MESSAGE_SIZE]; /**< Messages.               */
+} ALIGN(CACHE_LINE_SIZE) kmailbox_locals[MAILBOX_PORT_NR] = {
+	[0 ... (MAILBOX_PORT_NR - 1)] = { .lock = SPINLOCK_UNLOCKED, .node = -1 }
+};
+
+/**
+ * @brief Local delivery bindings.
+ */
+PRIVATE struct
+{
+	spinlock_t lock;  /**< Protection of statistics.          */
+	int node;         /**< Node of the ring.                  */
+	int port;         /**< Port of the ring (-1 if unbound).  */
+	bool output;      /**< Output mailbox?                    */
+	size_t volume;    /**< Data transferred through the ring. */
+	uint64_t latency; /**< Time spent in the ring.            */
+} kmailbox_local_binds[KMAILBOX_MAX] = {
+	[0 ... (KMAILBOX_MAX - 1)] = { .lock = SPINLOCK_UNLOCKED, .node = -1, .port = -1, .output = false }
+};
+
 #if __NANVIX_IKC_USES_ONLY_MAILBOX
 
 /**
  * @brief Protections.
  */
-PRIVATE spinlock_t global_lock = SPINLOCK_UNLOCKED;
+PRIVATE spinlock_t global_lock ALIGN(CACHE_LINE_SIZE) = SPINLOCK_UNLOCKED;
 
 /**
  * @brief Counter control.
@@ -50,20 +162,304 @@ PRIVATE bool user_mailboxes[KMAILBOX_MAX] = {
  *============================================================================*/
 
 /**
- * @brief Communicator counters.
+ * @name Communicator counters.
  */
-PRIVATE struct
-{
-	uint64_t ncreates; /**< Number of creates. */
-	uint64_t nunlinks; /**< Number of unlinks. */
-	uint64_t nopens;   /**< Number of opens.   */
-	uint64_t ncloses;  /**< Number of closes.  */
-	uint64_t nreads;   /**< Number of reads.   */
-	uint64_t nwrites;  /**< Number of writes.  */
-} mailbox_counters;
+/**@{*/
+#define MAILBOX_COUNTER_NCREATES 0 /**< Number of creates. */
+#define MAILBOX_COUNTER_NUNLINKS 1 /**< Number of unlinks. */
+#define MAILBOX_COUNTER_NOPENS   2 /**< Number of opens.   */
+#define MAILBOX_COUNTER_NCLOSES  3 /**< Number of closes.  */
+#define MAILBOX_COUNTER_NREADS   4 /**< Number of reads.   */
+#define MAILBOX_COUNTER_NWRITES  5 /**< Number of writes.  */
+/**@}*/
+
+#if __NANVIX_IKC_STATS
+
+/**
+ * @brief Communicator counters, sharded per thread.
+ */
+PRIVATE struct nanvix_counters mailbox_counters;
+
+#endif /* __NANVIX_IKC_STATS */
 
 #endif /* __NANVIX_IKC_USES_ONLY_MAILBOX */
 
+/**
+ * @brief Gets the wait policy of a mailbox.
+ *
+ * @param mbxid Target mailbox.
+ *
+ * @returns The wait policy of @p mbxid, or the default one if @p
+ * mbxid is invalid.
+ */
+PRIVATE int kmailbox_backoff(int mbxid)
+{
+	return (WITHIN(mbxid, 0, KMAILBOX_MAX) ? kmailbox_backoffs[mbxid] : NANVIX_BACKOFF_DEFAULT);
+}
+
+/**
+ * @brief Asserts whether a mailbox coalesces messages.
+ *
+ * @param mbxid Target mailbox.
+ *
+ * @returns Non-zero if @p mbxid coalesces messages, and zero otherwise.
+ */
+PRIVATE int kmailbox_is_coalescing(int mbxid)
+{
+	return (
+		__NANVIX_IKC_COALESCING &&
+		WITHIN(mbxid, 0, KMAILBOX_MAX) &&
+		(kmailbox_coalescers[mbxid].deadline != 0)
+	);
+}
+
+/**
+ * @brief Updates the number of output frames that hold messages.
+ *
+ * @param delta Number of frames that became dirty (or clean, if
+ * negative).
+ */
+PRIVATE void kmailbox_dirty(int delta)
+{
+	spinlock_lock(&kmailbox_ndirty_lock);
+		kmailbox_ndirty += delta;
+	spinlock_unlock(&kmailbox_ndirty_lock);
+}
+
+/**
+ * @brief Resets the coalescing frame of a mailbox.
+ *
+ * @param mbxid  Target mailbox.
+ * @param output Is @p mbxid an output mailbox?
+ */
+PRIVATE void kmailbox_coalesce_reset(int mbxid, bool output)
+{
+	spinlock_lock(&kmailbox_coalescers[mbxid].lock);
+
+		/* Discard messages of a previous mailbox. */
+		if (kmailbox_coalescers[mbxid].output && (kmailbox_coalescers[mbxid].used != 0))
+			kmailbox_dirty(-1);
+
+		kmailbox_coalescers[mbxid].output   = output;
+		kmailbox_coalescers[mbxid].flushing = false;
+		kmailbox_coalescers[mbxid].deadline = 0;
+		kmailbox_coalescers[mbxid].used     = 0;
+		kmailbox_coalescers[mbxid].next     = 0;
+
+	spinlock_unlock(&kmailbox_coalescers[mbxid].lock);
+}
+
+/**
+ * @brief Gets the local delivery ring of a mailbox.
+ *
+ * @param mbxid  Target mailbox.
+ * @param output Is @p mbxid expected to be an output mailbox?
+ *
+ * @returns The port of the ring bound to @p mbxid, or a negative
+ * number if @p mbxid is not bound in the expected direction.
+ */
+PRIVATE int kmailbox_local_port(int mbxid, bool output)
+{
+	if (!WITHIN(mbxid, 0, KMAILBOX_MAX))
+		return (-1);
+
+	if (kmailbox_local_binds[mbxid].output != output)
+		return (-1);
+
+	return (kmailbox_local_binds[mbxid].port);
+}
+
+/**
+ * @brief Accounts a message delivered through a local ring.
+ *
+ * Local deliveries do not reach the kernel, so their volume and
+ * latency are kept here and added to the ones of the kernel.
+ *
+ * @param mbxid   Target mailbox.
+ * @param size    Size of the message.
+ * @param latency Time spent delivering the message.
+ */
+PRIVATE void kmailbox_local_account(int mbxid, size_t size, uint64_t latency)
+{
+	spinlock_lock(&kmailbox_local_binds[mbxid].lock);
+		kmailbox_local_binds[mbxid].volume  += size;
+		kmailbox_local_binds[mbxid].latency += latency;
+	spinlock_unlock(&kmailbox_local_binds[mbxid].lock);
+}
+
+/**
+ * @brief Enqueues a message in a local delivery ring.
+ *
+ * @param node   Target node.
+ * @param port   Target port.
+ * @param buffer Message.
+ * @param size   Size of @p buffer.
+ *
+ * @returns Upon successful completion, zero is returned. If the ring
+ * is full, -EAGAIN is returned instead. If the ring is not owned by
+ * @p node, -ENOENT is returned and the message must cross the NoC.
+ */
+PRIVATE int kmailbox_local_push(int node, int port, const void * buffer, size_t size)
+{
+	unsigned slot;
+
+	spinlock_lock(&kmailbox_locals[port].lock);
+
+		/* Ring of another node. */
+		if (kmailbox_locals[port].node != node)
+		{
+			spinlock_unlock(&kmailbox_locals[port].lock);
+			return (-ENOENT);
+		}
+
+		/* Full ring. */
+		if ((kmailbox_locals[port].tail - kmailbox_locals[port].head) == KMAILBOX_LOCAL_RING_SIZE)
+		{
+			spinlock_unlock(&kmailbox_locals[port].lock);
+			return (-EAGAIN);
+		}
+
+		slot = kmailbox_locals[port].tail % KMAILBOX_LOCAL_RING_SIZE;
+
+		kmemcpy(kmailbox_locals[port].messages[slot], buffer, size);
+		kmailbox_locals[port].sizes[slot] = size;
+
+		/* Publish the message. */
+		kmailbox_locals[port].tail++;
+
+	spinlock_unlock(&kmailbox_locals[port].lock);
+
+	return (0);
+}
+
+/**
+ * @brief Dequeues a message from a local delivery ring.
+ *
+ * @param port   Target port.
+ * @param buffer Target buffer.
+ * @param size   Size of @p buffer.
+ *
+ * @returns Upon successful completion, zero is returned. If the ring
+ * is empty, -EAGAIN is returned instead.
+ */
+PRIVATE int kmailbox_local_pop(int port, void * buffer, size_t size)
+{
+	unsigned slot;
+
+	/* Empty ring. */
+	if (kmailbox_locals[port].head == kmailbox_locals[port].tail)
+		return (-EAGAIN);
+
+	spinlock_lock(&kmailbox_locals[port].lock);
+
+		/* Another reader got it. */
+		if (kmailbox_locals[port].head == kmailbox_locals[port].tail)
+		{
+			spinlock_unlock(&kmailbox_locals[port].lock);
+			return (-EAGAIN);
+		}
+
+		slot = kmailbox_locals[port].head % KMAILBOX_LOCAL_RING_SIZE;
+
+		/* Like the NoC, copy at most the size of the reader. */
+		if (kmailbox_locals[port].sizes[slot] < size)
+			size = kmailbox_locals[port].sizes[slot];
+
+		kmemcpy(buffer, kmailbox_locals[port].messages[slot], size);
+
+		kmailbox_locals[port].head++;
+
+	spinlock_unlock(&kmailbox_locals[port].lock);
+
+	return (0);
+}
+
+/**
+ * @brief Claims a local delivery ring.
+ *
+ * @param node Owner node.
+ * @param port Target port.
+ *
+ * @returns Upon successful completion, zero is returned. If the ring
+ * is owned by another node, -EBUSY is returned instead.
+ */
+PRIVATE int kmailbox_local_claim(int node, int port)
+{
+	spinlock_lock(&kmailbox_locals[port].lock);
+
+		if ((kmailbox_locals[port].node >= 0) && (kmailbox_locals[port].node != node))
+		{
+			spinlock_unlock(&kmailbox_locals[port].lock);
+			return (-EBUSY);
+		}
+
+		kmailbox_locals[port].node = node;
+		kmailbox_locals[port].head = kmailbox_locals[port].tail;
+
+	spinlock_unlock(&kmailbox_locals[port].lock);
+
+	return (0);
+}
+
+/**
+ * @brief Releases a local delivery ring.
+ *
+ * Leftovers are discarded, so that they do not reach the next mailbox
+ * of the port.
+ *
+ * @param port Target port.
+ */
+PRIVATE void kmailbox_local_release(int port)
+{
+	spinlock_lock(&kmailbox_locals[port].lock);
+		kmailbox_locals[port].node = -1;
+		kmailbox_locals[port].head = kmailbox_locals[port].tail;
+	spinlock_unlock(&kmailbox_locals[port].lock);
+}
+
+/*============================================================================*
+ * kmailbox_local_bind()                                                      *
+ *============================================================================*/
+
+/**
+ * @details The kmailbox_local_bind() function binds the mailbox @p
+ * mbxid to the local delivery ring of the node @p node in the port @p
+ * port. A negative @p port unbinds it. An input mailbox claims the
+ * ring, and an output mailbox only uses it while @p node owns it.
+ */
+PUBLIC int kmailbox_local_bind(int mbxid, int node, int port, bool output)
+{
+	int ret;
+
+	/* Invalid mailbox. */
+	if (!WITHIN(mbxid, 0, KMAILBOX_MAX))
+		return (-EINVAL);
+
+	/* Invalid port. */
+	if (port >= MAILBOX_PORT_NR)
+		return (-EINVAL);
+
+	/* Release the ring of a previous input mailbox. */
+	if (!kmailbox_local_binds[mbxid].output && (kmailbox_local_binds[mbxid].port >= 0))
+		kmailbox_local_release(kmailbox_local_binds[mbxid].port);
+
+	ret = 0;
+
+	/* Input mailboxes claim the ring. */
+	if (!output && (port >= 0) && ((ret = kmailbox_local_claim(node, port)) < 0))
+		port = -1;
+
+	spinlock_lock(&kmailbox_local_binds[mbxid].lock);
+		kmailbox_local_binds[mbxid].node    = node;
+		kmailbox_local_binds[mbxid].port    = (port < 0) ? -1 : port;
+		kmailbox_local_binds[mbxid].output  = output;
+		kmailbox_local_binds[mbxid].volume  = 0;
+		kmailbox_local_binds[mbxid].latency = 0;
+	spinlock_unlock(&kmailbox_local_binds[mbxid].lock);
+
+	return (ret);
+}
+
 /*============================================================================*
  * kmailbox_create()                                                          *
  *============================================================================*/
@@ -90,14 +486,22 @@ int kmailbox_create(int local, int port)
 #if __NANVIX_IKC_USES_ONLY_MAILBOX
 	if (ret >= 0)
 	{
-		spinlock_lock(&global_lock);
-			mailbox_counters.ncreates++;
-		spinlock_unlock(&global_lock);
+		NANVIX_COUNTERS_INC(mailbox_counters, MAILBOX_COUNTER_NCREATES);
 
 		user_mailboxes[ret] = true;
 	}
 #endif /* __NANVIX_IKC_USES_ONLY_MAILBOX */
 
+	/* Discard samples of a previous mailbox. */
+	if (ret >= 0)
+	{
+		nanvix_histogram_reset(&kmailbox_histograms[ret]);
+		kmailbox_posts[ret] = 0;
+		kmailbox_backoffs[ret] = NANVIX_BACKOFF_DEFAULT;
+		kmailbox_coalesce_reset(ret, false);
+		kmailbox_local_bind(ret, local, port, false);
+	}
+
 	return (ret);
 }
 
@@ -127,14 +531,22 @@ int kmailbox_open(int remote, int remote_port)
 #if __NANVIX_IKC_USES_ONLY_MAILBOX
 	if (ret >= 0)
 	{
-		spinlock_lock(&global_lock);
-			mailbox_counters.nopens++;
-		spinlock_unlock(&global_lock);
+		NANVIX_COUNTERS_INC(mailbox_counters, MAILBOX_COUNTER_NOPENS);
 
 		user_mailboxes[ret] = true;
 	}
 #endif /* __NANVIX_IKC_USES_ONLY_MAILBOX */
 
+	/* Discard samples of a previous mailbox. */
+	if (ret >= 0)
+	{
+		nanvix_histogram_reset(&kmailbox_histograms[ret]);
+		kmailbox_posts[ret] = 0;
+		kmailbox_backoffs[ret] = NANVIX_BACKOFF_DEFAULT;
+		kmailbox_coalesce_reset(ret, true);
+		kmailbox_local_bind(ret, remote, (remote == knode_get_num()) ? remote_port : -1, true);
+	}
+
 	return (ret);
 }
 
@@ -155,12 +567,13 @@ int kmailbox_unlink(int mbxid)
 		(word_t) mbxid
 	);
 
+	if (ret >= 0)
+		kmailbox_local_bind(mbxid, -1, -1, false);
+
 #if __NANVIX_IKC_USES_ONLY_MAILBOX
 	if (ret >= 0)
 	{
-		spinlock_lock(&global_lock);
-			mailbox_counters.nunlinks++;
-		spinlock_unlock(&global_lock);
+		NANVIX_COUNTERS_INC(mailbox_counters, MAILBOX_COUNTER_NUNLINKS);
 
 		user_mailboxes[mbxid] = false;
 	}
@@ -181,17 +594,22 @@ int kmailbox_close(int mbxid)
 {
 	int ret;
 
+	/* Sends packed messages. */
+	if (kmailbox_is_coalescing(mbxid) && ((ret = kmailbox_flush(mbxid)) < 0))
+		return (ret);
+
 	ret = kcall1(
 		NR_mailbox_close,
 		(word_t) mbxid
 	);
 
+	if (ret >= 0)
+		kmailbox_local_bind(mbxid, -1, -1, true);
+
 #if __NANVIX_IKC_USES_ONLY_MAILBOX
 	if (ret >= 0)
 	{
-		spinlock_lock(&global_lock);
-			mailbox_counters.ncloses++;
-		spinlock_unlock(&global_lock);
+		NANVIX_COUNTERS_INC(mailbox_counters, MAILBOX_COUNTER_NCLOSES);
 
 		user_mailboxes[mbxid] = false;
 	}
@@ -211,11 +629,18 @@ int kmailbox_close(int mbxid)
 ssize_t kmailbox_awrite(int mbxid, const void * buffer, size_t size)
 {
 	int ret;
+	bool retry;
+	bool contended;
+	struct nanvix_backoff backoff;
 
 	/* Invalid buffer size. */
 	if ((size == 0) || (size > KMAILBOX_MESSAGE_SIZE))
 		return (-EINVAL);
 
+	contended = false;
+	nanvix_backoff_init(&backoff, kmailbox_backoff(mbxid));
+	NANVIX_TRACE_BEGIN(NANVIX_TRACE_KMAILBOX_AWRITE, mbxid);
+
 	do
 	{
 		ret = kcall3(
@@ -224,7 +649,24 @@ ssize_t kmailbox_awrite(int mbxid, const void * buffer, size_t size)
 			(word_t) buffer,
 			(word_t) size
 		);
-	} while ((ret == -ETIMEDOUT) || (ret == -EAGAIN) || (ret == -EBUSY));
+
+		/* Busy mailbox. */
+		if ((ret == -EBUSY) && !contended)
+		{
+			contended = true;
+			NANVIX_TRACE_INSTANT(NANVIX_TRACE_LOCK_CONTENTION, mbxid, 0);
+		}
+
+		/* Not ready yet. */
+		if ((retry = (ret == -ETIMEDOUT) || (ret == -EAGAIN) || (ret == -EBUSY)))
+			nanvix_backoff_wait(&backoff);
+	} while (retry);
+
+	/* Sampled by kmailbox_wait(). */
+	if (ret >= 0)
+		NANVIX_HISTOGRAM_POST(kmailbox_posts[mbxid]);
+
+	NANVIX_TRACE_END(NANVIX_TRACE_KMAILBOX_AWRITE, mbxid, ret);
 
 	return (ret);
 }
@@ -240,11 +682,18 @@ ssize_t kmailbox_awrite(int mbxid, const void * buffer, size_t size)
 ssize_t kmailbox_aread(int mbxid, void * buffer, size_t size)
 {
 	int ret;
+	bool retry;
+	bool contended;
+	struct nanvix_backoff backoff;
 
 	/* Invalid buffer size. */
 	if ((size == 0) || (size > KMAILBOX_MESSAGE_SIZE))
 		return (-EINVAL);
 
+	contended = false;
+	nanvix_backoff_init(&backoff, kmailbox_backoff(mbxid));
+	NANVIX_TRACE_BEGIN(NANVIX_TRACE_KMAILBOX_AREAD, mbxid);
+
 	do
 	{
 		ret = kcall3(
@@ -253,7 +702,27 @@ ssize_t kmailbox_aread(int mbxid, void * buffer, size_t size)
 			(word_t) buffer,
 			(word_t) size
 		);
-	} while ((ret == -ETIMEDOUT) || (ret == -EBUSY) || (ret == -ENOMSG));
+
+		/* Busy mailbox. */
+		if ((ret == -EBUSY) && !contended)
+		{
+			contended = true;
+			NANVIX_TRACE_INSTANT(NANVIX_TRACE_LOCK_CONTENTION, mbxid, 0);
+		}
+
+		/* Not ready yet. */
+		if ((retry = (ret == -ETIMEDOUT) || (ret == -EBUSY) || (ret == -ENOMSG)))
+			nanvix_backoff_wait(&backoff);
+	} while (retry);
+
+	/* Delivered and sampled by kmailbox_wait(). */
+	if (ret >= 0)
+	{
+		NANVIX_LATENCY_POST(kmailbox_posted[mbxid], size);
+		NANVIX_HISTOGRAM_POST(kmailbox_posts[mbxid]);
+	}
+
+	NANVIX_TRACE_END(NANVIX_TRACE_KMAILBOX_AREAD, mbxid, ret);
 
 	return (ret);
 }
@@ -270,11 +739,23 @@ int kmailbox_wait(int mbxid)
 {
 	int ret;
 
+	NANVIX_TRACE_BEGIN(NANVIX_TRACE_KMAILBOX_WAIT, mbxid);
+
 	ret = kcall1(
 		NR_mailbox_wait,
 		(word_t) mbxid
 	);
 
+	/* Emulate the interconnect. */
+	if (ret >= 0)
+		NANVIX_LATENCY_DELIVER(kmailbox_posted[mbxid], ret);
+
+	/* Completed: sample the time since it was posted. */
+	if (ret == 0)
+		NANVIX_HISTOGRAM_COMPLETE(&kmailbox_histograms[mbxid], kmailbox_posts[mbxid]);
+
+	NANVIX_TRACE_END(NANVIX_TRACE_KMAILBOX_WAIT, mbxid, ret);
+
 	return (ret);
 }
 
@@ -282,15 +763,20 @@ int kmailbox_wait(int mbxid)
  * kmailbox_write()                                                           *
  *============================================================================*/
 
+/*----------------------------------------------------------------------------*
+ * do_kmailbox_write()                                                        *
+ *----------------------------------------------------------------------------*/
+
 /**
- * @details The kmailbox_write() synchronously write @p size bytes of
- * data pointed to by @p buffer to the output mailbox @p mbxid.
- *
  * @todo Uncomment kmailbox_wait() call when microkernel properly supports it.
  */
-ssize_t kmailbox_write(int mbxid, const void * buffer, size_t size)
+PRIVATE ssize_t do_kmailbox_write(int mbxid, const void * buffer, size_t size)
 {
 	int ret;
+	int port;
+	uint64_t t0;
+	uint64_t t1;
+	struct nanvix_backoff backoff;
 
 	/* Invalid buffer. */
 	if (buffer == NULL)
@@ -300,63 +786,669 @@ ssize_t kmailbox_write(int mbxid, const void * buffer, size_t size)
 	if ((size == 0) || (size > KMAILBOX_MESSAGE_SIZE))
 		return (-EINVAL);
 
-	if ((ret = kmailbox_awrite(mbxid, buffer, size)) < 1)
-		return (ret);
+	NANVIX_TRACE_BEGIN(NANVIX_TRACE_KMAILBOX_WRITE, mbxid);
 
-	if ((ret = kmailbox_wait(mbxid)) < 0)
-		return (ret);
+	kclock(&t0);
+
+	ret = -ENOENT;
+
+	/* Local delivery. */
+	if ((port = kmailbox_local_port(mbxid, true)) >= 0)
+	{
+		nanvix_backoff_init(&backoff, kmailbox_backoff(mbxid));
+		while ((ret = kmailbox_local_push(kmailbox_local_binds[mbxid].node, port, buffer, size)) == -EAGAIN)
+			nanvix_backoff_wait(&backoff);
+	}
+
+	/* Delivery through the NoC. */
+	if (ret == -ENOENT)
+	{
+		port = -1;
+
+		if ((ret = kmailbox_awrite(mbxid, buffer, size)) < 1)
+			goto out;
+
+		if ((ret = kmailbox_wait(mbxid)) < 0)
+			goto out;
+	}
 
 #if __NANVIX_IKC_USES_ONLY_MAILBOX
-	spinlock_lock(&global_lock);
-		if (user_mailboxes[mbxid])
-			mailbox_counters.nwrites++;
-	spinlock_unlock(&global_lock);
+	if (user_mailboxes[mbxid])
+		NANVIX_COUNTERS_INC(mailbox_counters, MAILBOX_COUNTER_NWRITES);
 #endif /* __NANVIX_IKC_USES_ONLY_MAILBOX */
 
-	return (size);
+	kclock(&t1);
+
+	/* Local deliveries bypass the kernel and kmailbox_wait(). */
+	if (port >= 0)
+	{
+		NANVIX_HISTOGRAM_RECORD(&kmailbox_histograms[mbxid], t1 - t0);
+		kmailbox_local_account(mbxid, size, t1 - t0);
+	}
+
+	ret = size;
+
+out:
+	NANVIX_TRACE_END(NANVIX_TRACE_KMAILBOX_WRITE, mbxid, ret);
+
+	return (ret);
 }
 
-/*============================================================================*
- * kmailbox_read()                                                            *
- *============================================================================*/
+/*----------------------------------------------------------------------------*
+ * do_kmailbox_flush()                                                        *
+ *----------------------------------------------------------------------------*/
 
 /**
- * @details The kmailbox_read() synchronously read @p size bytes of
- * data pointed to by @p buffer from the input mailbox @p mbxid.
+ * @brief Sends the frame of an output mailbox.
+ *
+ * @param mbxid Target output mailbox.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead, and the frame keeps its
+ * messages.
+ *
+ * @note The lock of the frame must be held. It is released while the
+ * frame is sent, so that other writers keep packing messages after the
+ * ones in flight.
  */
-ssize_t kmailbox_read(int mbxid, void * buffer, size_t size)
+PRIVATE int do_kmailbox_flush(int mbxid)
 {
-	int ret;
+	ssize_t ret;
+	size_t n;
+	uint16_t eof;
+	char frame[KMAILBOX_MESSAGE_SIZE];
 
-	/* Invalid buffer. */
-	if (buffer == NULL)
-		return (-EINVAL);
+	/* Waits for a frame that is already in flight. */
+	while (kmailbox_coalescers[mbxid].flushing)
+	{
+		spinlock_unlock(&kmailbox_coalescers[mbxid].lock);
+		spinlock_lock(&kmailbox_coalescers[mbxid].lock);
+	}
 
-	/* Invalid buffer size. */
-	if ((size == 0) || (size > KMAILBOX_MESSAGE_SIZE))
-		return (-EINVAL);
+	/* Nothing to send. */
+	if ((n = kmailbox_coalescers[mbxid].used) == 0)
+		return (0);
 
-	/* Repeat while reading valid messages for another ports. */
-	do
+	/* Terminates the frame. */
+	if ((n + KMAILBOX_COALESCE_HEADER_SIZE) <= KMAILBOX_MESSAGE_SIZE)
 	{
-		if ((ret = kmailbox_aread(mbxid, buffer, size)) < 0)
-			return (ret);
-	} while ((ret = kmailbox_wait(mbxid)) > 0);
+		eof = 0;
+		kmemcpy(&kmailbox_coalescers[mbxid].frame[n], &eof, KMAILBOX_COALESCE_HEADER_SIZE);
+	}
+
+	kmemcpy(frame, kmailbox_coalescers[mbxid].frame, KMAILBOX_MESSAGE_SIZE);
+	kmailbox_coalescers[mbxid].flushing = true;
+
+	spinlock_unlock(&kmailbox_coalescers[mbxid].lock);
+
+		ret = do_kmailbox_write(mbxid, frame, KMAILBOX_MESSAGE_SIZE);
+
+	spinlock_lock(&kmailbox_coalescers[mbxid].lock);
+
+	/* Mailbox was reset meanwhile. */
+	if (!kmailbox_coalescers[mbxid].flushing)
+		return ((ret < 0) ? (int) ret : 0);
+
+	kmailbox_coalescers[mbxid].flushing = false;
+
+	/* Failed to send: keep the messages. */
+	if (ret < 0)
+		return ((int) ret);
+
+	/* Drops the messages that were sent. */
+	kmailbox_coalescers[mbxid].used -= n;
+	for (size_t i = 0; i < kmailbox_coalescers[mbxid].used; i++)
+		kmailbox_coalescers[mbxid].frame[i] = kmailbox_coalescers[mbxid].frame[n + i];
+
+	if (kmailbox_coalescers[mbxid].used == 0)
+		kmailbox_dirty(-1);
+
+	return (0);
+}
+
+/*----------------------------------------------------------------------------*
+ * kmailbox_coalesce_write()                                                  *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Packs a message in the frame of an output mailbox.
+ *
+ * @param mbxid  Target output mailbox.
+ * @param buffer Message.
+ * @param size   Size of @p buffer.
+ *
+ * @returns Upon successful completion, @p size is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE ssize_t kmailbox_coalesce_write(int mbxid, const void * buffer, size_t size)
+{
+	int ret;
+	uint64_t now;
+	uint16_t len;
+
+	/* Invalid buffer. */
+	if (buffer == NULL)
+		return (-EINVAL);
+
+	/* Invalid buffer size. */
+	if ((size == 0) || (size > KMAILBOX_COALESCE_MAX_SIZE))
+		return (-EINVAL);
+
+	ret = 0;
+	len = (uint16_t) size;
+
+	spinlock_lock(&kmailbox_coalescers[mbxid].lock);
+
+		/* Not older than the first message of the frame. */
+		kclock(&now);
+
+		/*
+		 * Full frame or expired deadline. Other writers may pack
+		 * messages while the frame is in flight, so check again.
+		 */
+		while ((kmailbox_coalescers[mbxid].used != 0) && (
+			((kmailbox_coalescers[mbxid].used + KMAILBOX_COALESCE_HEADER_SIZE + size) > KMAILBOX_MESSAGE_SIZE) ||
+			((now - kmailbox_coalescers[mbxid].t0) >= kmailbox_coalescers[mbxid].deadline)))
+		{
+			if ((ret = do_kmailbox_flush(mbxid)) < 0)
+				goto error;
+
+			kclock(&now);
+		}
+
+		/* First message of the frame. */
+		if (kmailbox_coalescers[mbxid].used == 0)
+		{
+			kmailbox_coalescers[mbxid].t0 = now;
+			kmailbox_dirty(+1);
+		}
+
+		kmemcpy(
+			&kmailbox_coalescers[mbxid].frame[kmailbox_coalescers[mbxid].used],
+			&len,
+			KMAILBOX_COALESCE_HEADER_SIZE
+		);
+		kmemcpy(
+			&kmailbox_coalescers[mbxid].frame[kmailbox_coalescers[mbxid].used + KMAILBOX_COALESCE_HEADER_SIZE],
+			buffer,
+			size
+		);
+		kmailbox_coalescers[mbxid].used += KMAILBOX_COALESCE_HEADER_SIZE + size;
+
+		/* No room for another message. */
+		if ((kmailbox_coalescers[mbxid].used + KMAILBOX_COALESCE_HEADER_SIZE) >= KMAILBOX_MESSAGE_SIZE)
+			ret = do_kmailbox_flush(mbxid);
+
+error:
+	spinlock_unlock(&kmailbox_coalescers[mbxid].lock);
+
+	return ((ret < 0) ? ret : (ssize_t) size);
+}
+
+/*----------------------------------------------------------------------------*
+ * kmailbox_write()                                                           *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @details The kmailbox_write() synchronously write @p size bytes of
+ * data pointed to by @p buffer to the output mailbox @p mbxid. If the
+ * mailbox coalesces messages, the message is packed in its frame
+ * instead.
+ */
+ssize_t kmailbox_write(int mbxid, const void * buffer, size_t size)
+{
+	if (kmailbox_is_coalescing(mbxid))
+		return (kmailbox_coalesce_write(mbxid, buffer, size));
+
+	return (do_kmailbox_write(mbxid, buffer, size));
+}
+
+/*============================================================================*
+ * kmailbox_flush()                                                           *
+ *============================================================================*/
+
+/**
+ * @details The kmailbox_flush() function sends the messages packed in
+ * the frame of the output mailbox @p mbxid, if any.
+ */
+int kmailbox_flush(int mbxid)
+{
+	int ret;
+
+	/* Invalid mailbox. */
+	if (!WITHIN(mbxid, 0, KMAILBOX_MAX))
+		return (-EINVAL);
+
+	spinlock_lock(&kmailbox_coalescers[mbxid].lock);
+		ret = (kmailbox_coalescers[mbxid].output) ? do_kmailbox_flush(mbxid) : 0;
+	spinlock_unlock(&kmailbox_coalescers[mbxid].lock);
+
+	return (ret);
+}
+
+#if __NANVIX_IKC_USES_ONLY_MAILBOX
+
+/*============================================================================*
+ * kmailbox_progress()                                                        *
+ *============================================================================*/
+
+/**
+ * @details The kmailbox_progress() function flushes the frames of
+ * output mailboxes whose deadline expired, so that packed messages do
+ * not wait for the next write to the mailbox.
+ */
+PUBLIC int kmailbox_progress(void)
+{
+	int nflushed;
+	uint64_t now;
+
+	/* Nothing packed. */
+	if (kmailbox_ndirty == 0)
+		return (0);
+
+	nflushed = 0;
+
+	for (int i = 0; i < KMAILBOX_MAX; i++)
+	{
+		/* Skips empty frames without locking. */
+		if (!kmailbox_coalescers[i].output || (kmailbox_coalescers[i].used == 0))
+			continue;
+
+		spinlock_lock(&kmailbox_coalescers[i].lock);
+
+			kclock(&now);
+
+			/* Expired deadline. */
+			if (kmailbox_coalescers[i].output && (kmailbox_coalescers[i].used != 0) &&
+				!kmailbox_coalescers[i].flushing &&
+				((now - kmailbox_coalescers[i].t0) >= kmailbox_coalescers[i].deadline))
+			{
+				if (do_kmailbox_flush(i) == 0)
+					nflushed++;
+			}
+
+		spinlock_unlock(&kmailbox_coalescers[i].lock);
+	}
+
+	return (nflushed);
+}
+
+#endif /* __NANVIX_IKC_USES_ONLY_MAILBOX */
+
+/**
+ * @brief Flushes the frames of all output mailboxes.
+ *
+ * Called before blocking in a read, so that a request that is still
+ * packed does not wait for its own reply.
+ */
+PRIVATE void kmailbox_flush_all(void)
+{
+	/* Nothing packed. */
+	if (kmailbox_ndirty == 0)
+		return;
+
+	for (int i = 0; i < KMAILBOX_MAX; i++)
+	{
+		if (kmailbox_coalescers[i].output && (kmailbox_coalescers[i].used != 0))
+			kmailbox_flush(i);
+	}
+}
+
+/*============================================================================*
+ * kmailbox_read()                                                            *
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*
+ * kmailbox_noc_tryread()                                                     *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Reads a message that already arrived through the NoC.
+ *
+ * @param mbxid  Target input mailbox.
+ * @param buffer Target buffer.
+ * @param size   Size of @p buffer.
+ *
+ * @returns Upon successful completion, zero is returned. If no message
+ * is available, -EAGAIN is returned. Upon failure, a negative error
+ * code is returned instead.
+ */
+PRIVATE int kmailbox_noc_tryread(int mbxid, void * buffer, size_t size)
+{
+	int ret;
+
+	ret = kcall3(
+		NR_mailbox_aread,
+		(word_t) mbxid,
+		(word_t) buffer,
+		(word_t) size
+	);
+
+	/* Not ready yet. */
+	if ((ret == -ETIMEDOUT) || (ret == -EBUSY) || (ret == -ENOMSG))
+		return (-EAGAIN);
 
-	/* Wait failed. */
 	if (ret < 0)
 		return (ret);
 
+	NANVIX_LATENCY_POST(kmailbox_posted[mbxid], size);
+	NANVIX_HISTOGRAM_POST(kmailbox_posts[mbxid]);
+
+	/* Message for another port. */
+	if ((ret = kmailbox_wait(mbxid)) > 0)
+		return (-EAGAIN);
+
+	return (ret);
+}
+
+/*----------------------------------------------------------------------------*
+ * kmailbox_local_read()                                                      *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Reads a message from an input mailbox bound to a ring.
+ *
+ * Messages from the local node arrive in the ring, and messages from
+ * remote nodes arrive through the NoC, so both are polled.
+ *
+ * @param mbxid    Target input mailbox.
+ * @param port     Port of the ring.
+ * @param buffer   Target buffer.
+ * @param size     Size of @p buffer.
+ * @param nonblock Fail with -EAGAIN instead of waiting?
+ *
+ * @returns Upon successful completion, one is returned if the message
+ * came through the ring, and zero if it came through the NoC. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int kmailbox_local_read(int mbxid, int port, void * buffer, size_t size, bool nonblock)
+{
+	int ret;
+	struct nanvix_backoff backoff;
+
+	nanvix_backoff_init(&backoff, kmailbox_backoff(mbxid));
+
+	while (true)
+	{
+		if ((ret = kmailbox_local_pop(port, buffer, size)) != -EAGAIN)
+			return ((ret < 0) ? ret : 1);
+
+		if ((ret = kmailbox_noc_tryread(mbxid, buffer, size)) != -EAGAIN)
+			return (ret);
+
+		if (nonblock)
+			return (-EAGAIN);
+
+		nanvix_backoff_wait(&backoff);
+	}
+}
+
+/*----------------------------------------------------------------------------*
+ * do_kmailbox_read()                                                         *
+ *----------------------------------------------------------------------------*/
+
+PRIVATE ssize_t do_kmailbox_read(int mbxid, void * buffer, size_t size)
+{
+	int ret;
+	int port;
+	uint64_t t0;
+	uint64_t t1;
+
+	/* Invalid buffer. */
+	if (buffer == NULL)
+		return (-EINVAL);
+
+	/* Invalid buffer size. */
+	if ((size == 0) || (size > KMAILBOX_MESSAGE_SIZE))
+		return (-EINVAL);
+
+	NANVIX_TRACE_BEGIN(NANVIX_TRACE_KMAILBOX_READ, mbxid);
+
+	kclock(&t0);
+
+	/* Local delivery as well. */
+	if ((port = kmailbox_local_port(mbxid, false)) >= 0)
+	{
+		if ((ret = kmailbox_local_read(mbxid, port, buffer, size, false)) < 0)
+			goto out;
+
+		/* Delivered through the NoC. */
+		if (ret == 0)
+			port = -1;
+	}
+
+	/* Delivery through the NoC only. */
+	else
+	{
+		/* Repeat while reading valid messages for another ports. */
+		do
+		{
+			if ((ret = kmailbox_aread(mbxid, buffer, size)) < 0)
+				goto out;
+		} while ((ret = kmailbox_wait(mbxid)) > 0);
+
+		/* Wait failed. */
+		if (ret < 0)
+			goto out;
+	}
+
 #if __NANVIX_IKC_USES_ONLY_MAILBOX
-	spinlock_lock(&global_lock);
-		if (user_mailboxes[mbxid])
-			mailbox_counters.nreads++;
-	spinlock_unlock(&global_lock);
+	if (user_mailboxes[mbxid])
+		NANVIX_COUNTERS_INC(mailbox_counters, MAILBOX_COUNTER_NREADS);
+#endif /* __NANVIX_IKC_USES_ONLY_MAILBOX */
+
+	kclock(&t1);
+
+	/* Local deliveries bypass the kernel and kmailbox_wait(). */
+	if (port >= 0)
+	{
+		NANVIX_HISTOGRAM_RECORD(&kmailbox_histograms[mbxid], t1 - t0);
+		kmailbox_local_account(mbxid, size, t1 - t0);
+	}
+
+	ret = size;
+
+out:
+	NANVIX_TRACE_END(NANVIX_TRACE_KMAILBOX_READ, mbxid, ret);
+
+	return (ret);
+}
+
+/*----------------------------------------------------------------------------*
+ * do_kmailbox_tryread()                                                      *
+ *----------------------------------------------------------------------------*/
+
+PRIVATE ssize_t do_kmailbox_tryread(int mbxid, void * buffer, size_t size)
+{
+	int ret;
+	int port;
+	uint64_t t0;
+	uint64_t t1;
+
+	/* Invalid buffer. */
+	if (buffer == NULL)
+		return (-EINVAL);
+
+	/* Invalid buffer size. */
+	if ((size == 0) || (size > KMAILBOX_MESSAGE_SIZE))
+		return (-EINVAL);
+
+	if ((port = kmailbox_local_port(mbxid, false)) >= 0)
+	{
+		kclock(&t0);
+
+		if ((ret = kmailbox_local_read(mbxid, port, buffer, size, true)) < 0)
+			return (ret);
+
+		kclock(&t1);
+
+		/* Local deliveries bypass the kernel. */
+		if (ret == 1)
+			kmailbox_local_account(mbxid, size, t1 - t0);
+	}
+	else if ((ret = kmailbox_noc_tryread(mbxid, buffer, size)) < 0)
+		return (ret);
+
+#if __NANVIX_IKC_USES_ONLY_MAILBOX
+	if (user_mailboxes[mbxid])
+		NANVIX_COUNTERS_INC(mailbox_counters, MAILBOX_COUNTER_NREADS);
 #endif /* __NANVIX_IKC_USES_ONLY_MAILBOX */
 
 	return (size);
 }
 
+/*----------------------------------------------------------------------------*
+ * kmailbox_coalesce_read()                                                   *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Unpacks a message from the frame of an input mailbox.
+ *
+ * @param mbxid    Target input mailbox.
+ * @param buffer   Target buffer.
+ * @param size     Size of @p buffer.
+ * @param nonblock Fail with -EAGAIN instead of waiting for a frame?
+ *
+ * @returns Upon successful completion, the size of the message is
+ * returned. Upon failure, a negative error code is returned instead.
+ */
+PRIVATE ssize_t kmailbox_coalesce_read(int mbxid, void * buffer, size_t size, bool nonblock)
+{
+	ssize_t ret;
+	uint16_t len;
+	char frame[KMAILBOX_MESSAGE_SIZE];
+
+	/* Invalid buffer. */
+	if (buffer == NULL)
+		return (-EINVAL);
+
+	/* Invalid buffer size. */
+	if ((size == 0) || (size > KMAILBOX_MESSAGE_SIZE))
+		return (-EINVAL);
+
+	spinlock_lock(&kmailbox_coalescers[mbxid].lock);
+
+		do
+		{
+			len = 0;
+
+			if ((kmailbox_coalescers[mbxid].next + KMAILBOX_COALESCE_HEADER_SIZE) <= kmailbox_coalescers[mbxid].used)
+			{
+				kmemcpy(
+					&len,
+					&kmailbox_coalescers[mbxid].frame[kmailbox_coalescers[mbxid].next],
+					KMAILBOX_COALESCE_HEADER_SIZE
+				);
+			}
+
+			/* Frame exhausted. */
+			if (len == 0)
+			{
+				/* Another reader is receiving the next frame. */
+				if (kmailbox_coalescers[mbxid].flushing)
+				{
+					if (nonblock)
+					{
+						ret = (-EAGAIN);
+						goto error;
+					}
+
+					spinlock_unlock(&kmailbox_coalescers[mbxid].lock);
+					spinlock_lock(&kmailbox_coalescers[mbxid].lock);
+
+					continue;
+				}
+
+				kmailbox_coalescers[mbxid].used     = 0;
+				kmailbox_coalescers[mbxid].next     = 0;
+				kmailbox_coalescers[mbxid].flushing = true;
+
+				/* Other threads may use the mailbox while this one waits. */
+				spinlock_unlock(&kmailbox_coalescers[mbxid].lock);
+
+					ret = (nonblock) ?
+						do_kmailbox_tryread(mbxid, frame, KMAILBOX_MESSAGE_SIZE) :
+						do_kmailbox_read(mbxid, frame, KMAILBOX_MESSAGE_SIZE);
+
+				spinlock_lock(&kmailbox_coalescers[mbxid].lock);
+
+				/* Mailbox was reset meanwhile. */
+				if (!kmailbox_coalescers[mbxid].flushing)
+				{
+					ret = (ret < 0) ? ret : (-EBADF);
+					goto error;
+				}
+
+				kmailbox_coalescers[mbxid].flushing = false;
+
+				if (ret < 0)
+					goto error;
+
+				kmemcpy(kmailbox_coalescers[mbxid].frame, frame, KMAILBOX_MESSAGE_SIZE);
+				kmailbox_coalescers[mbxid].used = KMAILBOX_MESSAGE_SIZE;
+			}
+		} while (len == 0);
+
+		kmailbox_coalescers[mbxid].next += KMAILBOX_COALESCE_HEADER_SIZE;
+
+		/* Bad message. */
+		if (((kmailbox_coalescers[mbxid].next + len) > kmailbox_coalescers[mbxid].used) || (len > size))
+		{
+			kmailbox_coalescers[mbxid].next += len;
+			ret = (-EINVAL);
+			goto error;
+		}
+
+		kmemcpy(buffer, &kmailbox_coalescers[mbxid].frame[kmailbox_coalescers[mbxid].next], len);
+		kmailbox_coalescers[mbxid].next += len;
+
+		ret = len;
+
+error:
+	spinlock_unlock(&kmailbox_coalescers[mbxid].lock);
+
+	return (ret);
+}
+
+/*----------------------------------------------------------------------------*
+ * kmailbox_read()                                                            *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @details The kmailbox_read() synchronously read @p size bytes of
+ * data pointed to by @p buffer from the input mailbox @p mbxid. If the
+ * mailbox coalesces messages, the next message of the current frame is
+ * read instead, and its size is returned.
+ */
+ssize_t kmailbox_read(int mbxid, void * buffer, size_t size)
+{
+	/* Don't wait for a reply to a packed message. */
+	kmailbox_flush_all();
+
+	if (kmailbox_is_coalescing(mbxid))
+		return (kmailbox_coalesce_read(mbxid, buffer, size, false));
+
+	return (do_kmailbox_read(mbxid, buffer, size));
+}
+
+/*----------------------------------------------------------------------------*
+ * kmailbox_tryread()                                                         *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @details The kmailbox_tryread() reads @p size bytes of data pointed
+ * to by @p buffer from the input mailbox @p mbxid, if a message for it
+ * is already available. A message for another port is demultiplexed by
+ * the kernel and does not complete the read.
+ */
+ssize_t kmailbox_tryread(int mbxid, void * buffer, size_t size)
+{
+	if (kmailbox_is_coalescing(mbxid))
+		return (kmailbox_coalesce_read(mbxid, buffer, size, true));
+
+	return (do_kmailbox_tryread(mbxid, buffer, size));
+}
+
 /*============================================================================*
  * kmailbox_ioctl()                                                           *
  *============================================================================*/
@@ -366,6 +1458,184 @@ PRIVATE int kmailbox_ioctl_valid(void * ptr, size_t size)
 	return ((ptr != NULL) && mm_check_area(VADDR(ptr), size, UMEM_AREA));
 }
 
+#if __NANVIX_IKC_STATS
+
+/**
+ * @brief Serves a latency histogram request.
+ *
+ * @param mbxid   Target mailbox.
+ * @param request Request.
+ * @param args    Additional arguments.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+PRIVATE int kmailbox_ioctl_histogram(int mbxid, unsigned request, va_list args)
+{
+	struct nanvix_histogram_summary * summary;
+
+	/* Bad mailbox. */
+	if (kcomm_get_port(mbxid, COMM_TYPE_MAILBOX) < 0)
+		return (-EBADF);
+
+	/* Discard samples. */
+	if (request == KMAILBOX_IOCTL_RESET_HISTOGRAM)
+	{
+		nanvix_histogram_reset(&kmailbox_histograms[mbxid]);
+		return (0);
+	}
+
+	summary = va_arg(args, struct nanvix_histogram_summary *);
+
+	/* Bad buffer. */
+	if (!kmailbox_ioctl_valid(summary, sizeof(struct nanvix_histogram_summary)))
+		return (-EFAULT);
+
+	nanvix_histogram_summary(&kmailbox_histograms[mbxid], summary);
+
+	return (0);
+}
+
+#endif /* __NANVIX_IKC_STATS */
+
+/**
+ * @brief Serves a wait policy request.
+ *
+ * @param mbxid   Target mailbox.
+ * @param request Request.
+ * @param args    Additional arguments.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+PRIVATE int kmailbox_ioctl_backoff(int mbxid, unsigned request, va_list args)
+{
+	int policy;
+	int * ppolicy;
+
+	/* Bad mailbox. */
+	if (kcomm_get_port(mbxid, COMM_TYPE_MAILBOX) < 0)
+		return (-EBADF);
+
+	if (request == KMAILBOX_IOCTL_SET_BACKOFF)
+	{
+		policy = va_arg(args, int);
+
+		/* Invalid policy. */
+		if (!NANVIX_BACKOFF_IS_VALID(policy))
+			return (-EINVAL);
+
+		kmailbox_backoffs[mbxid] = policy;
+
+		return (0);
+	}
+
+	ppolicy = va_arg(args, int *);
+
+	/* Bad buffer. */
+	if (!kmailbox_ioctl_valid(ppolicy, sizeof(int)))
+		return (-EFAULT);
+
+	*ppolicy = kmailbox_backoffs[mbxid];
+
+	return (0);
+}
+
+/**
+ * @brief Serves a coalescing request.
+ *
+ * @param mbxid   Target mailbox.
+ * @param request Request.
+ * @param args    Additional arguments.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+PRIVATE int kmailbox_ioctl_coalescing(int mbxid, unsigned request, va_list args)
+{
+	int ret;
+	uint64_t deadline;
+	uint64_t * pdeadline;
+
+	/* Coalescing compiled out. */
+	if (!__NANVIX_IKC_COALESCING)
+		return (-ENOTSUP);
+
+	/* Bad mailbox. */
+	if (kcomm_get_port(mbxid, COMM_TYPE_MAILBOX) < 0)
+		return (-EBADF);
+
+	if (request == KMAILBOX_IOCTL_SET_COALESCING)
+	{
+		deadline = va_arg(args, uint64_t);
+		ret      = 0;
+
+		spinlock_lock(&kmailbox_coalescers[mbxid].lock);
+
+			/* Sends packed messages. */
+			if (kmailbox_coalescers[mbxid].output)
+				ret = do_kmailbox_flush(mbxid);
+
+			/* Unread messages would be lost. */
+			else if ((deadline == 0) && (kmailbox_coalescers[mbxid].next < kmailbox_coalescers[mbxid].used))
+				ret = (-EBUSY);
+
+			if (ret == 0)
+				kmailbox_coalescers[mbxid].deadline = deadline;
+
+		spinlock_unlock(&kmailbox_coalescers[mbxid].lock);
+
+		return (ret);
+	}
+
+	pdeadline = va_arg(args, uint64_t *);
+
+	/* Bad buffer. */
+	if (!kmailbox_ioctl_valid(pdeadline, sizeof(uint64_t)))
+		return (-EFAULT);
+
+	*pdeadline = kmailbox_coalescers[mbxid].deadline;
+
+	return (0);
+}
+
+/**
+ * @brief Adds local deliveries to a volume or latency request.
+ *
+ * @param mbxid   Target mailbox.
+ * @param request Request.
+ * @param args    Arguments of the request.
+ */
+PRIVATE void kmailbox_ioctl_local(int mbxid, unsigned request, va_list args)
+{
+	size_t * volume;
+	uint64_t * latency;
+
+	/* Invalid mailbox. */
+	if (!WITHIN(mbxid, 0, KMAILBOX_MAX))
+		return;
+
+	switch (request)
+	{
+		case KMAILBOX_IOCTL_GET_VOLUME:
+			volume = va_arg(args, size_t *);
+			spinlock_lock(&kmailbox_local_binds[mbxid].lock);
+				*volume += kmailbox_local_binds[mbxid].volume;
+			spinlock_unlock(&kmailbox_local_binds[mbxid].lock);
+			break;
+
+		case KMAILBOX_IOCTL_GET_LATENCY:
+			latency = va_arg(args, uint64_t *);
+			spinlock_lock(&kmailbox_local_binds[mbxid].lock);
+				*latency += kmailbox_local_binds[mbxid].latency;
+			spinlock_unlock(&kmailbox_local_binds[mbxid].lock);
+			break;
+
+		default:
+			break;
+	}
+}
+
 /**
  * @details The kmailbox_ioctl() reads the measurement parameter associated
  * with the request id @p request of the mailbox @p mbxid.
@@ -374,9 +1644,41 @@ int kmailbox_ioctl(int mbxid, unsigned request, ...)
 {
 	int ret;
 	va_list args;
+	va_list local;
 
 	va_start(args, request);
 
+	/* Latency histograms are kept in user space. */
+	if ((request == KMAILBOX_IOCTL_GET_HISTOGRAM) || (request == KMAILBOX_IOCTL_RESET_HISTOGRAM))
+	{
+#if __NANVIX_IKC_STATS
+		ret = kmailbox_ioctl_histogram(mbxid, request, args);
+#else
+		ret = (-ENOTSUP);
+#endif /* __NANVIX_IKC_STATS */
+		va_end(args);
+
+		return (ret);
+	}
+
+	/* So are wait policies. */
+	if ((request == KMAILBOX_IOCTL_SET_BACKOFF) || (request == KMAILBOX_IOCTL_GET_BACKOFF))
+	{
+		ret = kmailbox_ioctl_backoff(mbxid, request, args);
+		va_end(args);
+
+		return (ret);
+	}
+
+	/* And coalescing. */
+	if ((request == KMAILBOX_IOCTL_SET_COALESCING) || (request == KMAILBOX_IOCTL_GET_COALESCING))
+	{
+		ret = kmailbox_ioctl_coalescing(mbxid, request, args);
+		va_end(args);
+
+		return (ret);
+	}
+
 #if __NANVIX_IKC_USES_ONLY_MAILBOX
 	spinlock_lock(&global_lock);
 
@@ -389,6 +1691,8 @@ int kmailbox_ioctl(int mbxid, unsigned request, ...)
 			{
 #endif /* __NANVIX_IKC_USES_ONLY_MAILBOX */
 
+				va_copy(local, args);
+
 				dcache_invalidate();
 
 				ret = kcall3(
@@ -400,6 +1704,12 @@ int kmailbox_ioctl(int mbxid, unsigned request, ...)
 
 				dcache_invalidate();
 
+				/* Local deliveries bypass the kernel. */
+				if (ret == 0)
+					kmailbox_ioctl_local(mbxid, request, local);
+
+				va_end(local);
+
 #if __NANVIX_IKC_USES_ONLY_MAILBOX
 			} break;
 
@@ -428,29 +1738,31 @@ int kmailbox_ioctl(int mbxid, unsigned request, ...)
 
 				switch(request)
 				{
+#if __NANVIX_IKC_STATS
 					case KMAILBOX_IOCTL_GET_NCREATES:
-						*var = mailbox_counters.ncreates;
+						*var = nanvix_counters_get(&mailbox_counters, MAILBOX_COUNTER_NCREATES);
 						break;
 
 					case KMAILBOX_IOCTL_GET_NUNLINKS:
-						*var = mailbox_counters.nunlinks;
+						*var = nanvix_counters_get(&mailbox_counters, MAILBOX_COUNTER_NUNLINKS);
 						break;
 
 					case KMAILBOX_IOCTL_GET_NOPENS:
-						*var = mailbox_counters.nopens;
+						*var = nanvix_counters_get(&mailbox_counters, MAILBOX_COUNTER_NOPENS);
 						break;
 
 					case KMAILBOX_IOCTL_GET_NCLOSES:
-						*var = mailbox_counters.ncloses;
+						*var = nanvix_counters_get(&mailbox_counters, MAILBOX_COUNTER_NCLOSES);
 						break;
 
 					case KMAILBOX_IOCTL_GET_NREADS:
-						*var = mailbox_counters.nreads;
+						*var = nanvix_counters_get(&mailbox_counters, MAILBOX_COUNTER_NREADS);
 						break;
 
 					case KMAILBOX_IOCTL_GET_NWRITES:
-						*var = mailbox_counters.nwrites;
+						*var = nanvix_counters_get(&mailbox_counters, MAILBOX_COUNTER_NWRITES);
 						break;
+#endif /* __NANVIX_IKC_STATS */
 
 					/* Operation not supported. */
 					default:
@@ -530,14 +1842,16 @@ PUBLIC void kmailbox_init(void)
 {
 	kprintf("[user][mailbox] Initializes mailbox module");
 
-#if __NANVIX_IKC_USES_ONLY_MAILBOX
-	mailbox_counters.ncreates = 0ULL;
-	mailbox_counters.nunlinks = 0ULL;
-	mailbox_counters.nopens   = 0ULL;
-	mailbox_counters.ncloses  = 0ULL;
-	mailbox_counters.nreads   = 0ULL;
-	mailbox_counters.nwrites  = 0ULL;
-#endif /* __NANVIX_IKC_USES_ONLY_MAILBOX */
+	for (int i = 0; i < KMAILBOX_MAX; ++i)
+	{
+		nanvix_histogram_init(&kmailbox_histograms[i]);
+		kmailbox_backoffs[i] = NANVIX_BACKOFF_DEFAULT;
+		kmailbox_local_binds[i].port = -1;
+	}
+
+#if __NANVIX_IKC_USES_ONLY_MAILBOX && __NANVIX_IKC_STATS
+	nanvix_counters_reset(&mailbox_counters);
+#endif /* __NANVIX_IKC_USES_ONLY_MAILBOX && __NANVIX_IKC_STATS */
 }
 
 #else
@@ -29,10 +29,14 @@
 
 #if __TARGET_HAS_MAILBOX && __NANVIX_IKC_USES_ONLY_MAILBOX
 
+#include <nanvix/sys/counters.h>
 #include <nanvix/sys/perf.h>
 #include <nanvix/sys/noc.h>
 #include <nanvix/sys/mailbox.h>
 #include <nanvix/sys/portal.h>
+#include <nanvix/sys/progress.h>
+#include <nanvix/sys/thread.h>
+#include <nanvix/sys/trace.h>
 #include <posix/errno.h>
 
 /**
@@ -44,51 +48,59 @@ PRIVATE bool kportal_is_initialized = false;
  * @name Protections.
  */
 /**@{*/
-PRIVATE spinlock_t global_lock            = SPINLOCK_UNLOCKED;
-PRIVATE spinlock_t local_lock             = SPINLOCK_UNLOCKED;
-PRIVATE spinlock_t allow_lock             = SPINLOCK_UNLOCKED;
-PRIVATE spinlock_t buffer_lock            = SPINLOCK_UNLOCKED;
-PRIVATE spinlock_t read_lock[PROCESSOR_NOC_NODES_NUM] = {
-	[0 ... (PROCESSOR_NOC_NODES_NUM - 1)] = SPINLOCK_UNLOCKED
-};
-PRIVATE spinlock_t write_lock[PROCESSOR_NOC_NODES_NUM] = {
-	[0 ... (PROCESSOR_NOC_NODES_NUM - 1)] = SPINLOCK_UNLOCKED
-};
+PRIVATE spinlock_t global_lock ALIGN(CACHE_LINE_SIZE) = SPINLOCK_UNLOCKED;
+PRIVATE spinlock_t local_lock  ALIGN(CACHE_LINE_SIZE) = SPINLOCK_UNLOCKED;
+PRIVATE spinlock_t allow_lock  ALIGN(CACHE_LINE_SIZE) = SPINLOCK_UNLOCKED;
+PRIVATE spinlock_t buffer_lock ALIGN(CACHE_LINE_SIZE) = SPINLOCK_UNLOCKED;
 /**@}*/
 
 /**
- * @name Mailbox channels.
+ * @brief Input mailbox of allows.
  */
-/**@{*/
 PRIVATE int mallow_in = -1;
-PRIVATE int mallow_outs[PROCESSOR_NOC_NODES_NUM] = {
-	[0 ... (PROCESSOR_NOC_NODES_NUM - 1)] = -1,
-};
-PRIVATE int mdata_ins[PROCESSOR_NOC_NODES_NUM] = {
-	[0 ... (PROCESSOR_NOC_NODES_NUM - 1)] = -1,
-};
-PRIVATE int mdata_outs[PROCESSOR_NOC_NODES_NUM] = {
-	[0 ... (PROCESSOR_NOC_NODES_NUM - 1)] = -1,
-};
-/**@}*/
 
 /**
- * @name Fair use of read channels.
+ * @brief Receive side of the channel with a remote node.
+ *
+ * Each record is padded to a cache line, so that cores serving
+ * different remotes do not invalidate each other.
  */
-/**@{*/
-PRIVATE struct resource read_channels[PROCESSOR_NOC_NODES_NUM] = {
-	[0 ... (PROCESSOR_NOC_NODES_NUM - 1)] = {0, }
-};
-PRIVATE struct resource write_channels[PROCESSOR_NOC_NODES_NUM] = {
-	[0 ... (PROCESSOR_NOC_NODES_NUM - 1)] = {0, }
+PRIVATE struct mportal_rx
+{
+	spinlock_t lock;          /**< Read lock.                                     */
+	int mdata;                /**< Input mailbox of data.                         */
+	struct resource resource; /**< Fair use of the channel.                       */
+	bool allow_pending;       /**< Was an allow sent and no header read yet?      */
+} ALIGN(CACHE_LINE_SIZE) rx_channels[PROCESSOR_NOC_NODES_NUM] = {
+	[0 ... (PROCESSOR_NOC_NODES_NUM - 1)] = {
+		.lock          = SPINLOCK_UNLOCKED,
+		.mdata         = -1,
+		.resource      = {0, },
+		.allow_pending = false,
+	},
 };
-/**@}*/
 
 /**
- * @brief Write control.
+ * @brief Transmit side of the channel with a remote node.
+ *
+ * Kept apart from the receive side, as both are used by different
+ * threads at the same time.
  */
-PRIVATE bool remote_is_allowed[PROCESSOR_NOC_NODES_NUM] = {
-	[0 ... (PROCESSOR_NOC_NODES_NUM - 1)] = false
+PRIVATE struct mportal_tx
+{
+	spinlock_t lock;          /**< Write lock.                                    */
+	int mallow;               /**< Output mailbox of allows.                      */
+	int mdata;                /**< Output mailbox of data.                        */
+	struct resource resource; /**< Fair use of the channel.                       */
+	bool allowed;             /**< Did the remote allow a write?                  */
+} ALIGN(CACHE_LINE_SIZE) tx_channels[PROCESSOR_NOC_NODES_NUM] = {
+	[0 ... (PROCESSOR_NOC_NODES_NUM - 1)] = {
+		.lock     = SPINLOCK_UNLOCKED,
+		.mallow   = -1,
+		.mdata    = -1,
+		.resource = {0, },
+		.allowed  = false,
+	},
 };
 
 /*============================================================================*
@@ -96,17 +108,25 @@ PRIVATE bool remote_is_allowed[PROCESSOR_NOC_NODES_NUM] = {
  *============================================================================*/
 
 /**
- * @brief Communicator counters.
+ * @name Communicator counters.
  */
-PRIVATE struct
-{
-	uint64_t ncreates; /**< Number of creates. */
-	uint64_t nunlinks; /**< Number of unlinks. */
-	uint64_t nopens;   /**< Number of opens.   */
-	uint64_t ncloses;  /**< Number of closes.  */
-	uint64_t nreads;   /**< Number of reads.   */
-	uint64_t nwrites;  /**< Number of writes.  */
-} mportal_counters;
+/**@{*/
+#define MPORTAL_COUNTER_NCREATES 0 /**< Number of creates. */
+#define MPORTAL_COUNTER_NUNLINKS 1 /**< Number of unlinks. */
+#define MPORTAL_COUNTER_NOPENS   2 /**< Number of opens.   */
+#define MPORTAL_COUNTER_NCLOSES  3 /**< Number of closes.  */
+#define MPORTAL_COUNTER_NREADS   4 /**< Number of reads.   */
+#define MPORTAL_COUNTER_NWRITES  5 /**< Number of writes.  */
+/**@}*/
+
+#if __NANVIX_IKC_STATS
+
+/**
+ * @brief Communicator counters, sharded per thread.
+ */
+PRIVATE struct nanvix_counters mportal_counters;
+
+#endif /* __NANVIX_IKC_STATS */
 
 /*============================================================================*
  * Portal configuration                                                       *
@@ -153,6 +173,8 @@ PRIVATE struct mportal
 	int mallow;                   /**< Mailbox channel to allow.        */
 	int mdata;                    /**< Mailbox channel to data.         */
 	struct mportal_config config; /**< Configuration.                   */
+	int backoff;                  /**< Wait policy.                     */
+	kthread_t waiter;             /**< Thread asleep on the engine.     */
 	/**@}*/
 
 	/**
@@ -161,8 +183,9 @@ PRIVATE struct mportal
 	/**@{*/
 	size_t volume;                /**< Volume.                          */
 	uint64_t latency;             /**< Latency.                         */
+	struct nanvix_histogram hist; /**< Latency histogram.               */
 	/**@}*/
-} ALIGN(sizeof(dword_t)) mportals[KPORTAL_MAX] = {
+} ALIGN(CACHE_LINE_SIZE) mportals[KPORTAL_MAX] = {
 	[0 ... (KPORTAL_MAX - 1)] = {
 		.resource  = {0, },
 		.refcount  = 0,
@@ -171,6 +194,8 @@ PRIVATE struct mportal
 		.volume    = 0ULL,
 		.latency   = 0ULL,
 		.config    = {-1, -1, -1, -1},
+		.backoff   = NANVIX_BACKOFF_DEFAULT,
+		.waiter    = -1,
 	},
 };
 
@@ -471,11 +496,11 @@ PRIVATE struct mportal_buffer * do_kportal_buffer_search(struct mportal * portal
 {
 	struct mportal_buffer * buf; /* Auxiliar buffer pointer. */
 
-	if (!node_is_local(portal->config.local))
+	if (!IKC_NODE_IS_LOCAL(portal->config.local))
 		kportal_print_message("kportal_buffer_search failed", &portal->config);
 
 	/* Sanity checks. */
-	KASSERT(node_is_local(portal->config.local));
+	KASSERT(IKC_NODE_IS_LOCAL(portal->config.local));
 
 	buf = NULL;
 
@@ -596,7 +621,7 @@ PRIVATE ssize_t kportal_buffer_read(
 			kclock(&t0);
 				kmemcpy(*buffer, buf->data, buf->size);
 			kclock(&t1);
-			portal->latency += node_is_local(buf->config.local) ? (t1 - t0) : (buf->latency);
+			portal->latency += IKC_NODE_IS_LOCAL(buf->config.local) ? (t1 - t0) : (buf->latency);
 
 			/* Updates parameters. */
 			copied     += buf->size;
@@ -628,11 +653,11 @@ error:
 
 PRIVATE int kportal_search(struct mportal_config * config, int input)
 {
-	if (!node_is_local(config->local))
+	if (!IKC_NODE_IS_LOCAL(config->local))
 		kportal_print_message("kportal_search failed", config);
 
 	/* Sanity checks. */
-	KASSERT(node_is_local(config->local));
+	KASSERT(IKC_NODE_IS_LOCAL(config->local));
 
 	for (unsigned i = 0; i < KPORTAL_MAX; ++i)
 	{
@@ -721,9 +746,11 @@ PUBLIC int kportal_create(int local, int local_port)
 			mportals[portalid].volume   = 0ULL;
 			mportals[portalid].latency  = 0ULL;
 			mportals[portalid].config   = config;
+			mportals[portalid].backoff  = NANVIX_BACKOFF_DEFAULT;
+			nanvix_histogram_reset(&mportals[portalid].hist);
 			resource_set_rdonly(&mportals[portalid].resource);
 
-			mportal_counters.ncreates++;
+			NANVIX_COUNTERS_INC_LOCKED(mportal_counters, MPORTAL_COUNTER_NCREATES);
 		}
 
 	spinlock_unlock(&global_lock);
@@ -749,8 +776,8 @@ PUBLIC int kportal_allow(int portalid, int remote, int remote_port)
 	if (!WITHIN(portalid, 0, KPORTAL_MAX))
 		return (-EINVAL);
 
-	/* Invalid local. */
-	if (!node_is_valid(remote))
+	/* Invalid remote, or a remote node in a single-node build. */
+	if (__NANVIX_IKC_SINGLE_NODE ? !node_is_local(remote) : !node_is_valid(remote))
 		return (-EINVAL);
 
 	/* Invalid portid. */
@@ -779,8 +806,8 @@ PUBLIC int kportal_allow(int portalid, int remote, int remote_port)
 		if (mportals[portalid].config.remote != -1)
 			goto error;
 
-		mportals[portalid].mallow             = mallow_outs[remote];
-		mportals[portalid].mdata              = mdata_ins[remote];
+		mportals[portalid].mallow             = tx_channels[remote].mallow;
+		mportals[portalid].mdata              = rx_channels[remote].mdata;
 		mportals[portalid].config.remote      = remote;
 		mportals[portalid].config.remote_port = remote_port;
 		ret = (0);
@@ -811,8 +838,8 @@ PUBLIC int kportal_open(int local, int remote, int remote_port)
 	if (!node_is_valid(local))
 		return (-EINVAL);
 
-	/* Invalid remote. */
-	if (!node_is_valid(remote))
+	/* Invalid remote, or a remote node in a single-node build. */
+	if (__NANVIX_IKC_SINGLE_NODE ? !node_is_local(remote) : !node_is_valid(remote))
 		return (-EINVAL);
 
 	/* Invalid local number for the requesting core ID. */
@@ -850,14 +877,16 @@ PUBLIC int kportal_open(int local, int remote, int remote_port)
 		else if ((portalid = resource_alloc(&mportalpool)) >= 0)
 		{
 			mportals[portalid].mallow   = mallow_in;
-			mportals[portalid].mdata    = mdata_outs[remote];
+			mportals[portalid].mdata    = tx_channels[remote].mdata;
 			mportals[portalid].refcount = 1;
 			mportals[portalid].volume   = 0;
 			mportals[portalid].latency  = 0;
 			mportals[portalid].config   = config;
+			mportals[portalid].backoff  = NANVIX_BACKOFF_DEFAULT;
+			nanvix_histogram_reset(&mportals[portalid].hist);
 			resource_set_wronly(&mportals[portalid].resource);
 
-			mportal_counters.nopens++;
+			NANVIX_COUNTERS_INC_LOCKED(mportal_counters, MPORTAL_COUNTER_NOPENS);
 		}
 
 error:
@@ -916,7 +945,7 @@ PUBLIC int kportal_unlink(int portalid)
 			resource_free(&mportalpool, portalid);
 		}
 
-		mportal_counters.nunlinks++;
+		NANVIX_COUNTERS_INC_LOCKED(mportal_counters, MPORTAL_COUNTER_NUNLINKS);
 		ret = (0);
 
 error:
@@ -975,7 +1004,7 @@ PUBLIC int kportal_close(int portalid)
 			resource_free(&mportalpool, portalid);
 		}
 
-		mportal_counters.ncloses++;
+		NANVIX_COUNTERS_INC_LOCKED(mportal_counters, MPORTAL_COUNTER_NCLOSES);
 		ret = (0);
 
 error:
@@ -1010,7 +1039,12 @@ PRIVATE int do_aread_message_drop(int mbxid, struct mportal_config * config)
  * do_kportal_aread()                                                         *
  *----------------------------------------------------------------------------*/
 
-PRIVATE ssize_t do_kportal_aread(struct mportal * portal, void * buffer, size_t size)
+PRIVATE ssize_t do_kportal_aread(
+	struct mportal * portal,
+	void * buffer,
+	size_t size,
+	bool nonblock
+)
 {
 	ssize_t ret;                    /* Return value.                            */
 	void * data;                    /* Auxiliar buffer pointer.                 */
@@ -1022,11 +1056,14 @@ PRIVATE ssize_t do_kportal_aread(struct mportal * portal, void * buffer, size_t
 	struct mportal_message message; /* Message buffer.                          */
 	struct mportal_config config;   /* Configuration pointer.                   */
 	uint64_t l0, l1;                /* Latency.                                 */
+	bool contended;                 /* Was the channel busy?                    */
+	struct nanvix_backoff backoff;  /* Wait for free buffers.                   */
 
 	/* Valid portal. */
 	KASSERT(portal && node_is_valid(portal->config.remote));
 
 	buffering = true;
+	contended = false;
 	remote    = portal->config.remote;
 
 again:
@@ -1047,6 +1084,9 @@ again:
 		/* Is the read complete? */
 		if (ret < 0 || received == 0)
 			goto exit;
+
+		/* Data is flowing, so finish the read. */
+		nonblock = false;
 	}
 
 	/* Intermediary read from buffers. */
@@ -1054,34 +1094,85 @@ again:
 		goto again;
 
 again2:
-	spinlock_lock(&read_lock[remote]);
+	spinlock_lock(&rx_channels[remote].lock);
 
 		/* Reads buffered message. */
 		if ((ret = kportal_buffer_read(portal, &buffer, &received, &buf)) != 0)
 		{
 			/* Is it copied correctly? */
-			ret = (ret < 0) ? (ret) : ((received != 0) ? (ret) : (ssize_t)(size));
+			ret      = (ret < 0) ? (ret) : ((received != 0) ? (ret) : (ssize_t)(size));
+			nonblock = false;
 			goto exit;
 		}
 
+		/* The progress engine receives data. */
+		if (nanvix_ikc_progress_is_running())
+		{
+			/* Allows, unless a previous try already did. */
+			if (!rx_channels[remote].allow_pending)
+			{
+				if ((ret = kmailbox_write(portal->mallow, &portal->config, MPORTAL_CONFIG_SIZE)) < 0)
+					goto exit;
+
+				rx_channels[remote].allow_pending = true;
+			}
+
+			ret = (-EAGAIN);
+
+			if (nonblock)
+				goto exit;
+
+			portal->waiter = kthread_self();
+
+			spinlock_unlock(&rx_channels[remote].lock);
+
+			ksleep();
+
+			goto again2;
+		}
+
 		/* Is the channel busy? */
-		if (resource_is_busy(&read_channels[remote]))
+		if (resource_is_busy(&rx_channels[remote].resource))
 		{
-			spinlock_unlock(&read_lock[remote]);
+			spinlock_unlock(&rx_channels[remote].lock);
+
+			/* Another reader owns the channel. */
+			if (nonblock)
+				return (-EAGAIN);
+
+			if (!contended)
+			{
+				contended = true;
+				NANVIX_TRACE_INSTANT(NANVIX_TRACE_LOCK_CONTENTION, portal - mportals, remote);
+			}
+
 			goto again2;
 		}
 
 		/* Set channel busy. */
-		resource_set_busy(&read_channels[remote]);
+		resource_set_busy(&rx_channels[remote].resource);
 
-		/* Allows. */
-		if ((ret = kmailbox_write(portal->mallow, &portal->config, MPORTAL_CONFIG_SIZE)) < 0)
-			goto release;
+		/* Allows, unless a previous try already did. */
+		if (!rx_channels[remote].allow_pending)
+		{
+			if ((ret = kmailbox_write(portal->mallow, &portal->config, MPORTAL_CONFIG_SIZE)) < 0)
+				goto release;
+
+			rx_channels[remote].allow_pending = true;
+		}
 
 		/* Reads header. */
-		if ((ret = kmailbox_read(portal->mdata, &message, MPORTAL_MESSAGE_SIZE)) < 0)
+		if (nonblock)
+			ret = kmailbox_tryread(portal->mdata, &message, MPORTAL_MESSAGE_SIZE);
+		else
+			ret = kmailbox_read(portal->mdata, &message, MPORTAL_MESSAGE_SIZE);
+
+		if (ret < 0)
 			goto release;
 
+		/* The allow was consumed by the remote. */
+		rx_channels[remote].allow_pending = false;
+
 		/* Sanity check. */
 		KASSERT(message.header || !message.eof);
 
@@ -1107,7 +1198,9 @@ again2:
 		/* Buffering mode allocates a auxiliar buffer. */
 		if (buffering)
 		{
-			while ((buf = kportal_buffer_alloc(NULL, &message._.config)) == NULL);
+			nanvix_backoff_init(&backoff, portal->backoff);
+			while ((buf = kportal_buffer_alloc(NULL, &message._.config)) == NULL)
+				nanvix_backoff_wait(&backoff);
 			data = buf->data;
 		}
 
@@ -1129,6 +1222,8 @@ again2:
 			/* Sanity check. */
 			KASSERT(!message.header);
 
+			NANVIX_TRACE_INSTANT(NANVIX_TRACE_CHUNK_RECV, portal - mportals, message.size);
+
 			if (!buffering)
 			{
 				/* Isn't it ok read the message? */
@@ -1148,8 +1243,10 @@ again2:
 					kmemcpy(data, message._.data, (MPORTAL_BUFFER_SIZE - received));
 					buf->size += (MPORTAL_BUFFER_SIZE - received);
 
-					spinlock_unlock(&read_lock[remote]);
-						while ((buf = kportal_buffer_alloc(buf, &buf->config)) == NULL);
+					spinlock_unlock(&rx_channels[remote].lock);
+						nanvix_backoff_init(&backoff, portal->backoff);
+						while ((buf = kportal_buffer_alloc(buf, &buf->config)) == NULL)
+							nanvix_backoff_wait(&backoff);
 
 						kmemcpy(
 							buf->data,
@@ -1161,7 +1258,7 @@ again2:
 						received  = (message.size - (MPORTAL_BUFFER_SIZE - received));
 						buf->size = received;
 						data      = (buf->data + received);
-					spinlock_lock(&read_lock[remote]);
+					spinlock_lock(&rx_channels[remote].lock);
 
 					continue;
 				}
@@ -1197,9 +1294,9 @@ again2:
 		}
 
 release:
-		resource_set_notbusy(&read_channels[remote]);
+		resource_set_notbusy(&rx_channels[remote].resource);
 exit:
-	spinlock_unlock(&read_lock[remote]);
+	spinlock_unlock(&rx_channels[remote].lock);
 
 	if (ret >= 0)
 	{
@@ -1220,7 +1317,8 @@ exit:
 PRIVATE ssize_t do_kportal_aread_local(
 	struct mportal * portal,
 	void * buffer,
-	size_t size
+	size_t size,
+	bool nonblock
 )
 {
 	ssize_t ret;                      /* Return value.            */
@@ -1241,6 +1339,10 @@ again:
 		if (remainder == 0)
 			portal->volume += (ret = size);
 
+		/* Nothing was written yet. */
+		else if (nonblock && (remainder == size))
+			ret = (-EAGAIN);
+
 		/* Still reading. */
 		else if (ret >= 0)
 		{
@@ -1259,16 +1361,14 @@ error:
 }
 
 /*----------------------------------------------------------------------------*
- * kportal_aread()                                                            *
+ * do_kportal_read()                                                          *
  *----------------------------------------------------------------------------*/
 
-/**
- * @details The kportal_aread() asynchronously read @p size bytes of
- * data pointed to by @p buffer from the input portal @p portalid.
- */
-PUBLIC ssize_t kportal_aread(int portalid, void * buffer, size_t size)
+PRIVATE ssize_t do_kportal_read(int portalid, void * buffer, size_t size, bool nonblock)
 {
 	ssize_t ret;      /* Return value. */
+	uint64_t t0;      /* Clock value.  */
+	uint64_t t1;      /* Clock value.  */
 
 	/* Invalid portalid. */
 	if (!WITHIN(portalid, 0, KPORTAL_MAX))
@@ -1310,24 +1410,38 @@ PUBLIC ssize_t kportal_aread(int portalid, void * buffer, size_t size)
 
 	spinlock_unlock(&global_lock);
 
+	NANVIX_TRACE_BEGIN(NANVIX_TRACE_KPORTAL_AREAD, portalid);
+
+	kclock(&t0);
+
 	/* Is local communication? */
-	if (node_is_local(mportals[portalid].config.remote))
-		ret = do_kportal_aread_local(&mportals[portalid], buffer, size);
+	if (IKC_NODE_IS_LOCAL(mportals[portalid].config.remote))
+		ret = do_kportal_aread_local(&mportals[portalid], buffer, size, nonblock);
 	else
 	{
-		ret = do_kportal_aread(&mportals[portalid], buffer, size);
+		ret = do_kportal_aread(&mportals[portalid], buffer, size, nonblock);
 
 	}
 
+	kclock(&t1);
+
+	NANVIX_TRACE_END(NANVIX_TRACE_KPORTAL_AREAD, portalid, ret);
+
+	if (ret >= 0)
+		NANVIX_HISTOGRAM_RECORD(&mportals[portalid].hist, t1 - t0);
+
 	spinlock_lock(&global_lock);
 		/* Complete the communication allowed. */
-		mportals[portalid].mallow             = -1;
-		mportals[portalid].mdata              = -1;
-		mportals[portalid].config.remote      = -1;
-		mportals[portalid].config.remote_port = -1;
+		if (ret != (-EAGAIN))
+		{
+			mportals[portalid].mallow             = -1;
+			mportals[portalid].mdata              = -1;
+			mportals[portalid].config.remote      = -1;
+			mportals[portalid].config.remote_port = -1;
+		}
 
 		if (ret >= 0)
-			mportal_counters.nreads++;
+			NANVIX_COUNTERS_INC_LOCKED(mportal_counters, MPORTAL_COUNTER_NREADS);
 
 		resource_set_notbusy(&mportals[portalid].resource);
 error:
@@ -1336,6 +1450,35 @@ error:
 	return (ret);
 }
 
+/*----------------------------------------------------------------------------*
+ * kportal_aread()                                                            *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @details The kportal_aread() asynchronously read @p size bytes of
+ * data pointed to by @p buffer from the input portal @p portalid.
+ */
+PUBLIC ssize_t kportal_aread(int portalid, void * buffer, size_t size)
+{
+	return (do_kportal_read(portalid, buffer, size, false));
+}
+
+/*----------------------------------------------------------------------------*
+ * kportal_tryread()                                                          *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @details The kportal_tryread() reads @p size bytes of data pointed
+ * to by @p buffer from the input portal @p portalid, if the message has
+ * already started to arrive. Headers of messages to other ports that
+ * arrive meanwhile in the shared data inbox are demultiplexed into
+ * buffers, and the allow sent to the remote is kept across tries.
+ */
+PUBLIC ssize_t kportal_tryread(int portalid, void * buffer, size_t size)
+{
+	return (do_kportal_read(portalid, buffer, size, true));
+}
+
 /*============================================================================*
  * kportal_awrite()                                                           *
  *============================================================================*/
@@ -1347,7 +1490,7 @@ error:
 PRIVATE void kportal_receive_allow(struct mportal_config * config)
 {
 	/* Sanity checks. */
-	KASSERT(node_is_local(config->remote));
+	KASSERT(IKC_NODE_IS_LOCAL(config->remote));
 
 	for (unsigned i = 0; i < KPORTAL_MAX; ++i)
 	{
@@ -1360,15 +1503,15 @@ PRIVATE void kportal_receive_allow(struct mportal_config * config)
 		if (mportals[i].config.remote != config->local)
 			continue;
 
-		if (remote_is_allowed[config->local])
+		if (tx_channels[config->local].allowed)
 			kportal_print_message("Drop allow (double allowed)", config);
 		else
-			remote_is_allowed[config->local] = true;
+			tx_channels[config->local].allowed = true;
 
 		break;
 	}
 
-	if (!remote_is_allowed[config->local])
+	if (!tx_channels[config->local].allowed)
 		kportal_print_message("Drop allow (any portal opened to remote)", config);
 }
 
@@ -1377,7 +1520,7 @@ PRIVATE void kportal_receive_allow(struct mportal_config * config)
  * do_kportal_wait_allow()                                                      *
  *----------------------------------------------------------------------------*/
 
-PRIVATE int do_kportal_wait_allow(struct mportal * portal)
+PRIVATE int do_kportal_wait_allow(struct mportal * portal, bool nonblock)
 {
 	int ret;
 	bool released;
@@ -1385,19 +1528,47 @@ PRIVATE int do_kportal_wait_allow(struct mportal * portal)
 
 	released = false;
 
+	NANVIX_TRACE_BEGIN(NANVIX_TRACE_ALLOW_WAIT, portal - mportals);
+
 	while (!released)
 	{
 		spinlock_lock(&allow_lock);
 
+			/* The progress engine receives allows. */
+			if (!tx_channels[portal->config.remote].allowed && nanvix_ikc_progress_is_running())
+			{
+				/* Not allowed yet. */
+				if (nonblock)
+				{
+					spinlock_unlock(&allow_lock);
+					NANVIX_TRACE_END(NANVIX_TRACE_ALLOW_WAIT, portal - mportals, -EAGAIN);
+					return (-EAGAIN);
+				}
+
+				portal->waiter = kthread_self();
+
+				spinlock_unlock(&allow_lock);
+
+				ksleep();
+
+				continue;
+			}
+
 			/* Released. */
-			if (!remote_is_allowed[portal->config.remote])
+			if (!tx_channels[portal->config.remote].allowed)
 			{
 				ret = (-EAGAIN);
 
 				/* Waits allow message. */
-				if ((ret = kmailbox_read(portal->mallow, &config, MPORTAL_CONFIG_SIZE)) < 0)
+				if (nonblock)
+					ret = kmailbox_tryread(portal->mallow, &config, MPORTAL_CONFIG_SIZE);
+				else
+					ret = kmailbox_read(portal->mallow, &config, MPORTAL_CONFIG_SIZE);
+
+				if (ret < 0)
 				{
 					spinlock_unlock(&allow_lock);
+					NANVIX_TRACE_END(NANVIX_TRACE_ALLOW_WAIT, portal - mportals, ret);
 					return (ret);
 				}
 
@@ -1406,15 +1577,17 @@ PRIVATE int do_kportal_wait_allow(struct mportal * portal)
 			}
 
 			/* Released. */
-			if (remote_is_allowed[portal->config.remote])
+			if (tx_channels[portal->config.remote].allowed)
 			{
 				released = true;
-				remote_is_allowed[portal->config.remote] = false;
+				tx_channels[portal->config.remote].allowed = false;
 			}
 
 		spinlock_unlock(&allow_lock);
 	}
 
+	NANVIX_TRACE_END(NANVIX_TRACE_ALLOW_WAIT, portal - mportals, 0);
+
 	return (0);
 }
 
@@ -1422,7 +1595,7 @@ PRIVATE int do_kportal_wait_allow(struct mportal * portal)
  * do_kportal_awrite()                                                      *
  *----------------------------------------------------------------------------*/
 
-PRIVATE ssize_t do_kportal_awrite(struct mportal * portal, const void * buffer, size_t size)
+PRIVATE ssize_t do_kportal_awrite(struct mportal * portal, const void * buffer, size_t size, bool nonblock)
 {
 	ssize_t ret;                    /* Return value.               */
 	size_t n;                       /* Size of current data piece. */
@@ -1430,26 +1603,36 @@ PRIVATE ssize_t do_kportal_awrite(struct mportal * portal, const void * buffer,
 	size_t remainder;               /* Remainder of total data.    */
 	size_t times;                   /* Number of pieces.           */
 	struct mportal_message message; /* Message buffer.             */
+	bool contended;                 /* Was the channel busy?       */
 
 	/* Waits allows. */
-	if ((ret = do_kportal_wait_allow(portal)) < 0)
+	if ((ret = do_kportal_wait_allow(portal, nonblock)) < 0)
 		return (ret);
 
+	contended = false;
+
 	/* Sends header. */
 	message.header   = true;
 	message.eof      = false;
 	message._.config = portal->config;
 
 again:
-	spinlock_lock(&write_lock[portal->config.remote]);
+	spinlock_lock(&tx_channels[portal->config.remote].lock);
 
-		if (resource_is_busy(&write_channels[portal->config.remote]))
+		if (resource_is_busy(&tx_channels[portal->config.remote].resource))
 		{
-			spinlock_unlock(&write_lock[portal->config.remote]);
+			spinlock_unlock(&tx_channels[portal->config.remote].lock);
+
+			if (!contended)
+			{
+				contended = true;
+				NANVIX_TRACE_INSTANT(NANVIX_TRACE_LOCK_CONTENTION, portal - mportals, portal->config.remote);
+			}
+
 			goto again;
 		}
 
-		resource_set_busy(&write_channels[portal->config.remote]);
+		resource_set_busy(&tx_channels[portal->config.remote].resource);
 
 		/* Reads a piece of the message. */
 		if ((ret = kmailbox_write(portal->mdata, &message, MPORTAL_MESSAGE_SIZE)) < 0)
@@ -1476,6 +1659,8 @@ again:
 			if ((ret = kmailbox_write(portal->mdata, &message, MPORTAL_MESSAGE_SIZE)) < 0)
 				goto error;
 
+			NANVIX_TRACE_INSTANT(NANVIX_TRACE_CHUNK_SEND, portal - mportals, n);
+
 			/* Next pieces. */
 			buffer += n;
 		}
@@ -1483,8 +1668,8 @@ again:
 		ret = size;
 
 error:
-		resource_set_notbusy(&write_channels[portal->config.remote]);
-	spinlock_unlock(&write_lock[portal->config.remote]);
+		resource_set_notbusy(&tx_channels[portal->config.remote].resource);
+	spinlock_unlock(&tx_channels[portal->config.remote].lock);
 
 	if (ret >= 0)
 		portal->volume += size;
@@ -1546,17 +1731,15 @@ again:
 }
 
 /*----------------------------------------------------------------------------*
- * kportal_awrite()                                                           *
+ * do_kportal_write()                                                         *
  *----------------------------------------------------------------------------*/
 
-/**
- * @details The kportal_awrite() asynchronously write @p size bytes
- * of data pointed to by @p buffer to the output portal @p portalid.
- */
-PUBLIC ssize_t kportal_awrite(int portalid, const void * buffer, size_t size)
+PRIVATE ssize_t do_kportal_write(int portalid, const void * buffer, size_t size, bool nonblock)
 {
 	ssize_t ret;      /* Return value. */
 	uint64_t l0, l1;   /* Latency.      */
+	uint64_t t0;      /* Clock value.  */
+	uint64_t t1;      /* Clock value.  */
 
 	/* Invalid portalid. */
 	if (!WITHIN(portalid, 0, KPORTAL_MAX))
@@ -1592,14 +1775,18 @@ PUBLIC ssize_t kportal_awrite(int portalid, const void * buffer, size_t size)
 
 	spinlock_unlock(&global_lock);
 
+	NANVIX_TRACE_BEGIN(NANVIX_TRACE_KPORTAL_AWRITE, portalid);
+
+	kclock(&t0);
+
 	/* Is local communication? */
-	if (node_is_local(mportals[portalid].config.remote))
+	if (IKC_NODE_IS_LOCAL(mportals[portalid].config.remote))
 		ret = do_kportal_awrite_local(&mportals[portalid], buffer, size);
 	else
 	{
 		kmailbox_ioctl(mportals[portalid].mdata, KMAILBOX_IOCTL_GET_LATENCY, &l0);
 
-		ret = do_kportal_awrite(&mportals[portalid], buffer, size);
+		ret = do_kportal_awrite(&mportals[portalid], buffer, size, nonblock);
 
 		if (ret >= 0)
 		{
@@ -1608,10 +1795,17 @@ PUBLIC ssize_t kportal_awrite(int portalid, const void * buffer, size_t size)
 		}
 	}
 
-	spinlock_lock(&global_lock);
-		if (ret >= 0)
-			mportal_counters.nwrites++;
+	kclock(&t1);
+
+	NANVIX_TRACE_END(NANVIX_TRACE_KPORTAL_AWRITE, portalid, ret);
+
+	if (ret >= 0)
+	{
+		NANVIX_HISTOGRAM_RECORD(&mportals[portalid].hist, t1 - t0);
+		NANVIX_COUNTERS_INC(mportal_counters, MPORTAL_COUNTER_NWRITES);
+	}
 
+	spinlock_lock(&global_lock);
 		resource_set_notbusy(&mportals[portalid].resource);
 error:
 	spinlock_unlock(&global_lock);
@@ -1619,6 +1813,35 @@ error:
 	return (ret);
 }
 
+/*----------------------------------------------------------------------------*
+ * kportal_awrite()                                                           *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @details The kportal_awrite() asynchronously write @p size bytes
+ * of data pointed to by @p buffer to the output portal @p portalid.
+ */
+PUBLIC ssize_t kportal_awrite(int portalid, const void * buffer, size_t size)
+{
+	return (do_kportal_write(portalid, buffer, size, false));
+}
+
+/*----------------------------------------------------------------------------*
+ * kportal_trywrite()                                                         *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @details The kportal_trywrite() function writes the @p size bytes
+ * pointed to by @p buffer to the output portal @p portalid, if the
+ * remote has already allowed it. Allows for other portals that arrive
+ * meanwhile are recorded. Writes to the local node do not wait for
+ * allows and are written at once.
+ */
+PUBLIC ssize_t kportal_trywrite(int portalid, const void * buffer, size_t size)
+{
+	return (do_kportal_write(portalid, buffer, size, true));
+}
+
 /*============================================================================*
  * kportal_wait()                                                             *
  *============================================================================*/
@@ -1761,29 +1984,31 @@ PUBLIC int kportal_ioctl(int portalid, unsigned request, ...)
 							*var = mportals[portalid].latency;
 							break;
 
+#if __NANVIX_IKC_STATS
 						case KPORTAL_IOCTL_GET_NCREATES:
-							*var = mportal_counters.ncreates;
+							*var = nanvix_counters_get(&mportal_counters, MPORTAL_COUNTER_NCREATES);
 							break;
 
 						case KPORTAL_IOCTL_GET_NUNLINKS:
-							*var = mportal_counters.nunlinks;
+							*var = nanvix_counters_get(&mportal_counters, MPORTAL_COUNTER_NUNLINKS);
 							break;
 
 						case KPORTAL_IOCTL_GET_NOPENS:
-							*var = mportal_counters.nopens;
+							*var = nanvix_counters_get(&mportal_counters, MPORTAL_COUNTER_NOPENS);
 							break;
 
 						case KPORTAL_IOCTL_GET_NCLOSES:
-							*var = mportal_counters.ncloses;
+							*var = nanvix_counters_get(&mportal_counters, MPORTAL_COUNTER_NCLOSES);
 							break;
 
 						case KPORTAL_IOCTL_GET_NREADS:
-							*var = mportal_counters.nreads;
+							*var = nanvix_counters_get(&mportal_counters, MPORTAL_COUNTER_NREADS);
 							break;
 
 						case KPORTAL_IOCTL_GET_NWRITES:
-							*var = mportal_counters.nwrites;
+							*var = nanvix_counters_get(&mportal_counters, MPORTAL_COUNTER_NWRITES);
 							break;
+#endif /* __NANVIX_IKC_STATS */
 
 						/* Operation not supported. */
 						default:
@@ -1792,6 +2017,58 @@ PUBLIC int kportal_ioctl(int portalid, unsigned request, ...)
 					}
 				} break;
 
+#if __NANVIX_IKC_STATS
+				/* Get latency percentiles. */
+				case KPORTAL_IOCTL_GET_HISTOGRAM:
+				{
+					struct nanvix_histogram_summary * summary;
+
+					summary = va_arg(args, struct nanvix_histogram_summary *);
+
+					/* Bad buffer. */
+					if (!kportal_ioctl_valid(summary, sizeof(struct nanvix_histogram_summary)))
+						goto error1;
+
+					nanvix_histogram_summary(&mportals[portalid].hist, summary);
+					ret = 0;
+				} break;
+
+				/* Discard latency samples. */
+				case KPORTAL_IOCTL_RESET_HISTOGRAM:
+				{
+					nanvix_histogram_reset(&mportals[portalid].hist);
+					ret = 0;
+				} break;
+#endif /* __NANVIX_IKC_STATS */
+
+				/* Set wait policy. */
+				case KPORTAL_IOCTL_SET_BACKOFF:
+				{
+					int policy = va_arg(args, int);
+
+					ret = (-EINVAL);
+
+					/* Invalid policy. */
+					if (!NANVIX_BACKOFF_IS_VALID(policy))
+						goto error1;
+
+					mportals[portalid].backoff = policy;
+					ret = 0;
+				} break;
+
+				/* Get wait policy. */
+				case KPORTAL_IOCTL_GET_BACKOFF:
+				{
+					int * policy = va_arg(args, int *);
+
+					/* Bad buffer. */
+					if (!kportal_ioctl_valid(policy, sizeof(int)))
+						goto error1;
+
+					*policy = mportals[portalid].backoff;
+					ret = 0;
+				} break;
+
 				/* Operation not supported. */
 				default:
 					ret = (-ENOTSUP);
@@ -1837,6 +2114,315 @@ error:
 	return (ret);
 }
 
+/*============================================================================*
+ * kportal_progress()                                                         *
+ *============================================================================*/
+
+/*----------------------------------------------------------------------------*
+ * kportal_progress_collect()                                                 *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Collects the threads sleeping on portals to a remote.
+ *
+ * @param remote   Remote node, or -1 for any.
+ * @param writable Collect writers instead of readers?
+ * @param tids     Store location for the threads.
+ *
+ * @note The lock that protects the waiters must be held. Threads are
+ * collected in @p tids and woken up by the caller, once it releases
+ * that lock.
+ *
+ * @returns The number of threads collected in @p tids.
+ */
+PRIVATE int kportal_progress_collect(int remote, bool writable, kthread_t * tids)
+{
+	int n = 0;
+
+	for (unsigned i = 0; i < KPORTAL_MAX; ++i)
+	{
+		if (!resource_is_used(&mportals[i].resource))
+			continue;
+
+		if (resource_is_writable(&mportals[i].resource) != writable)
+			continue;
+
+		if ((remote >= 0) && (mportals[i].config.remote != remote))
+			continue;
+
+		if (mportals[i].waiter < 0)
+			continue;
+
+		tids[n++]          = mportals[i].waiter;
+		mportals[i].waiter = -1;
+	}
+
+	return (n);
+}
+
+/*----------------------------------------------------------------------------*
+ * kportal_progress_wakeup()                                                  *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Wakes up threads collected by kportal_progress_collect().
+ *
+ * @param tids Threads to wake up.
+ * @param n    Number of threads in @p tids.
+ */
+PRIVATE void kportal_progress_wakeup(const kthread_t * tids, int n)
+{
+	for (int i = 0; i < n; ++i)
+		while (LIKELY(kwakeup(tids[i]) != 0));
+}
+
+/*----------------------------------------------------------------------------*
+ * kportal_progress_allow()                                                   *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Receives an allow, if any, and wakes up its writers.
+ *
+ * @returns One if an allow was received, and zero otherwise.
+ */
+PRIVATE int kportal_progress_allow(void)
+{
+	int n;                        /* Number of threads to wake up. */
+	kthread_t tids[KPORTAL_MAX];  /* Threads to wake up.           */
+	struct mportal_config config; /* Hash buffer.                  */
+
+	spinlock_lock(&allow_lock);
+
+		/* No allow. */
+		if (kmailbox_tryread(mallow_in, &config, MPORTAL_CONFIG_SIZE) != MPORTAL_CONFIG_SIZE)
+		{
+			spinlock_unlock(&allow_lock);
+			return (0);
+		}
+
+		kportal_receive_allow(&config);
+
+		n = kportal_progress_collect(config.local, true, tids);
+
+	spinlock_unlock(&allow_lock);
+
+	kportal_progress_wakeup(tids, n);
+
+	return (1);
+}
+
+/*----------------------------------------------------------------------------*
+ * kportal_progress_data()                                                    *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Receives a message from a remote, if any, into the buffers.
+ *
+ * @param remote Remote node.
+ *
+ * @returns One if a message was received, zero if none was pending,
+ * and a negative error code upon failure.
+ */
+PRIVATE int kportal_progress_data(int remote)
+{
+	int n;                          /* Number of threads to wake up. */
+	int portalid;                   /* Target portal.                */
+	ssize_t ret;                    /* Return value.                 */
+	void * data;                    /* Auxiliar buffer pointer.      */
+	size_t received;                /* Received data counter.        */
+	uint64_t l0, l1;                /* Latency.                      */
+	kthread_t tids[KPORTAL_MAX];    /* Threads to wake up.           */
+	struct mportal_buffer * buf;    /* Auxiliar buffer pointer.      */
+	struct mportal_message message; /* Message buffer.               */
+	struct mportal_config config;   /* Configuration.                */
+	struct nanvix_backoff backoff;  /* Wait for free buffers.        */
+
+	n = 0;
+
+	spinlock_lock(&rx_channels[remote].lock);
+
+		/* A reader owns the channel. */
+		if (resource_is_busy(&rx_channels[remote].resource))
+		{
+			spinlock_unlock(&rx_channels[remote].lock);
+			return (0);
+		}
+
+		/* Set channel busy. */
+		resource_set_busy(&rx_channels[remote].resource);
+
+		/* Reads header. */
+		if ((ret = kmailbox_tryread(rx_channels[remote].mdata, &message, MPORTAL_MESSAGE_SIZE)) < 0)
+		{
+			ret = (ret == -EAGAIN) ? 0 : ret;
+			goto release;
+		}
+
+		/* The allow was consumed by the remote. */
+		rx_channels[remote].allow_pending = false;
+
+		/* Sanity check. */
+		KASSERT(message.header || !message.eof);
+
+		/* Is the message to an existing portal? */
+		config.local       = message._.config.remote;
+		config.local_port  = message._.config.remote_port;
+		config.remote      = message._.config.local;
+		config.remote_port = message._.config.local_port;
+		spinlock_lock(&global_lock);
+			portalid       = kportal_search(&config, true);
+		spinlock_unlock(&global_lock);
+
+		if (portalid < 0)
+		{
+			do_aread_message_drop(rx_channels[remote].mdata, &message._.config);
+			ret = (1);
+			goto wakeup;
+		}
+
+		nanvix_backoff_init(&backoff, mportals[portalid].backoff);
+		while ((buf = kportal_buffer_alloc(NULL, &message._.config)) == NULL)
+			nanvix_backoff_wait(&backoff);
+
+		data     = buf->data;
+		received = 0ULL;
+
+		kmailbox_ioctl(rx_channels[remote].mdata, KMAILBOX_IOCTL_GET_LATENCY, &l0);
+
+		/* Reads. */
+		while (!message.eof)
+		{
+			/* Reads a piece of the message. */
+			if ((ret = kmailbox_read(rx_channels[remote].mdata, &message, MPORTAL_MESSAGE_SIZE)) < 0)
+				goto release;
+
+			/* Sanity check. */
+			KASSERT(!message.header);
+
+			NANVIX_TRACE_INSTANT(NANVIX_TRACE_CHUNK_RECV, portalid, message.size);
+
+			/* Keeps previous buffer and alloc a new one. */
+			if ((received + message.size) > MPORTAL_BUFFER_SIZE)
+			{
+				/* Complete the buffer. */
+				kmemcpy(data, message._.data, (MPORTAL_BUFFER_SIZE - received));
+				buf->size += (MPORTAL_BUFFER_SIZE - received);
+
+				/* Readers may free buffers meanwhile. */
+				spinlock_unlock(&rx_channels[remote].lock);
+					nanvix_backoff_init(&backoff, mportals[portalid].backoff);
+					while ((buf = kportal_buffer_alloc(buf, &buf->config)) == NULL)
+						nanvix_backoff_wait(&backoff);
+
+					/* Copies the rest of the message in the new buffer. */
+					kmemcpy(
+						buf->data,
+						message._.data + (MPORTAL_BUFFER_SIZE - received),
+						message.size - (MPORTAL_BUFFER_SIZE - received)
+					);
+
+					received  = (message.size - (MPORTAL_BUFFER_SIZE - received));
+					buf->size = received;
+					data      = (buf->data + received);
+				spinlock_lock(&rx_channels[remote].lock);
+
+				continue;
+			}
+
+			buf->size += message.size;
+
+			kmemcpy(data, message._.data, message.size);
+
+			/* Next pieces. */
+			data     += message.size;
+			received += message.size;
+		}
+
+		kmailbox_ioctl(rx_channels[remote].mdata, KMAILBOX_IOCTL_GET_LATENCY, &l1);
+
+		buf->latency += (l1 - l0);
+
+		/* Makes buffer available. */
+		kportal_buffer_set_available(buf);
+
+		ret = (1);
+
+wakeup:
+		/* Readers of the remote must allow again. */
+		n = kportal_progress_collect(remote, false, tids);
+
+release:
+		resource_set_notbusy(&rx_channels[remote].resource);
+	spinlock_unlock(&rx_channels[remote].lock);
+
+	kportal_progress_wakeup(tids, n);
+
+	return (ret);
+}
+
+/*----------------------------------------------------------------------------*
+ * kportal_progress()                                                         *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @details The kportal_progress() function receives, without blocking,
+ * at most one allow and one message per remote. Messages are stored in
+ * the buffers of their portals and the threads that sleep on portals
+ * to the same remote are woken up.
+ */
+PUBLIC int kportal_progress(void)
+{
+	int n;     /* Number of received messages. */
+	int ret;   /* Return value.                */
+	int local; /* Local node.                  */
+
+	if (!kportal_is_initialized)
+		return (0);
+
+	local = knode_get_num();
+	n     = kportal_progress_allow();
+
+	for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; ++i)
+	{
+		if (i == local)
+			continue;
+
+		if ((ret = kportal_progress_data(i)) > 0)
+			n += ret;
+	}
+
+	return (n);
+}
+
+/*============================================================================*
+ * kportal_progress_release()                                                 *
+ *============================================================================*/
+
+/**
+ * @details The kportal_progress_release() function wakes up all
+ * threads that sleep on the progress engine.
+ */
+PUBLIC void kportal_progress_release(void)
+{
+	int n;                       /* Number of threads to wake up. */
+	kthread_t tids[KPORTAL_MAX]; /* Threads to wake up.           */
+
+	for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; ++i)
+	{
+		spinlock_lock(&rx_channels[i].lock);
+			n = kportal_progress_collect(i, false, tids);
+		spinlock_unlock(&rx_channels[i].lock);
+
+		kportal_progress_wakeup(tids, n);
+	}
+
+	spinlock_lock(&allow_lock);
+		n = kportal_progress_collect(-1, true, tids);
+	spinlock_unlock(&allow_lock);
+
+	kportal_progress_wakeup(tids, n);
+}
+
 /*============================================================================*
  * kportal_init()                                                             *
  *============================================================================*/
@@ -1850,12 +2436,12 @@ PUBLIC void kportal_init(void)
 
 	kprintf("[user][portal] Initializes portal module (mailbox implementation)");
 
-	mportal_counters.ncreates = 0ULL;
-	mportal_counters.nunlinks = 0ULL;
-	mportal_counters.nopens   = 0ULL;
-	mportal_counters.ncloses  = 0ULL;
-	mportal_counters.nreads   = 0ULL;
-	mportal_counters.nwrites  = 0ULL;
+#if __NANVIX_IKC_STATS
+	nanvix_counters_reset(&mportal_counters);
+#endif /* __NANVIX_IKC_STATS */
+
+	for (unsigned i = 0; i < KPORTAL_MAX; ++i)
+		nanvix_histogram_init(&mportals[i].hist);
 
 	/* Create input mailbox. */
 	KASSERT(
@@ -1873,7 +2459,7 @@ PUBLIC void kportal_init(void)
 			continue;
 
 		KASSERT(
-			(mallow_outs[i] = kcall2(
+			(tx_channels[i].mallow = kcall2(
 				NR_mailbox_open,
 				(word_t) i,
 				(word_t) (MAILBOX_PORT_NR - 2)
@@ -1881,7 +2467,7 @@ PUBLIC void kportal_init(void)
 		);
 
 		KASSERT(
-			(mdata_ins[i] = kcall2(
+			(rx_channels[i].mdata = kcall2(
 				NR_mailbox_create,
 				(word_t) local,
 				(word_t) (MAILBOX_PORT_NR - 3 - i)
@@ -1889,7 +2475,7 @@ PUBLIC void kportal_init(void)
 		);
 
 		KASSERT(
-			(mdata_outs[i] = kcall2(
+			(tx_channels[i].mdata = kcall2(
 				NR_mailbox_open,
 				(word_t) i,
 				(word_t) (MAILBOX_PORT_NR - 3 - local)
@@ -1897,7 +2483,7 @@ PUBLIC void kportal_init(void)
 		);
 
 		/* Set channel busy. */
-		resource_set_used(&read_channels[i]);
+		resource_set_used(&rx_channels[i].resource);
 	}
 
 	kportal_is_initialized = true;
@@ -29,9 +29,14 @@
 
 #if __TARGET_HAS_MAILBOX && __NANVIX_IKC_USES_ONLY_MAILBOX
 
+#include <nanvix/sys/counters.h>
 #include <nanvix/sys/perf.h>
 #include <nanvix/sys/noc.h>
 #include <nanvix/sys/mailbox.h>
+#include <nanvix/sys/progress.h>
+#include <nanvix/sys/sync.h>
+#include <nanvix/sys/thread.h>
+#include <nanvix/sys/trace.h>
 #include <posix/errno.h>
 
 /**
@@ -43,9 +48,9 @@ PRIVATE bool ksync_is_initialized = false;
  * @name Protections.
  */
 /**@{*/
-PRIVATE spinlock_t global_lock = SPINLOCK_UNLOCKED;
-PRIVATE spinlock_t wait_lock   = SPINLOCK_UNLOCKED;
-PRIVATE spinlock_t signal_lock = SPINLOCK_UNLOCKED;
+PRIVATE spinlock_t global_lock ALIGN(CACHE_LINE_SIZE) = SPINLOCK_UNLOCKED;
+PRIVATE spinlock_t wait_lock   ALIGN(CACHE_LINE_SIZE) = SPINLOCK_UNLOCKED;
+PRIVATE spinlock_t signal_lock ALIGN(CACHE_LINE_SIZE) = SPINLOCK_UNLOCKED;
 /**@}*/
 
 /**
@@ -56,6 +61,14 @@ PRIVATE int inbox = -1;
 PRIVATE int outboxes[PROCESSOR_NOC_NODES_NUM] = {
 	[0 ... (PROCESSOR_NOC_NODES_NUM - 1)] = -1,
 };
+PRIVATE bool outboxes_pending[PROCESSOR_NOC_NODES_NUM] = {
+	[0 ... (PROCESSOR_NOC_NODES_NUM - 1)] = false,
+};
+PRIVATE struct
+{
+	int syncid;  /**< Sync that posted the signal. */
+	uint64_t t0; /**< Clock value at posting.      */
+} outboxes_posts[PROCESSOR_NOC_NODES_NUM];
 /**@}*/
 
 /*============================================================================*
@@ -63,17 +76,25 @@ PRIVATE int outboxes[PROCESSOR_NOC_NODES_NUM] = {
  *============================================================================*/
 
 /**
- * @brief Communicator counters.
+ * @name Communicator counters.
  */
-PRIVATE struct
-{
-	uint64_t ncreates; /**< Number of creates. */
-	uint64_t nunlinks; /**< Number of unlinks. */
-	uint64_t nopens;   /**< Number of opens.   */
-	uint64_t ncloses;  /**< Number of closes.  */
-	uint64_t nwaits;   /**< Number of watis.   */
-	uint64_t nsignals; /**< Number of signals. */
-} msync_counters;
+/**@{*/
+#define MSYNC_COUNTER_NCREATES 0 /**< Number of creates. */
+#define MSYNC_COUNTER_NUNLINKS 1 /**< Number of unlinks. */
+#define MSYNC_COUNTER_NOPENS   2 /**< Number of opens.   */
+#define MSYNC_COUNTER_NCLOSES  3 /**< Number of closes.  */
+#define MSYNC_COUNTER_NWAITS   4 /**< Number of waits.   */
+#define MSYNC_COUNTER_NSIGNALS 5 /**< Number of signals. */
+/**@}*/
+
+#if __NANVIX_IKC_STATS
+
+/**
+ * @brief Communicator counters, sharded per thread.
+ */
+PRIVATE struct nanvix_counters msync_counters;
+
+#endif /* __NANVIX_IKC_STATS */
 
 /*============================================================================*
  * Sync hash                                                                  *
@@ -118,13 +139,16 @@ PRIVATE struct msync
 	struct msync_hash hash;                 /**< Sync hash.                    */
 	int nreceived[PROCESSOR_NOC_NODES_NUM]; /**< Number of signals received.   */
 	uint64_t latency;                       /**< Latency counter.              */
-} ALIGN(sizeof(dword_t)) msyncs[(KSYNC_MAX)] = {
+	struct nanvix_histogram hist;           /**< Latency histogram.            */
+	kthread_t waiter;                       /**< Thread asleep on the engine.  */
+} ALIGN(CACHE_LINE_SIZE) msyncs[(KSYNC_MAX)] = {
 	[0 ... (KSYNC_MAX - 1)] = {
 		.resource  = {0, },
 		.refcount  = 0,
 		.nbarriers = 0,
 		.hash      = {-1, 0, -1, 0, 0, 0},
 		.latency   = 0ULL,
+		.waiter    = -1,
 	},
 };
 
@@ -297,17 +321,18 @@ PRIVATE int do_ksync_alloc(const int * nodes, int nnodes, int type, int input)
 				msyncs[syncid].nbarriers = 0;
 				msyncs[syncid].hash      = hash;
 				msyncs[syncid].latency   = 0ULL;
+				nanvix_histogram_reset(&msyncs[syncid].hist);
 				kmemset(msyncs[syncid].nreceived, 0, PROCESSOR_NOC_NODES_NUM * sizeof(int));
 
 				if (input)
 				{
 					resource_set_rdonly(&msyncs[syncid].resource);
-					msync_counters.ncreates++;
+					NANVIX_COUNTERS_INC_LOCKED(msync_counters, MSYNC_COUNTER_NCREATES);
 				}
 				else
 				{
 					resource_set_wronly(&msyncs[syncid].resource);
-					msync_counters.nopens++;
+					NANVIX_COUNTERS_INC_LOCKED(msync_counters, MSYNC_COUNTER_NOPENS);
 				}
 			}
 		}
@@ -389,9 +414,9 @@ PRIVATE int do_ksync_release(int syncid, int input)
 		}
 
 		if (input)
-			msync_counters.nunlinks++;
+			NANVIX_COUNTERS_INC_LOCKED(msync_counters, MSYNC_COUNTER_NUNLINKS);
 		else
-			msync_counters.ncloses++;
+			NANVIX_COUNTERS_INC_LOCKED(msync_counters, MSYNC_COUNTER_NCLOSES);
 
 		ret = (0);
 
@@ -415,9 +440,82 @@ PUBLIC int ksync_unlink(int syncid)
 }
 
 /*============================================================================*
- * ksync_wait()                                                               *
+ * ksync_close()                                                              *
  *============================================================================*/
 
+/*----------------------------------------------------------------------------*
+ * ksync_outbox_complete()                                                    *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Completes the asynchronous signal sent to a node, if any.
+ *
+ * @param target Target node.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ *
+ * @note The signal lock must be held.
+ */
+PRIVATE int ksync_outbox_complete(unsigned target)
+{
+	int ret; /* Return value. */
+
+	if (!outboxes_pending[target])
+		return (0);
+
+	ret = kmailbox_wait(outboxes[target]);
+
+	/* Latency of an asynchronous signal. */
+	if (ret == 0)
+	{
+		NANVIX_HISTOGRAM_COMPLETE(
+			&msyncs[outboxes_posts[target].syncid].hist,
+			outboxes_posts[target].t0
+		);
+	}
+
+	outboxes_pending[target] = false;
+
+	return ((ret < 0) ? ret : 0);
+}
+
+/*----------------------------------------------------------------------------*
+ * ksync_signal_complete()                                                    *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Completes the asynchronous signals sent to the targets of a
+ * sync.
+ *
+ * @param syncid ID of the target sync.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+PRIVATE int ksync_signal_complete(int syncid)
+{
+	int ret; /* Return value. */
+	int err; /* Error value.  */
+
+	ret = 0;
+
+	spinlock_lock(&signal_lock);
+
+		for (unsigned target = 0; target < PROCESSOR_NOC_NODES_NUM; ++target)
+		{
+			if (msyncs[syncid].hash.barrier & (1 << target))
+			{
+				err = ksync_outbox_complete(target);
+				ret = (err < 0) ? err : ret;
+			}
+		}
+
+	spinlock_unlock(&signal_lock);
+
+	return (ret);
+}
+
 /*----------------------------------------------------------------------------*
  * ksync_close()                                                              *
  *----------------------------------------------------------------------------*/
@@ -428,6 +526,16 @@ PUBLIC int ksync_unlink(int syncid)
  */
 PUBLIC int ksync_close(int syncid)
 {
+	int ret;
+
+	/* Invalid syncid. */
+	if (!WITHIN(syncid, 0, KSYNC_MAX))
+		return (-EINVAL);
+
+	/* Asynchronous signals still point to the hash of the sync. */
+	if ((ret = ksync_signal_complete(syncid)) < 0)
+		return (ret);
+
 	return (do_ksync_release(syncid, false));
 }
 
@@ -519,18 +627,99 @@ PRIVATE int ksync_barrier_consume(struct msync * sync)
 }
 
 /*----------------------------------------------------------------------------*
- * do_ksync_wait()                                                            *
+ * ksync_receive_signal()                                                     *
  *----------------------------------------------------------------------------*/
 
-PRIVATE int do_ksync_wait(struct msync * sync)
+/**
+ * @brief Dispatches a signal to its synchronization point.
+ *
+ * @param hash Received signal.
+ *
+ * @returns The ID of the synchronization point if the signal completes
+ * its barrier, and a negative number otherwise.
+ *
+ * @note The global lock must be held.
+ */
+PRIVATE int ksync_receive_signal(struct msync_hash * hash)
 {
-	int syncid;             /* Synchronization point. */
-	struct msync_hash hash; /* Hash buffer.           */
+	int syncid; /* Synchronization point. */
+
+	if (!node_is_valid(hash->source))
+	{
+		ksync_ignore_signal("Invalid Source", hash);
+		return (-EINVAL);
+	}
+
+	if ((syncid = ksync_search(hash, true)) < 0)
+	{
+		ksync_ignore_signal("Sync point not found.", hash);
+		return (-EINVAL);
+	}
+
+	msyncs[syncid].hash.barrier |= (1ULL << hash->source);
+	msyncs[syncid].nreceived[hash->source]++;
+
+	if (!ksync_barrier_is_complete(&msyncs[syncid]))
+		return (-EAGAIN);
+
+	ksync_barrier_reset(&msyncs[syncid]);
+	msyncs[syncid].nbarriers++;
+
+	return (syncid);
+}
+
+/*----------------------------------------------------------------------------*
+ * do_ksync_wait_engine()                                                     *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Sleeps until the progress engine completes a barrier.
+ *
+ * @param sync     Target synchronization point.
+ * @param nonblock Fail with -EAGAIN instead of sleeping?
+ *
+ * @returns One to check the barrier again, or -EAGAIN.
+ */
+PRIVATE int do_ksync_wait_engine(struct msync * sync, bool nonblock)
+{
+	if (nonblock)
+		return (-EAGAIN);
+
+	spinlock_lock(&global_lock);
+
+		/* Completed meanwhile or engine stopped. */
+		if (sync->nbarriers || !nanvix_ikc_progress_is_running())
+		{
+			spinlock_unlock(&global_lock);
+			return (1);
+		}
+
+		sync->waiter = kthread_self();
+
+	spinlock_unlock(&global_lock);
+
+	ksleep();
+
+	return (1);
+}
+
+/*----------------------------------------------------------------------------*
+ * do_ksync_wait_signal()                                                     *
+ *----------------------------------------------------------------------------*/
+
+PRIVATE int do_ksync_wait_signal(struct msync * sync, bool nonblock)
+{
+	ssize_t ret;            /* Return value. */
+	struct msync_hash hash; /* Hash buffer.  */
 
 	/* Is the previous wait released me? */
 	if (ksync_barrier_consume(sync))
 		return (0);
 
+	/* The progress engine receives signals. */
+	if (nanvix_ikc_progress_is_running())
+		return (do_ksync_wait_engine(sync, nonblock));
+
 	spinlock_lock(&wait_lock);
 
 		/* Is other core released me? */
@@ -541,36 +730,19 @@ PRIVATE int do_ksync_wait(struct msync * sync)
 		}
 
 		/* Reads a signal. */ 
-		if (kmailbox_read(inbox, &hash, MSYNC_HASH_SIZE) != MSYNC_HASH_SIZE)
+		if (nonblock)
+			ret = kmailbox_tryread(inbox, &hash, MSYNC_HASH_SIZE);
+		else
+			ret = kmailbox_read(inbox, &hash, MSYNC_HASH_SIZE);
+
+		if (ret != MSYNC_HASH_SIZE)
 		{
 			spinlock_unlock(&wait_lock);
 			return (-EAGAIN);
 		}
 
 		spinlock_lock(&global_lock);
-
-			if (!node_is_valid(hash.source))
-			{
-				ksync_ignore_signal("Invalid Source", &hash);
-				goto release;
-			}
-
-			if ((syncid = ksync_search(&hash, true)) < 0)
-			{
-				ksync_ignore_signal("Sync point not found.", &hash);
-				goto release;
-			}
-
-			msyncs[syncid].hash.barrier |= (1ULL << hash.source);
-			msyncs[syncid].nreceived[hash.source]++;
-
-			if (ksync_barrier_is_complete(&msyncs[syncid]))
-			{
-				ksync_barrier_reset(&msyncs[syncid]);
-				msyncs[syncid].nbarriers++;
-			}
-
-release:
+			ksync_receive_signal(&hash);
 		spinlock_unlock(&global_lock);
 	spinlock_unlock(&wait_lock);
 
@@ -579,13 +751,10 @@ release:
 }
 
 /*----------------------------------------------------------------------------*
- * ksync_wait()                                                               *
+ * do_ksync_wait()                                                            *
  *----------------------------------------------------------------------------*/
 
-/**
- * @details The ksync_wait() waits incomming signal on a input sync @p syncid.
- */
-PUBLIC int ksync_wait(int syncid)
+PRIVATE int do_ksync_wait(int syncid, bool nonblock)
 {
 	int ret;     /* Return value. */
 	uint64_t t0; /* Clock value.  */
@@ -617,15 +786,20 @@ PUBLIC int ksync_wait(int syncid)
 
 	spinlock_unlock(&global_lock);
 
+	NANVIX_TRACE_BEGIN(NANVIX_TRACE_KSYNC_WAIT, syncid);
+
 	kclock(&t0);
-		while ((ret = do_ksync_wait(&msyncs[syncid])) > 0);
+		while ((ret = do_ksync_wait_signal(&msyncs[syncid], nonblock)) > 0);
 	kclock(&t1);
 
+	NANVIX_TRACE_END(NANVIX_TRACE_KSYNC_WAIT, syncid, ret);
+
 	spinlock_lock(&global_lock);
 		if (ret >= 0)
 		{
 			msyncs[syncid].latency += (t1 - t0);
-			msync_counters.nwaits++;
+			NANVIX_HISTOGRAM_RECORD(&msyncs[syncid].hist, t1 - t0);
+			NANVIX_COUNTERS_INC_LOCKED(msync_counters, MSYNC_COUNTER_NWAITS);
 		}
 		resource_set_notbusy(&msyncs[syncid].resource);
 error:
@@ -634,19 +808,61 @@ error:
 	return (ret);
 }
 
+/*----------------------------------------------------------------------------*
+ * ksync_wait()                                                               *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @details The ksync_wait() waits incomming signal on a input sync @p syncid.
+ */
+PUBLIC int ksync_wait(int syncid)
+{
+	return (do_ksync_wait(syncid, false));
+}
+
+/*----------------------------------------------------------------------------*
+ * ksync_trywait()                                                            *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @details The ksync_trywait() consumes a completed barrier of the
+ * input sync @p syncid, if any. Signals that have already arrived in
+ * the shared inbox are demultiplexed to their synchronization points
+ * first, without blocking.
+ */
+PUBLIC int ksync_trywait(int syncid)
+{
+	return (do_ksync_wait(syncid, true));
+}
+
 /*============================================================================*
  * ksync_signal()                                                             *
  *============================================================================*/
 
 /*----------------------------------------------------------------------------*
- * do_ksync_signal()                                                          *
+ * do_ksync_send()                                                            *
  *----------------------------------------------------------------------------*/
 
-PRIVATE int do_ksync_signal(int syncid)
+/**
+ * @brief Sends a signal to each target node of a sync.
+ *
+ * @param syncid ID of the target sync.
+ * @param async  Return before remote signals are delivered?
+ *
+ * @returns Upon successful completion, a positive number is returned.
+ * Upon failure, a negative error code is returned instead.
+ *
+ * @note An asynchronous signal is completed before the next signal to
+ * the same node, or when the sync is closed. Signals to the local node
+ * bypass the NoC, so they are always delivered at once.
+ */
+PRIVATE int do_ksync_send(int syncid, bool async)
 {
-	int ret; /* Return value. */
+	int ret;        /* Return value.  */
+	unsigned local; /* Local nodenum. */
 
-	ret = (-EINVAL);
+	ret   = (-EINVAL);
+	local = knode_get_num();
 
 	spinlock_lock(&signal_lock);
 
@@ -654,7 +870,29 @@ PRIVATE int do_ksync_signal(int syncid)
 		for (unsigned target = 0; target < PROCESSOR_NOC_NODES_NUM; ++target)
 		{
 			/* Is the target valid? */
-			if (msyncs[syncid].hash.barrier & (1 << target))
+			if (!(msyncs[syncid].hash.barrier & (1 << target)))
+				continue;
+
+			/* Previous signal still in flight. */
+			if ((ret = ksync_outbox_complete(target)) < 0)
+				break;
+
+			if (async && (target != local))
+			{
+				/* Error occurred? */
+				if ((ret = kmailbox_awrite(
+					outboxes[target],
+					&msyncs[syncid].hash,
+					MSYNC_HASH_SIZE
+				)) < 1)
+					break;
+
+				outboxes_pending[target] = true;
+				outboxes_posts[target].syncid = syncid;
+				NANVIX_HISTOGRAM_POST(outboxes_posts[target].t0);
+				ret = MSYNC_HASH_SIZE;
+			}
+			else
 			{
 				ret = kmailbox_write(
 					outboxes[target],
@@ -674,13 +912,10 @@ PRIVATE int do_ksync_signal(int syncid)
 }
 
 /*----------------------------------------------------------------------------*
- * ksync_signal()                                                             *
+ * do_ksync_signal()                                                          *
  *----------------------------------------------------------------------------*/
 
-/**
- * @details The ksync_signal() emmit a signal from a output sync @p syncid.
- */
-PUBLIC int ksync_signal(int syncid)
+PRIVATE int do_ksync_signal(int syncid, bool async)
 {
 	int ret;     /* Return value. */
 	uint64_t t0; /* Clock value.  */
@@ -712,15 +947,24 @@ PUBLIC int ksync_signal(int syncid)
 
 	spinlock_unlock(&global_lock);
 
+	NANVIX_TRACE_BEGIN(NANVIX_TRACE_KSYNC_SIGNAL, syncid);
+
 	kclock(&t0);
-		ret = do_ksync_signal(syncid);
+		ret = do_ksync_send(syncid, async);
 	kclock(&t1);
 
+	NANVIX_TRACE_END(NANVIX_TRACE_KSYNC_SIGNAL, syncid, ret);
+
 	spinlock_lock(&global_lock);
 		if (ret >= 0)
 		{
-			msyncs[syncid].latency += (t1 - t0);
-			msync_counters.nsignals++;
+			/* Asynchronous signals are sampled on completion. */
+			if (!async)
+			{
+				msyncs[syncid].latency += (t1 - t0);
+				NANVIX_HISTOGRAM_RECORD(&msyncs[syncid].hist, t1 - t0);
+			}
+			NANVIX_COUNTERS_INC_LOCKED(msync_counters, MSYNC_COUNTER_NSIGNALS);
 		}
 		resource_set_notbusy(&msyncs[syncid].resource);
 error:
@@ -729,6 +973,33 @@ error:
 	return (ret < 0) ? (ret) : (0);
 }
 
+/*----------------------------------------------------------------------------*
+ * ksync_signal()                                                             *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @details The ksync_signal() emmit a signal from a output sync @p syncid.
+ */
+PUBLIC int ksync_signal(int syncid)
+{
+	return (do_ksync_signal(syncid, false));
+}
+
+/*----------------------------------------------------------------------------*
+ * ksync_signal_async()                                                       *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @details The ksync_signal_async() function emits a signal from the
+ * output sync @p syncid, but does not wait for the signal to leave the
+ * local node. The signal is completed before the next signal to the
+ * same target nodes, or when @p syncid is closed.
+ */
+PUBLIC int ksync_signal_async(int syncid)
+{
+	return (do_ksync_signal(syncid, true));
+}
+
 /*============================================================================*
  * ksync_ioctl()                                                            *
  *============================================================================*/
@@ -744,9 +1015,12 @@ PRIVATE int ksync_ioctl_valid(void * ptr, size_t size)
  */
 PUBLIC int ksync_ioctl(int syncid, unsigned request, ...)
 {
-	int ret;        /* Return value.              */
-	va_list args;   /* Argument list.             */
-	uint64_t * var; /* Auxiliar variable pointer. */
+	int ret;                                   /* Return value.              */
+	va_list args;                              /* Argument list.             */
+	uint64_t * var;                            /* Auxiliar variable pointer. */
+#if __NANVIX_IKC_STATS
+	struct nanvix_histogram_summary * summary; /* Latency percentiles.       */
+#endif /* __NANVIX_IKC_STATS */
 
 	if (!WITHIN(syncid, 0, KSYNC_MAX))
 		return (-EINVAL);
@@ -769,6 +1043,37 @@ PUBLIC int ksync_ioctl(int syncid, unsigned request, ...)
 
 		va_start(args, request);
 
+#if __NANVIX_IKC_STATS
+			/* Discard latency samples. */
+			if (request == KSYNC_IOCTL_RESET_HISTOGRAM)
+			{
+				nanvix_histogram_reset(&msyncs[syncid].hist);
+				ret = 0;
+				goto error1;
+			}
+
+			/* Get latency percentiles. */
+			if (request == KSYNC_IOCTL_GET_HISTOGRAM)
+			{
+				summary = va_arg(args, struct nanvix_histogram_summary *);
+
+				/* Bad buffer. */
+				if (!ksync_ioctl_valid(summary, sizeof(struct nanvix_histogram_summary)))
+					goto error1;
+
+				nanvix_histogram_summary(&msyncs[syncid].hist, summary);
+				ret = 0;
+				goto error1;
+			}
+#else
+			/* Latency histograms are compiled out. */
+			if ((request == KSYNC_IOCTL_RESET_HISTOGRAM) || (request == KSYNC_IOCTL_GET_HISTOGRAM))
+			{
+				ret = (-ENOTSUP);
+				goto error1;
+			}
+#endif /* __NANVIX_IKC_STATS */
+
 			var = va_arg(args, uint64_t *);
 
 			/* Bad buffer. */
@@ -784,29 +1089,31 @@ PUBLIC int ksync_ioctl(int syncid, unsigned request, ...)
 					*var = msyncs[syncid].latency;
 					break;
 
+#if __NANVIX_IKC_STATS
 				case KSYNC_IOCTL_GET_NCREATES:
-					*var = msync_counters.ncreates;
+					*var = nanvix_counters_get(&msync_counters, MSYNC_COUNTER_NCREATES);
 					break;
 
 				case KSYNC_IOCTL_GET_NUNLINKS:
-					*var = msync_counters.nunlinks;
+					*var = nanvix_counters_get(&msync_counters, MSYNC_COUNTER_NUNLINKS);
 					break;
 
 				case KSYNC_IOCTL_GET_NOPENS:
-					*var = msync_counters.nopens;
+					*var = nanvix_counters_get(&msync_counters, MSYNC_COUNTER_NOPENS);
 					break;
 
 				case KSYNC_IOCTL_GET_NCLOSES:
-					*var = msync_counters.ncloses;
+					*var = nanvix_counters_get(&msync_counters, MSYNC_COUNTER_NCLOSES);
 					break;
 
 				case KSYNC_IOCTL_GET_NWAITS:
-					*var = msync_counters.nwaits;
+					*var = nanvix_counters_get(&msync_counters, MSYNC_COUNTER_NWAITS);
 					break;
 
 				case KSYNC_IOCTL_GET_NSIGNALS:
-					*var = msync_counters.nsignals;
+					*var = nanvix_counters_get(&msync_counters, MSYNC_COUNTER_NSIGNALS);
 					break;
+#endif /* __NANVIX_IKC_STATS */
 
 				/* Operation not supported. */
 				default:
@@ -822,6 +1129,77 @@ error0:
 	return (ret);
 }
 
+/*============================================================================*
+ * ksync_progress()                                                           *
+ *============================================================================*/
+
+/**
+ * @details The ksync_progress() function receives a signal from the
+ * shared inbox, if any, and wakes up the thread that sleeps on the
+ * synchronization point whose barrier it completes.
+ */
+PUBLIC int ksync_progress(void)
+{
+	int syncid;             /* Synchronization point. */
+	kthread_t tid;          /* Thread to wake up.     */
+	struct msync_hash hash; /* Hash buffer.           */
+
+	if (!ksync_is_initialized)
+		return (0);
+
+	tid = -1;
+
+	spinlock_lock(&wait_lock);
+
+		/* No signal. */
+		if (kmailbox_tryread(inbox, &hash, MSYNC_HASH_SIZE) != MSYNC_HASH_SIZE)
+		{
+			spinlock_unlock(&wait_lock);
+			return (0);
+		}
+
+		spinlock_lock(&global_lock);
+
+			if ((syncid = ksync_receive_signal(&hash)) >= 0)
+			{
+				tid                   = msyncs[syncid].waiter;
+				msyncs[syncid].waiter = -1;
+			}
+
+		spinlock_unlock(&global_lock);
+
+	spinlock_unlock(&wait_lock);
+
+	if (tid >= 0)
+		while (LIKELY(kwakeup(tid) != 0));
+
+	return (1);
+}
+
+/*============================================================================*
+ * ksync_progress_release()                                                   *
+ *============================================================================*/
+
+/**
+ * @details The ksync_progress_release() function wakes up all threads
+ * that sleep on the progress engine.
+ */
+PUBLIC void ksync_progress_release(void)
+{
+	kthread_t tid; /* Thread to wake up. */
+
+	for (unsigned i = 0; i < KSYNC_MAX; i++)
+	{
+		spinlock_lock(&global_lock);
+			tid              = msyncs[i].waiter;
+			msyncs[i].waiter = -1;
+		spinlock_unlock(&global_lock);
+
+		if (tid >= 0)
+			while (LIKELY(kwakeup(tid) != 0));
+	}
+}
+
 /*============================================================================*
  * ksync_init()                                                               *
  *============================================================================*/
@@ -837,12 +1215,9 @@ PUBLIC void ksync_init(void)
 
 	local = knode_get_num();
 
-	msync_counters.ncreates = 0ULL;
-	msync_counters.nunlinks = 0ULL;
-	msync_counters.nopens   = 0ULL;
-	msync_counters.ncloses  = 0ULL;
-	msync_counters.nwaits   = 0ULL;
-	msync_counters.nsignals = 0ULL;
+#if __NANVIX_IKC_STATS
+	nanvix_counters_reset(&msync_counters);
+#endif /* __NANVIX_IKC_STATS */
 
 	for (unsigned i = 0; i < KSYNC_MAX; i++)
 	{
@@ -851,6 +1226,8 @@ PUBLIC void ksync_init(void)
 		msyncs[i].nbarriers = 0;
 		msyncs[i].hash.source = -1;
 		msyncs[i].latency   = 0ULL;
+		msyncs[i].waiter    = -1;
+		nanvix_histogram_init(&msyncs[i].hist);
 
 		for (unsigned j = 0; j < PROCESSOR_NOC_NODES_NUM; j++)
 			msyncs[i].nreceived[j] = 0;
@@ -877,6 +1254,14 @@ PUBLIC void ksync_init(void)
 		);
 	}
 
+	/**
+	 * Signals to the local node bypass the NoC. Another node of the
+	 * cluster may own the ring already, and then signals keep using
+	 * the NoC.
+	 */
+	kmailbox_local_bind(inbox, local, MAILBOX_PORT_NR - 1, false);
+	kmailbox_local_bind(outboxes[local], local, MAILBOX_PORT_NR - 1, true);
+
 	ksync_is_initialized = true;
 }
 
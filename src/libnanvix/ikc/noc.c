@@ -24,45 +24,20 @@
 
 #include <nanvix/kernel/kernel.h>
 #include <nanvix/sys/mailbox.h>
+#include <nanvix/sys/noc.h>
 #include <nanvix/sys/portal.h>
 #include <nanvix/sys/sync.h>
 #include <posix/errno.h>
 
-/*============================================================================*
- * knode_get_num()                                                            *
- *============================================================================*/
-
-/*
- * @see kernel_node_get_num()
+/**
+ * @brief Logic ID of the local node (-1 until first queried).
  */
-int knode_get_num(void)
-{
-	int ret;
-
-	ret = kcall0(
-		NR_node_get_num
-	);
-
-	return (ret);
-}
+PUBLIC int __knode_num = -1;
 
-/*============================================================================*
- * kcluster_get_num()                                                         *
- *============================================================================*/
-
-/*
- * @see kernel_cluster_get_num()
+/**
+ * @brief Logic ID of the local cluster (-1 until first queried).
  */
-int kcluster_get_num(void)
-{
-	int ret;
-
-	ret = kcall0(
-		NR_cluster_get_num
-	);
-
-	return (ret);
-}
+PUBLIC int __kcluster_num = -1;
 
 /*============================================================================*
  * kcomm_get_port()                                                           *
@@ -0,0 +1,536 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <nanvix/sys/pchannel.h>
+
+#if __TARGET_HAS_PORTAL || __NANVIX_IKC_USES_ONLY_MAILBOX
+
+#include <nanvix/sys/mailbox.h>
+#include <nanvix/sys/noc.h>
+#include <nanvix/sys/portal.h>
+#include <posix/errno.h>
+#include <posix/stdbool.h>
+#include <posix/stdint.h>
+
+/**
+ * @brief Size of a piece of a transfer.
+ */
+#if __NANVIX_IKC_USES_ONLY_MAILBOX
+#define KPCHANNEL_PIECE_SIZE KMAILBOX_MESSAGE_SIZE
+#else
+#define KPCHANNEL_PIECE_SIZE KPORTAL_MESSAGE_DATA_SIZE
+#endif
+
+/**
+ * @brief Magic number of the handshake.
+ */
+#define KPCHANNEL_MAGIC 0x4843504b
+
+/**
+ * @brief Handshake sent once by the sending end.
+ */
+struct kpchannel_hello
+{
+	uint32_t magic; /**< KPCHANNEL_MAGIC.  */
+	uint32_t size;  /**< Size of transfers. */
+};
+
+/**
+ * @brief Table of persistent channels.
+ */
+PRIVATE struct
+{
+	bool used;    /**< Used channel?                    */
+	bool output;  /**< Sending end?                     */
+	bool started; /**< Transfer in progress?            */
+	int id;       /**< Underlying portal or mailbox.    */
+	int remote;   /**< Remote NoC node.                 */
+	int port;     /**< Port.                            */
+	void *buffer; /**< Data buffer.                     */
+	size_t size;  /**< Size of transfers.               */
+	ssize_t ret;  /**< Return value of start.           */
+} kpchannels[KPCHANNEL_MAX] = {
+	[0 ... (KPCHANNEL_MAX - 1)] = { .used = false, .id = -1 }
+};
+
+/**
+ * @brief Protects the table of channels.
+ */
+PRIVATE spinlock_t kpchannel_lock = SPINLOCK_UNLOCKED;
+
+/*============================================================================*
+ * Backend                                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Opens the underlying communicator of a channel.
+ *
+ * @param chid  Target channel.
+ * @param local Local NoC node.
+ *
+ * @returns Upon successful completion, the ID of the communicator is
+ * returned. Upon failure, a negative error code is returned instead.
+ */
+PRIVATE int kpchannel_backend_open(int chid, int local)
+{
+#if __NANVIX_IKC_USES_ONLY_MAILBOX
+	if (kpchannels[chid].output)
+		return (kmailbox_open(kpchannels[chid].remote, kpchannels[chid].port));
+
+	return (kmailbox_create(local, kpchannels[chid].port));
+#else
+	if (kpchannels[chid].output)
+		return (kportal_open(local, kpchannels[chid].remote, kpchannels[chid].port));
+
+	return (kportal_create(local, kpchannels[chid].port));
+#endif
+}
+
+/**
+ * @brief Closes the underlying communicator of a channel.
+ *
+ * @param chid Target channel.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+PRIVATE int kpchannel_backend_close(int chid)
+{
+#if __NANVIX_IKC_USES_ONLY_MAILBOX
+	if (kpchannels[chid].output)
+		return (kmailbox_close(kpchannels[chid].id));
+
+	return (kmailbox_unlink(kpchannels[chid].id));
+#else
+	if (kpchannels[chid].output)
+		return (kportal_close(kpchannels[chid].id));
+
+	return (kportal_unlink(kpchannels[chid].id));
+#endif
+}
+
+/**
+ * @brief Sends data through the underlying communicator of a channel.
+ *
+ * @param chid   Target channel.
+ * @param buffer Source data buffer.
+ * @param size   Size of @p buffer.
+ *
+ * @returns Upon successful completion, @p size is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE ssize_t kpchannel_backend_write(int chid, const void * buffer, size_t size)
+{
+#if __NANVIX_IKC_USES_ONLY_MAILBOX
+	ssize_t ret;
+	size_t n;
+
+	/* Raw pieces, no header. */
+	for (size_t i = 0; i < size; i += n)
+	{
+		n = ((size - i) < KPCHANNEL_PIECE_SIZE) ? (size - i) : KPCHANNEL_PIECE_SIZE;
+
+		if ((ret = kmailbox_write(kpchannels[chid].id, (const char *) buffer + i, n)) < 0)
+			return (ret);
+	}
+
+	return (size);
+#else
+	return (kportal_write(kpchannels[chid].id, buffer, size));
+#endif
+}
+
+/**
+ * @brief Receives data through the underlying communicator of a channel.
+ *
+ * @param chid   Target channel.
+ * @param buffer Target data buffer.
+ * @param size   Size of @p buffer.
+ *
+ * @returns Upon successful completion, @p size is returned. Upon
+ * failure, a negative error code is returned instead.
+ *
+ * @note With portals, the first piece must be allowed beforehand.
+ */
+PRIVATE ssize_t kpchannel_backend_read(int chid, void * buffer, size_t size)
+{
+#if __NANVIX_IKC_USES_ONLY_MAILBOX
+	ssize_t ret;
+	size_t n;
+
+	/* Raw pieces, no header. */
+	for (size_t i = 0; i < size; i += n)
+	{
+		n = ((size - i) < KPCHANNEL_PIECE_SIZE) ? (size - i) : KPCHANNEL_PIECE_SIZE;
+
+		if ((ret = kmailbox_read(kpchannels[chid].id, (char *) buffer + i, n)) < 0)
+			return (ret);
+	}
+
+	return (size);
+#else
+	return (kportal_read(kpchannels[chid].id, buffer, size));
+#endif
+}
+
+/**
+ * @brief Posts a receive in the underlying communicator of a channel.
+ *
+ * @param chid Target channel.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+PRIVATE int kpchannel_backend_post(int chid)
+{
+#if __NANVIX_IKC_USES_ONLY_MAILBOX
+	/* Mailboxes are always ready to receive. */
+	((void) chid);
+
+	return (0);
+#else
+	return (kportal_allow(kpchannels[chid].id, kpchannels[chid].remote, kpchannels[chid].port));
+#endif
+}
+
+/*============================================================================*
+ * kpchannel_init()                                                           *
+ *============================================================================*/
+
+/**
+ * @brief Initializes a persistent channel.
+ *
+ * @param local  Local NoC node.
+ * @param remote Remote NoC node.
+ * @param port   Target port.
+ * @param buffer Data buffer.
+ * @param size   Size in bytes of @p buffer.
+ * @param output Sending end?
+ *
+ * @returns Upon successful completion, the ID of the channel is
+ * returned. Upon failure, a negative error code is returned instead.
+ */
+PRIVATE int kpchannel_init(int local, int remote, int port, void * buffer, size_t size, bool output)
+{
+	int chid;
+	ssize_t ret;
+	struct kpchannel_hello hello;
+
+	/* Invalid local node. */
+	if (local != knode_get_num())
+		return (-EINVAL);
+
+	/* Invalid remote node. */
+	if (!WITHIN(remote, 0, PROCESSOR_NOC_NODES_NUM))
+		return (-EINVAL);
+
+	/* Invalid port. */
+	if (!WITHIN(port, 0, KPCHANNEL_PORT_NR))
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if (buffer == NULL)
+		return (-EINVAL);
+
+	/* Invalid size. */
+	if ((size == 0) || (size > KPORTAL_MAX_SIZE))
+		return (-EINVAL);
+
+	spinlock_lock(&kpchannel_lock);
+
+		for (chid = 0; chid < KPCHANNEL_MAX; chid++)
+		{
+			if (!kpchannels[chid].used)
+				break;
+		}
+
+		/* No channel available. */
+		if (chid == KPCHANNEL_MAX)
+		{
+			spinlock_unlock(&kpchannel_lock);
+			return (-EAGAIN);
+		}
+
+		kpchannels[chid].used    = true;
+		kpchannels[chid].output  = output;
+		kpchannels[chid].started = false;
+		kpchannels[chid].remote  = remote;
+		kpchannels[chid].port    = port;
+		kpchannels[chid].buffer  = buffer;
+		kpchannels[chid].size    = size;
+
+	spinlock_unlock(&kpchannel_lock);
+
+	if ((ret = kpchannel_backend_open(chid, local)) < 0)
+		goto error0;
+
+	kpchannels[chid].id = ret;
+
+	/* Negotiates the size once. */
+	if (output)
+	{
+		hello.magic = KPCHANNEL_MAGIC;
+		hello.size  = (uint32_t) size;
+
+		if ((ret = kpchannel_backend_write(chid, &hello, sizeof(struct kpchannel_hello))) < 0)
+			goto error1;
+	}
+	else
+	{
+		if ((ret = kpchannel_backend_post(chid)) < 0)
+			goto error1;
+
+		if ((ret = kpchannel_backend_read(chid, &hello, sizeof(struct kpchannel_hello))) < 0)
+			goto error1;
+
+		ret = (-EINVAL);
+
+		/* Mismatching ends. */
+		if ((hello.magic != KPCHANNEL_MAGIC) || (hello.size != size))
+			goto error1;
+	}
+
+	return (chid);
+
+error1:
+	kpchannel_backend_close(chid);
+error0:
+	spinlock_lock(&kpchannel_lock);
+		kpchannels[chid].used = false;
+		kpchannels[chid].id   = -1;
+	spinlock_unlock(&kpchannel_lock);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * kpchannel_recv_init()                                                      *
+ *============================================================================*/
+
+/**
+ * @details The kpchannel_recv_init() function initializes a persistent
+ * channel that receives @p size bytes from @p remote in @p buffer.
+ */
+PUBLIC int kpchannel_recv_init(int local, int remote, int port, void * buffer, size_t size)
+{
+	return (kpchannel_init(local, remote, port, buffer, size, false));
+}
+
+/*============================================================================*
+ * kpchannel_send_init()                                                      *
+ *============================================================================*/
+
+/**
+ * @details The kpchannel_send_init() function initializes a persistent
+ * channel that sends @p size bytes of @p buffer to @p remote.
+ */
+PUBLIC int kpchannel_send_init(int local, int remote, int port, const void * buffer, size_t size)
+{
+	return (kpchannel_init(local, remote, port, (void *) buffer, size, true));
+}
+
+/*============================================================================*
+ * kpchannel_start()                                                          *
+ *============================================================================*/
+
+/**
+ * @details The kpchannel_start() function starts a transfer in the
+ * persistent channel @p chid. A receiving end posts the receive of the
+ * first piece, and with portals reads it asynchronously. A sending end
+ * sends the first piece asynchronously.
+ */
+PUBLIC int kpchannel_start(int chid)
+{
+	size_t n;
+
+	/* Invalid channel. */
+	if (!WITHIN(chid, 0, KPCHANNEL_MAX))
+		return (-EINVAL);
+
+	/* Bad channel. */
+	if (!kpchannels[chid].used)
+		return (-EBADF);
+
+	/* Transfer in progress. */
+	if (kpchannels[chid].started)
+		return (-EBUSY);
+
+	n = (kpchannels[chid].size < KPCHANNEL_PIECE_SIZE) ? kpchannels[chid].size : KPCHANNEL_PIECE_SIZE;
+
+#if __NANVIX_IKC_USES_ONLY_MAILBOX
+	if (!kpchannels[chid].output)
+		kpchannels[chid].ret = kpchannel_backend_post(chid);
+
+	/* Same path as the rest, so that pieces stay in order. */
+	else
+		kpchannels[chid].ret = kmailbox_write(kpchannels[chid].id, kpchannels[chid].buffer, n);
+#else
+	if (!kpchannels[chid].output)
+	{
+		/* Receives the first piece asynchronously. */
+		if ((kpchannels[chid].ret = kpchannel_backend_post(chid)) >= 0)
+			kpchannels[chid].ret = kportal_aread(kpchannels[chid].id, kpchannels[chid].buffer, n);
+	}
+	else
+		kpchannels[chid].ret = kportal_awrite(kpchannels[chid].id, kpchannels[chid].buffer, n);
+#endif
+
+	if (kpchannels[chid].ret < 0)
+		return ((int) kpchannels[chid].ret);
+
+	kpchannels[chid].started = true;
+
+	return (0);
+}
+
+/*============================================================================*
+ * kpchannel_complete()                                                       *
+ *============================================================================*/
+
+/**
+ * @details The kpchannel_complete() function completes the transfer
+ * started in the persistent channel @p chid.
+ */
+PUBLIC ssize_t kpchannel_complete(int chid)
+{
+	size_t n;
+	ssize_t ret;
+
+	/* Invalid channel. */
+	if (!WITHIN(chid, 0, KPCHANNEL_MAX))
+		return (-EINVAL);
+
+	/* Bad channel. */
+	if (!kpchannels[chid].used)
+		return (-EBADF);
+
+	/* No transfer in progress. */
+	if (!kpchannels[chid].started)
+		return (-EINVAL);
+
+	kpchannels[chid].started = false;
+
+#if __NANVIX_IKC_USES_ONLY_MAILBOX
+	/* Receives the whole buffer. */
+	if (!kpchannels[chid].output)
+		return (kpchannel_backend_read(chid, kpchannels[chid].buffer, kpchannels[chid].size));
+#endif
+
+	n = (kpchannels[chid].size < KPCHANNEL_PIECE_SIZE) ? kpchannels[chid].size : KPCHANNEL_PIECE_SIZE;
+
+#if !__NANVIX_IKC_USES_ONLY_MAILBOX
+	/* Waits for the first piece. */
+	if (kpchannels[chid].output)
+	{
+		if ((ret = kportal_wait(kpchannels[chid].id)) < 0)
+			return (ret);
+	}
+	else
+	{
+		/* Repeat while reading valid messages for another ports. */
+		while ((ret = kportal_wait(kpchannels[chid].id)) > 0)
+		{
+			if ((ret = kportal_aread(kpchannels[chid].id, kpchannels[chid].buffer, n)) < 0)
+				return (ret);
+		}
+
+		/* Wait failed. */
+		if (ret < 0)
+			return (ret);
+
+		/* Receives the remaining pieces. */
+		if (n < kpchannels[chid].size)
+		{
+			if ((ret = kpchannel_backend_post(chid)) < 0)
+				return (ret);
+
+			ret = kpchannel_backend_read(
+				chid,
+				(char *) kpchannels[chid].buffer + n,
+				kpchannels[chid].size - n
+			);
+
+			if (ret < 0)
+				return (ret);
+		}
+
+		return (kpchannels[chid].size);
+	}
+#endif
+
+	/* Sends the remaining pieces. */
+	if (n < kpchannels[chid].size)
+	{
+		ret = kpchannel_backend_write(
+			chid,
+			(const char *) kpchannels[chid].buffer + n,
+			kpchannels[chid].size - n
+		);
+
+		if (ret < 0)
+			return (ret);
+	}
+
+	return (kpchannels[chid].size);
+}
+
+/*============================================================================*
+ * kpchannel_free()                                                           *
+ *============================================================================*/
+
+/**
+ * @details The kpchannel_free() function releases the persistent
+ * channel @p chid and its underlying communicator.
+ */
+PUBLIC int kpchannel_free(int chid)
+{
+	int ret;
+
+	/* Invalid channel. */
+	if (!WITHIN(chid, 0, KPCHANNEL_MAX))
+		return (-EINVAL);
+
+	/* Bad channel. */
+	if (!kpchannels[chid].used)
+		return (-EBADF);
+
+	/* Transfer in progress. */
+	if (kpchannels[chid].started)
+		return (-EBUSY);
+
+	if ((ret = kpchannel_backend_close(chid)) < 0)
+		return (ret);
+
+	spinlock_lock(&kpchannel_lock);
+		kpchannels[chid].used = false;
+		kpchannels[chid].id   = -1;
+	spinlock_unlock(&kpchannel_lock);
+
+	return (0);
+}
+
+#else
+extern int make_iso_compilers_happy;
+#endif /* __TARGET_HAS_PORTAL || __NANVIX_IKC_USES_ONLY_MAILBOX */
@@ -0,0 +1,219 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/sys/poll.h>
+
+#if __TARGET_HAS_MAILBOX
+
+#include <nanvix/sys/backoff.h>
+#include <nanvix/sys/mailbox.h>
+#include <nanvix/sys/perf.h>
+#include <nanvix/sys/portal.h>
+#include <nanvix/sys/sync.h>
+#include <posix/errno.h>
+
+/**
+ * @brief Asserts whether portals are available.
+ */
+#define KPOLL_HAS_PORTAL (__TARGET_HAS_PORTAL || __NANVIX_IKC_USES_ONLY_MAILBOX)
+
+/**
+ * @brief Asserts whether synchronization points are available.
+ */
+#define KPOLL_HAS_SYNC (__TARGET_HAS_SYNC || __NANVIX_IKC_USES_ONLY_MAILBOX)
+
+/*============================================================================*
+ * Helpers                                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Tries to complete the read of a communicator.
+ *
+ * @param fd Target communicator.
+ *
+ * @returns Non-zero if the communicator is ready, and zero otherwise.
+ */
+PRIVATE int kpoll_try(struct kpollfd *fd)
+{
+	ssize_t ret;
+
+	switch (fd->type)
+	{
+		case KPOLL_MAILBOX:
+			ret = kmailbox_tryread(fd->id, fd->buffer, fd->size);
+			break;
+
+#if KPOLL_HAS_PORTAL
+		case KPOLL_PORTAL:
+			ret = kportal_tryread(fd->id, fd->buffer, fd->size);
+			break;
+#endif
+
+#if KPOLL_HAS_SYNC
+		case KPOLL_SYNC:
+			ret = ksync_trywait(fd->id);
+			break;
+#endif
+
+		default:
+			ret = (-EINVAL);
+			break;
+	}
+
+	/* Not ready yet. */
+	if (ret == (-EAGAIN))
+		return (0);
+
+	fd->ret     = ret;
+	fd->revents = (ret < 0) ? KPOLLERR : KPOLLIN;
+
+	return (1);
+}
+
+/**
+ * @brief Scans communicators once.
+ *
+ * @param fds   Communicators to watch.
+ * @param nfds  Number of communicators in @p fds.
+ * @param first Stop at the first ready communicator?
+ *
+ * @returns The number of ready communicators.
+ */
+PRIVATE int kpoll_scan(struct kpollfd *fds, int nfds, bool first)
+{
+	int nready = 0;
+
+	for (int i = 0; i < nfds; i++)
+	{
+		/* Ignored or already ready. */
+		if ((fds[i].id < 0) || (fds[i].revents != 0))
+			continue;
+
+		if (kpoll_try(&fds[i]))
+		{
+			nready++;
+
+			if (first)
+				break;
+		}
+	}
+
+	return (nready);
+}
+
+/**
+ * @brief Validates a set of communicators and clears its events.
+ *
+ * @param fds  Communicators to watch.
+ * @param nfds Number of communicators in @p fds.
+ *
+ * @returns Non-zero if the set is valid, and zero otherwise.
+ */
+PRIVATE int kpoll_prepare(struct kpollfd *fds, int nfds)
+{
+	if ((fds == NULL) || (nfds <= 0))
+		return (0);
+
+	for (int i = 0; i < nfds; i++)
+	{
+		fds[i].revents = 0;
+		fds[i].ret     = 0;
+	}
+
+	return (1);
+}
+
+/*============================================================================*
+ * kpoll()                                                                    *
+ *============================================================================*/
+
+/**
+ * @details The kpoll() function completes the read of every ready
+ * communicator in @p fds. Communicators are scanned in rounds, waiting
+ * in between with the default backoff policy, until any is ready or
+ * @p timeout clock cycles have elapsed. Errors of a communicator are
+ * reported in its entry, with KPOLLERR.
+ */
+PUBLIC int kpoll(struct kpollfd *fds, int nfds, uint64_t timeout)
+{
+	int nready;
+	uint64_t t0;
+	uint64_t t1;
+	struct nanvix_backoff backoff;
+
+	/* Invalid communicators. */
+	if (!kpoll_prepare(fds, nfds))
+		return (-EINVAL);
+
+	nanvix_backoff_init(&backoff, NANVIX_BACKOFF_DEFAULT);
+	kclock(&t0);
+
+	while ((nready = kpoll_scan(fds, nfds, false)) == 0)
+	{
+		kclock(&t1);
+
+		/* Time limit expired. */
+		if ((timeout != KPOLL_FOREVER) && ((t1 - t0) >= timeout))
+			break;
+
+		nanvix_backoff_wait(&backoff);
+	}
+
+	return (nready);
+}
+
+/*============================================================================*
+ * kwait_any()                                                                *
+ *============================================================================*/
+
+/**
+ * @details The kwait_any() function waits until the read of one
+ * communicator in @p fds completes. Communicators are scanned in
+ * order, so the caller should rotate @p fds to serve them fairly.
+ */
+PUBLIC int kwait_any(struct kpollfd *fds, int nfds)
+{
+	struct nanvix_backoff backoff;
+
+	/* Invalid communicators. */
+	if (!kpoll_prepare(fds, nfds))
+		return (-EINVAL);
+
+	nanvix_backoff_init(&backoff, NANVIX_BACKOFF_DEFAULT);
+
+	while (kpoll_scan(fds, nfds, true) == 0)
+		nanvix_backoff_wait(&backoff);
+
+	for (int i = 0; i < nfds; i++)
+	{
+		if (fds[i].revents != 0)
+			return (i);
+	}
+
+	return (-EAGAIN);
+}
+
+#else
+extern int make_iso_compilers_happy;
+#endif /* __TARGET_HAS_MAILBOX */
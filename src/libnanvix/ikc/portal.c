@@ -26,7 +26,10 @@
 
 #if __TARGET_HAS_PORTAL && !__NANVIX_IKC_USES_ONLY_MAILBOX
 
+#include <nanvix/sys/latency.h>
 #include <nanvix/sys/noc.h>
+#include <nanvix/sys/portal.h>
+#include <nanvix/sys/trace.h>
 #include <posix/errno.h>
 
 /**
@@ -43,6 +46,45 @@ PRIVATE struct
 	int port;   /**< Remote port ID. */
 } kportal_allows[KPORTAL_MAX];
 
+/**
+ * @brief Latency histograms.
+ */
+PRIVATE struct nanvix_histogram kportal_histograms[KPORTAL_MAX];
+
+/**
+ * @brief Clock values at which pending operations were posted.
+ */
+PRIVATE uint64_t kportal_posts[KPORTAL_MAX];
+
+/**
+ * @brief Wait policies.
+ */
+PRIVATE int kportal_backoffs[KPORTAL_MAX];
+
+#if (__NANVIX_IKC_LATENCY_ENABLED)
+
+/**
+ * @brief Sizes of the posted reads.
+ */
+PRIVATE ssize_t kportal_posted[KPORTAL_MAX] = {
+	[0 ... (KPORTAL_MAX - 1)] = NANVIX_LATENCY_IDLE
+};
+
+#endif /* __NANVIX_IKC_LATENCY_ENABLED */
+
+/**
+ * @brief Gets the wait policy of a portal.
+ *
+ * @param portalid Target portal.
+ *
+ * @returns The wait policy of @p portalid, or the default one if @p
+ * portalid is invalid.
+ */
+PRIVATE int kportal_backoff(int portalid)
+{
+	return (WITHIN(portalid, 0, KPORTAL_MAX) ? kportal_backoffs[portalid] : NANVIX_BACKOFF_DEFAULT);
+}
+
 /*============================================================================*
  * kportal_create()                                                           *
  *============================================================================*/
@@ -72,6 +114,11 @@ int kportal_create(int local, int local_port)
 			kportal_allows[ret].remote = -1;
 			kportal_allows[ret].port   = -1;
 		spinlock_unlock(&kportal_lock);
+
+		/* Discard samples of a previous portal. */
+		nanvix_histogram_reset(&kportal_histograms[ret]);
+		kportal_posts[ret] = 0;
+		kportal_backoffs[ret] = NANVIX_BACKOFF_DEFAULT;
 	}
 
 	return (ret);
@@ -130,6 +177,14 @@ int kportal_open(int local, int remote, int remote_port)
 		(word_t) remote_port
 	);
 
+	/* Discard samples of a previous portal. */
+	if (ret >= 0)
+	{
+		nanvix_histogram_reset(&kportal_histograms[ret]);
+		kportal_posts[ret] = 0;
+		kportal_backoffs[ret] = NANVIX_BACKOFF_DEFAULT;
+	}
+
 	return (ret);
 }
 
@@ -184,6 +239,9 @@ int kportal_close(int portalid)
 ssize_t kportal_aread(int portalid, void * buffer, size_t size)
 {
 	ssize_t ret;
+	bool retry;
+	bool contended;
+	struct nanvix_backoff backoff;
 
 	/* Invalid buffer. */
 	if (buffer == NULL)
@@ -193,6 +251,10 @@ ssize_t kportal_aread(int portalid, void * buffer, size_t size)
 	if (size == 0 || size > KPORTAL_MESSAGE_DATA_SIZE)
 		return (-EINVAL);
 
+	contended = false;
+	nanvix_backoff_init(&backoff, kportal_backoff(portalid));
+	NANVIX_TRACE_BEGIN(NANVIX_TRACE_KPORTAL_AREAD, portalid);
+
 	do
 	{
 		ret = kcall3(
@@ -200,7 +262,27 @@ ssize_t kportal_aread(int portalid, void * buffer, size_t size)
 			(word_t) portalid,
 			(word_t) buffer,
 			(word_t) size);
-	} while ((ret == -EBUSY) || (ret == -ENOMSG));
+
+		/* Busy portal. */
+		if ((ret == -EBUSY) && !contended)
+		{
+			contended = true;
+			NANVIX_TRACE_INSTANT(NANVIX_TRACE_LOCK_CONTENTION, portalid, 0);
+		}
+
+		/* Not ready yet. */
+		if ((retry = (ret == -EBUSY) || (ret == -ENOMSG)))
+			nanvix_backoff_wait(&backoff);
+	} while (retry);
+
+	/* Delivered and sampled by kportal_wait(). */
+	if (ret >= 0)
+	{
+		NANVIX_LATENCY_POST(kportal_posted[portalid], size);
+		NANVIX_HISTOGRAM_POST(kportal_posts[portalid]);
+	}
+
+	NANVIX_TRACE_END(NANVIX_TRACE_KPORTAL_AREAD, portalid, ret);
 
 	return (ret);
 }
@@ -216,6 +298,10 @@ ssize_t kportal_aread(int portalid, void * buffer, size_t size)
 ssize_t kportal_awrite(int portalid, const void * buffer, size_t size)
 {
 	ssize_t ret;
+	bool retry;
+	bool allowing;
+	bool contended;
+	struct nanvix_backoff backoff;
 
 	/* Invalid buffer. */
 	if (buffer == NULL)
@@ -225,6 +311,11 @@ ssize_t kportal_awrite(int portalid, const void * buffer, size_t size)
 	if (size == 0 || size > KPORTAL_MESSAGE_DATA_SIZE)
 		return (-EINVAL);
 
+	allowing  = false;
+	contended = false;
+	nanvix_backoff_init(&backoff, kportal_backoff(portalid));
+	NANVIX_TRACE_BEGIN(NANVIX_TRACE_KPORTAL_AWRITE, portalid);
+
 	do
 	{
 		ret = kcall3(
@@ -232,7 +323,34 @@ ssize_t kportal_awrite(int portalid, const void * buffer, size_t size)
 			(word_t) portalid,
 			(word_t) buffer,
 			(word_t) size);
-	} while ((ret == -EACCES) || (ret == -EBUSY));
+
+		/* Remote has not allowed yet. */
+		if ((ret == -EACCES) && !allowing)
+		{
+			allowing = true;
+			NANVIX_TRACE_BEGIN(NANVIX_TRACE_ALLOW_WAIT, portalid);
+		}
+
+		/* Busy portal. */
+		if ((ret == -EBUSY) && !contended)
+		{
+			contended = true;
+			NANVIX_TRACE_INSTANT(NANVIX_TRACE_LOCK_CONTENTION, portalid, 0);
+		}
+
+		/* Not ready yet. */
+		if ((retry = (ret == -EACCES) || (ret == -EBUSY)))
+			nanvix_backoff_wait(&backoff);
+	} while (retry);
+
+	if (allowing)
+		NANVIX_TRACE_END(NANVIX_TRACE_ALLOW_WAIT, portalid, 0);
+
+	/* Sampled by kportal_wait(). */
+	if (ret >= 0)
+		NANVIX_HISTOGRAM_POST(kportal_posts[portalid]);
+
+	NANVIX_TRACE_END(NANVIX_TRACE_KPORTAL_AWRITE, portalid, ret);
 
 	return (ret);
 }
@@ -249,11 +367,23 @@ int kportal_wait(int portalid)
 {
 	int ret;
 
+	NANVIX_TRACE_BEGIN(NANVIX_TRACE_KPORTAL_WAIT, portalid);
+
 	ret = kcall1(
 		NR_portal_wait,
 		(word_t) portalid
 	);
 
+	/* Emulate the interconnect. */
+	if (ret >= 0)
+		NANVIX_LATENCY_DELIVER(kportal_posted[portalid], ret);
+
+	/* Completed: sample the time since it was posted. */
+	if (ret == 0)
+		NANVIX_HISTOGRAM_COMPLETE(&kportal_histograms[portalid], kportal_posts[portalid]);
+
+	NANVIX_TRACE_END(NANVIX_TRACE_KPORTAL_WAIT, portalid, ret);
+
 	return (ret);
 }
 
@@ -272,6 +402,10 @@ ssize_t kportal_write(int portalid, const void * buffer, size_t size)
 	size_t remainder; /* Remainder of total data.    */
 	size_t times;     /* Number of pieces.           */
 
+	/* Invalid portal. */
+	if (!WITHIN(portalid, 0, KPORTAL_MAX))
+		return (-EINVAL);
+
 	/* Invalid buffer. */
 	if (buffer == NULL)
 		return (-EINVAL);
@@ -283,23 +417,86 @@ ssize_t kportal_write(int portalid, const void * buffer, size_t size)
 	times     = size / KPORTAL_MESSAGE_DATA_SIZE;
 	remainder = size - (times * KPORTAL_MESSAGE_DATA_SIZE);
 
+	NANVIX_TRACE_BEGIN(NANVIX_TRACE_KPORTAL_WRITE, portalid);
+
 	for (size_t t = 0; t < times + (remainder != 0); ++t)
 	{
 		n = (t != times) ? KPORTAL_MESSAGE_DATA_SIZE : remainder;
 
 		/* Sends a piece of the message. */
 		if ((ret = kportal_awrite(portalid, buffer, n)) < 0)
-			return (ret);
+			goto out;
 
 		/* Waits for the asynchronous operation to complete. */
 		if ((ret = kportal_wait(portalid)) != 0)
-			return (ret);
+			goto out;
+
+		NANVIX_TRACE_INSTANT(NANVIX_TRACE_CHUNK_SEND, portalid, n);
 
 		/* Next pieces. */
 		buffer += n;
 	}
 
-	return (size);
+	ret = size;
+
+out:
+	NANVIX_TRACE_END(NANVIX_TRACE_KPORTAL_WRITE, portalid, ret);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * kportal_trywrite()                                                         *
+ *============================================================================*/
+
+/**
+ * @details The kportal_trywrite() function writes the first piece of
+ * the @p size bytes pointed to by @p buffer to the output portal @p
+ * portalid, if the remote has already allowed it. Once allowed, the
+ * piece is transferred without waiting on the remote.
+ */
+ssize_t kportal_trywrite(int portalid, const void * buffer, size_t size)
+{
+	ssize_t ret; /* Return value.             */
+	size_t n;    /* Size of first data piece. */
+
+	/* Invalid portal. */
+	if (!WITHIN(portalid, 0, KPORTAL_MAX))
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if (buffer == NULL)
+		return (-EINVAL);
+
+	/* Invalid size. */
+	if (size == 0 || size > KPORTAL_MAX_SIZE)
+		return (-EINVAL);
+
+	n = (size < KPORTAL_MESSAGE_DATA_SIZE) ? size : KPORTAL_MESSAGE_DATA_SIZE;
+
+	ret = kcall3(
+		NR_portal_awrite,
+		(word_t) portalid,
+		(word_t) buffer,
+		(word_t) n
+	);
+
+	/* Not allowed yet. */
+	if ((ret == -EACCES) || (ret == -EBUSY))
+		return (-EAGAIN);
+
+	if (ret < 0)
+		return (ret);
+
+	NANVIX_HISTOGRAM_POST(kportal_posts[portalid]);
+
+	/* Waits for the asynchronous operation to complete. */
+	if ((ret = kportal_wait(portalid)) < 0)
+		return (ret);
+
+	NANVIX_TRACE_INSTANT(NANVIX_TRACE_CHUNK_SEND, portalid, n);
+
+	return (n);
 }
 
 /*============================================================================*
@@ -319,6 +516,10 @@ ssize_t kportal_read(int portalid, void * buffer, size_t size)
 	int remote;       /* Number of target remote.    */
 	int port;         /* Number of target port.      */
 
+	/* Invalid portal. */
+	if (!WITHIN(portalid, 0, KPORTAL_MAX))
+		return (-EINVAL);
+
 	/* Invalid buffer. */
 	if (buffer == NULL)
 		return (-EINVAL);
@@ -329,33 +530,39 @@ ssize_t kportal_read(int portalid, void * buffer, size_t size)
 
 	times     = size / KPORTAL_MESSAGE_DATA_SIZE;
 	remainder = size - (times * KPORTAL_MESSAGE_DATA_SIZE);
-	ret       = (-EINVAL);
 	spinlock_lock(&kportal_lock);
 		remote = kportal_allows[portalid].remote;
 		port   = kportal_allows[portalid].port;
 	spinlock_unlock(&kportal_lock);
 
+	NANVIX_TRACE_BEGIN(NANVIX_TRACE_KPORTAL_READ, portalid);
+
 	for (size_t t = 0; t < times + (remainder != 0); ++t)
 	{
 		n = (t != times) ? KPORTAL_MESSAGE_DATA_SIZE : remainder;
 
+		/* Consecutive reads must be allowed. */
+		if (t != 0)
+		{
+			if ((ret = kportal_allow(portalid, remote, port)) < 0)
+				goto out;
+		}
+
 		/* Repeat while reading valid messages for another ports. */
 		do
 		{
-			/* Consecutive reads must be allowed. */
-			if (t != 0 && ret >= 0)
-				kportal_allow(portalid, remote, port);
-
 			/* Reads a piece of the message. */
 			if ((ret = kportal_aread(portalid, buffer, n)) < 0)
-				return (ret);
+				goto out;
 
 		/* Waits for the asynchronous operation to complete. */
 		} while ((ret = kportal_wait(portalid)) > 0);
 
 		/* Wait failed. */
 		if (ret < 0)
-			return (ret);
+			goto out;
+
+		NANVIX_TRACE_INSTANT(NANVIX_TRACE_CHUNK_RECV, portalid, n);
 
 		/* Next pieces. */
 		buffer += n;
@@ -367,6 +574,93 @@ ssize_t kportal_read(int portalid, void * buffer, size_t size)
 		kportal_allows[portalid].port   = -1;
 	spinlock_unlock(&kportal_lock);
 
+	ret = size;
+
+out:
+	NANVIX_TRACE_END(NANVIX_TRACE_KPORTAL_READ, portalid, ret);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * kportal_tryread()                                                          *
+ *============================================================================*/
+
+/**
+ * @details The kportal_tryread() reads @p size bytes of data pointed
+ * to by @p buffer from the input portal @p portalid, if the first
+ * piece of the allowed message has already arrived. The remaining
+ * pieces are then read synchronously.
+ */
+ssize_t kportal_tryread(int portalid, void * buffer, size_t size)
+{
+	ssize_t ret; /* Return value.               */
+	size_t n;    /* Size of first data piece.   */
+	int remote;  /* Number of target remote.    */
+	int port;    /* Number of target port.      */
+
+	/* Invalid portal. */
+	if (!WITHIN(portalid, 0, KPORTAL_MAX))
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if (buffer == NULL)
+		return (-EINVAL);
+
+	/* Invalid size. */
+	if (size == 0 || size > KPORTAL_MAX_SIZE)
+		return (-EINVAL);
+
+	n = (size < KPORTAL_MESSAGE_DATA_SIZE) ? size : KPORTAL_MESSAGE_DATA_SIZE;
+
+	ret = kcall3(
+		NR_portal_aread,
+		(word_t) portalid,
+		(word_t) buffer,
+		(word_t) n
+	);
+
+	/* Not ready yet. */
+	if ((ret == -EBUSY) || (ret == -ENOMSG))
+		return (-EAGAIN);
+
+	if (ret < 0)
+		return (ret);
+
+	NANVIX_LATENCY_POST(kportal_posted[portalid], n);
+	NANVIX_HISTOGRAM_POST(kportal_posts[portalid]);
+
+	/* Valid message for another port: the allow is kept. */
+	if ((ret = kportal_wait(portalid)) > 0)
+		return (-EAGAIN);
+
+	/* Wait failed. */
+	if (ret < 0)
+		return (ret);
+
+	NANVIX_TRACE_INSTANT(NANVIX_TRACE_CHUNK_RECV, portalid, n);
+
+	spinlock_lock(&kportal_lock);
+		remote = kportal_allows[portalid].remote;
+		port   = kportal_allows[portalid].port;
+	spinlock_unlock(&kportal_lock);
+
+	/* Reads the remaining pieces. */
+	if (n < size)
+	{
+		if ((ret = kportal_allow(portalid, remote, port)) < 0)
+			return (ret);
+
+		if ((ret = kportal_read(portalid, buffer + n, size - n)) < 0)
+			return (ret);
+	}
+
+	/* Complete a allowed read. */
+	spinlock_lock(&kportal_lock);
+		kportal_allows[portalid].remote = -1;
+		kportal_allows[portalid].port   = -1;
+	spinlock_unlock(&kportal_lock);
+
 	return (size);
 }
 
@@ -374,6 +668,94 @@ ssize_t kportal_read(int portalid, void * buffer, size_t size)
  * kportal_ioctl()                                                            *
  *============================================================================*/
 
+PRIVATE int kportal_ioctl_valid(void * ptr, size_t size)
+{
+	return ((ptr != NULL) && mm_check_area(VADDR(ptr), size, UMEM_AREA));
+}
+
+#if __NANVIX_IKC_STATS
+
+/**
+ * @brief Serves a latency histogram request.
+ *
+ * @param portalid Target portal.
+ * @param request  Request.
+ * @param args     Additional arguments.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+PRIVATE int kportal_ioctl_histogram(int portalid, unsigned request, va_list args)
+{
+	struct nanvix_histogram_summary * summary;
+
+	/* Bad portal. */
+	if (kcomm_get_port(portalid, COMM_TYPE_PORTAL) < 0)
+		return (-EBADF);
+
+	/* Discard samples. */
+	if (request == KPORTAL_IOCTL_RESET_HISTOGRAM)
+	{
+		nanvix_histogram_reset(&kportal_histograms[portalid]);
+		return (0);
+	}
+
+	summary = va_arg(args, struct nanvix_histogram_summary *);
+
+	/* Bad buffer. */
+	if (!kportal_ioctl_valid(summary, sizeof(struct nanvix_histogram_summary)))
+		return (-EFAULT);
+
+	nanvix_histogram_summary(&kportal_histograms[portalid], summary);
+
+	return (0);
+}
+
+#endif /* __NANVIX_IKC_STATS */
+
+/**
+ * @brief Serves a wait policy request.
+ *
+ * @param portalid Target portal.
+ * @param request  Request.
+ * @param args     Additional arguments.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+PRIVATE int kportal_ioctl_backoff(int portalid, unsigned request, va_list args)
+{
+	int policy;
+	int * ppolicy;
+
+	/* Bad portal. */
+	if (kcomm_get_port(portalid, COMM_TYPE_PORTAL) < 0)
+		return (-EBADF);
+
+	if (request == KPORTAL_IOCTL_SET_BACKOFF)
+	{
+		policy = va_arg(args, int);
+
+		/* Invalid policy. */
+		if (!NANVIX_BACKOFF_IS_VALID(policy))
+			return (-EINVAL);
+
+		kportal_backoffs[portalid] = policy;
+
+		return (0);
+	}
+
+	ppolicy = va_arg(args, int *);
+
+	/* Bad buffer. */
+	if (!kportal_ioctl_valid(ppolicy, sizeof(int)))
+		return (-EFAULT);
+
+	*ppolicy = kportal_backoffs[portalid];
+
+	return (0);
+}
+
 /**
  * @details The kportal_ioctl() reads the measurement parameter associated
  * with the request id @p request of the portal @p portalid.
@@ -385,6 +767,28 @@ int kportal_ioctl(int portalid, unsigned request, ...)
 
 	va_start(args, request);
 
+		/* Latency histograms are kept in user space. */
+		if ((request == KPORTAL_IOCTL_GET_HISTOGRAM) || (request == KPORTAL_IOCTL_RESET_HISTOGRAM))
+		{
+#if __NANVIX_IKC_STATS
+			ret = kportal_ioctl_histogram(portalid, request, args);
+#else
+			ret = (-ENOTSUP);
+#endif /* __NANVIX_IKC_STATS */
+			va_end(args);
+
+			return (ret);
+		}
+
+		/* So are wait policies. */
+		if ((request == KPORTAL_IOCTL_SET_BACKOFF) || (request == KPORTAL_IOCTL_GET_BACKOFF))
+		{
+			ret = kportal_ioctl_backoff(portalid, request, args);
+			va_end(args);
+
+			return (ret);
+		}
+
 		dcache_invalidate();
 
 		ret = kcall3(
@@ -431,6 +835,12 @@ PUBLIC int kportal_get_port(int portalid)
 PUBLIC void kportal_init(void)
 {
 	kprintf("[user][portal] Initializes portal module");
+
+	for (int i = 0; i < KPORTAL_MAX; ++i)
+	{
+		nanvix_histogram_init(&kportal_histograms[i]);
+		kportal_backoffs[i] = NANVIX_BACKOFF_DEFAULT;
+	}
 }
 
 #else
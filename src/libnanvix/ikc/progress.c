@@ -0,0 +1,165 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <nanvix/sys/progress.h>
+
+#if __TARGET_HAS_MAILBOX && __NANVIX_IKC_USES_ONLY_MAILBOX
+
+#include <nanvix/sys/backoff.h>
+#include <nanvix/sys/rma.h>
+#include <nanvix/sys/thread.h>
+#include <posix/errno.h>
+
+/**
+ * @brief Is the progress engine running?
+ */
+PRIVATE volatile bool progress_running = false;
+
+/**
+ * @brief Protects start and stop.
+ */
+PRIVATE spinlock_t progress_lock = SPINLOCK_UNLOCKED;
+
+/**
+ * @brief Thread of the progress engine.
+ */
+PRIVATE kthread_t progress_tid = -1;
+
+/*============================================================================*
+ * nanvix_ikc_progress_loop()                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Main loop of the progress engine.
+ *
+ * @param arg Unused.
+ *
+ * @returns Always NULL.
+ */
+PRIVATE void * nanvix_ikc_progress_loop(void * arg)
+{
+	struct nanvix_backoff backoff; /* Wait when idle. */
+
+	((void) arg);
+
+	nanvix_backoff_init(&backoff, NANVIX_BACKOFF_DEFAULT);
+
+	while (progress_running)
+	{
+		/* Idle, so back off. */
+		if ((kmailbox_progress() + kportal_progress() + ksync_progress() + krma_progress()) == 0)
+			nanvix_backoff_wait(&backoff);
+		else
+			nanvix_backoff_init(&backoff, NANVIX_BACKOFF_DEFAULT);
+	}
+
+	return (NULL);
+}
+
+/*============================================================================*
+ * nanvix_ikc_progress_start()                                                *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_ikc_progress_start() function spawns the thread
+ * of the progress engine.
+ */
+PUBLIC int nanvix_ikc_progress_start(void)
+{
+	spinlock_lock(&progress_lock);
+
+		/* Already running. */
+		if (progress_running)
+		{
+			spinlock_unlock(&progress_lock);
+			return (-EBUSY);
+		}
+
+		progress_running = true;
+
+		if (kthread_create(&progress_tid, nanvix_ikc_progress_loop, NULL) < 0)
+		{
+			progress_running = false;
+			spinlock_unlock(&progress_lock);
+			return (-EAGAIN);
+		}
+
+	spinlock_unlock(&progress_lock);
+
+	return (0);
+}
+
+/*============================================================================*
+ * nanvix_ikc_progress_stop()                                                 *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_ikc_progress_stop() function stops the thread of
+ * the progress engine and wakes up all threads that sleep on it.
+ */
+PUBLIC int nanvix_ikc_progress_stop(void)
+{
+	kthread_t tid; /* Engine thread. */
+
+	spinlock_lock(&progress_lock);
+
+		/* Not running. */
+		if (!progress_running)
+		{
+			spinlock_unlock(&progress_lock);
+			return (-EINVAL);
+		}
+
+		progress_running = false;
+		tid              = progress_tid;
+		progress_tid     = -1;
+
+	spinlock_unlock(&progress_lock);
+
+	kthread_join(tid, NULL);
+
+	/* Sleepers go back to polling. */
+	kportal_progress_release();
+	ksync_progress_release();
+
+	return (0);
+}
+
+/*============================================================================*
+ * nanvix_ikc_progress_is_running()                                           *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_ikc_progress_is_running() function asserts
+ * whether the progress engine is running.
+ */
+PUBLIC bool nanvix_ikc_progress_is_running(void)
+{
+	return (progress_running);
+}
+
+#else
+extern int make_iso_compilers_happy;
+#endif /* __TARGET_HAS_MAILBOX && __NANVIX_IKC_USES_ONLY_MAILBOX */
@@ -0,0 +1,1032 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <nanvix/sys/rma.h>
+
+#if __TARGET_HAS_MAILBOX
+
+#include <nanvix/sys/backoff.h>
+#include <nanvix/sys/mailbox.h>
+#include <nanvix/sys/noc.h>
+#include <nanvix/sys/portal.h>
+#include <posix/errno.h>
+#include <posix/stdbool.h>
+#include <posix/stdint.h>
+
+/**
+ * @brief Are payloads moved over portals?
+ *
+ * Portals built on mailboxes wait on the progress engine, which serves
+ * RMA requests itself, so that configuration carries payloads in the
+ * control messages instead.
+ */
+#if __TARGET_HAS_PORTAL && !__NANVIX_IKC_USES_ONLY_MAILBOX
+	#define KRMA_USES_PORTAL 1
+#else
+	#define KRMA_USES_PORTAL 0
+#endif
+
+/**
+ * @name Operations.
+ */
+/**@{*/
+#define KRMA_PUT         0 /**< Write to a window.       */
+#define KRMA_GET         1 /**< Read from a window.      */
+#define KRMA_FLUSH       2 /**< Acknowledge prior puts.  */
+#define KRMA_GET_REPLY   3 /**< Data of a read.          */
+#define KRMA_FLUSH_REPLY 4 /**< Acknowledgement.         */
+#define KRMA_PUT_REPLY   5 /**< Write accepted.          */
+/**@}*/
+
+/**
+ * @brief Header of an RMA message.
+ */
+struct krma_header
+{
+	uint8_t opcode;  /**< Operation.                   */
+	uint8_t source;  /**< Source node.                 */
+	uint16_t winid;  /**< Target window.               */
+	int32_t status;  /**< Status of a reply.           */
+	uint32_t size;   /**< Size of data.                */
+	uint32_t offset; /**< Offset in the target window. */
+};
+
+/**
+ * @brief Size of the data carried by an RMA message.
+ */
+#define KRMA_DATA_SIZE (KMAILBOX_MESSAGE_SIZE - sizeof(struct krma_header))
+
+/**
+ * @brief RMA message.
+ */
+struct krma_message
+{
+	struct krma_header header; /**< Header. */
+	char data[KRMA_DATA_SIZE]; /**< Data.   */
+};
+
+/**
+ * @brief Size of an RMA message.
+ */
+#define KRMA_MESSAGE_SIZE sizeof(struct krma_message)
+
+/**
+ * @brief Is the RMA layer set up?
+ */
+PRIVATE bool krma_is_setup = false;
+
+/**
+ * @brief Exposed windows.
+ */
+PRIVATE struct
+{
+	bool used;   /**< Used window? */
+	void *base;  /**< Base.        */
+	size_t size; /**< Size.        */
+} krma_windows[KRMA_WINDOW_MAX];
+
+/**
+ * @name Mailboxes.
+ */
+/**@{*/
+PRIVATE int krma_inbox    = -1;                                                           /**< Requests.         */
+PRIVATE int krma_replybox = -1;                                                           /**< Replies.          */
+PRIVATE int krma_outboxes[PROCESSOR_NOC_NODES_NUM]   = { [0 ... (PROCESSOR_NOC_NODES_NUM - 1)] = -1 }; /**< Requests to. */
+PRIVATE int krma_replyouts[PROCESSOR_NOC_NODES_NUM]  = { [0 ... (PROCESSOR_NOC_NODES_NUM - 1)] = -1 }; /**< Replies to.  */
+/**@}*/
+
+#if KRMA_USES_PORTAL
+
+/**
+ * @name Portals.
+ */
+/**@{*/
+PRIVATE int krma_inportal    = -1;                                                           /**< Written data.     */
+PRIVATE int krma_replyportal = -1;                                                           /**< Read data.        */
+PRIVATE int krma_outportals[PROCESSOR_NOC_NODES_NUM] = { [0 ... (PROCESSOR_NOC_NODES_NUM - 1)] = -1 }; /**< Writes to.   */
+PRIVATE int krma_replyports[PROCESSOR_NOC_NODES_NUM] = { [0 ... (PROCESSOR_NOC_NODES_NUM - 1)] = -1 }; /**< Reads by.    */
+/**@}*/
+
+/**
+ * @brief Requests put aside while the local node waits for a reply.
+ */
+PRIVATE struct
+{
+	bool pending;            /**< Pending request? */
+	struct krma_message msg; /**< Request.         */
+} krma_deferred[PROCESSOR_NOC_NODES_NUM];
+
+#endif /* KRMA_USES_PORTAL */
+
+/**
+ * @brief Nodes with puts not flushed yet.
+ */
+PRIVATE bool krma_dirty[PROCESSOR_NOC_NODES_NUM];
+
+/**
+ * @brief Nodes with puts rejected since their last flush.
+ */
+PRIVATE bool krma_errors[PROCESSOR_NOC_NODES_NUM];
+
+/**
+ * @name Protections.
+ */
+/**@{*/
+PRIVATE spinlock_t krma_origin_lock  = SPINLOCK_UNLOCKED; /**< Issued operations. */
+PRIVATE spinlock_t krma_service_lock = SPINLOCK_UNLOCKED; /**< Served requests.   */
+PRIVATE spinlock_t krma_window_lock  = SPINLOCK_UNLOCKED; /**< Windows.           */
+/**@}*/
+
+/*============================================================================*
+ * Helpers                                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Gets the memory of a window.
+ *
+ * @param winid  Target window.
+ * @param offset Offset in the window.
+ * @param size   Size of the access.
+ *
+ * @returns The address at @p offset of the window, or NULL if the
+ * access falls outside an exposed window.
+ */
+PRIVATE char * krma_window_address(int winid, size_t offset, size_t size)
+{
+	char *addr = NULL;
+
+	spinlock_lock(&krma_window_lock);
+
+		if (WITHIN(winid, 0, KRMA_WINDOW_MAX) && krma_windows[winid].used)
+		{
+			if ((size <= krma_windows[winid].size) && (offset <= (krma_windows[winid].size - size)))
+				addr = (char *) krma_windows[winid].base + offset;
+		}
+
+	spinlock_unlock(&krma_window_lock);
+
+	return (addr);
+}
+
+/**
+ * @brief Opens an output mailbox on demand.
+ *
+ * @param mbxids Table of output mailboxes.
+ * @param remote Target NoC node.
+ * @param port   Target port.
+ *
+ * @returns Upon successful completion, the ID of the output mailbox is
+ * returned. Upon failure, a negative error code is returned instead.
+ */
+PRIVATE int krma_outbox(int * mbxids, int remote, int port)
+{
+	if (mbxids[remote] < 0)
+		mbxids[remote] = kmailbox_open(remote, port);
+
+	return (mbxids[remote]);
+}
+
+#if KRMA_USES_PORTAL
+
+/**
+ * @brief Opens an output portal on demand.
+ *
+ * @param portalids Table of output portals.
+ * @param remote    Target NoC node.
+ * @param port      Target port.
+ *
+ * @returns Upon successful completion, the ID of the output portal is
+ * returned. Upon failure, a negative error code is returned instead.
+ */
+PRIVATE int krma_outportal(int * portalids, int remote, int port)
+{
+	if (portalids[remote] < 0)
+		portalids[remote] = kportal_open(knode_get_num(), remote, port);
+
+	return (portalids[remote]);
+}
+
+/**
+ * @brief Puts aside a request that cannot be served now.
+ *
+ * A node that waits for a reply serves payloads only for nodes with a
+ * lower number, so no two nodes block on each other's payloads.
+ * Requests of the other nodes are served once the wait is over.
+ *
+ * @param msg Target request.
+ *
+ * @returns Non-zero if @p msg was put aside, and zero otherwise.
+ *
+ * @note The service lock must be held.
+ */
+PRIVATE int krma_defer(const struct krma_message * msg)
+{
+	int source;
+
+	source = msg->header.source;
+
+	/* No payload. */
+	if (msg->header.opcode == KRMA_FLUSH)
+		return (0);
+
+	/* The source does not wait on us. */
+	if (!WITHIN(source, knode_get_num() + 1, PROCESSOR_NOC_NODES_NUM))
+		return (0);
+
+	kmemcpy(&krma_deferred[source].msg, msg, KRMA_MESSAGE_SIZE);
+	krma_deferred[source].pending = true;
+
+	return (1);
+}
+
+/**
+ * @brief Takes back a request that was put aside.
+ *
+ * @param msg Store location for the request.
+ *
+ * @returns Non-zero if a request was taken, and zero otherwise.
+ *
+ * @note The service lock must be held.
+ */
+PRIVATE int krma_undefer(struct krma_message * msg)
+{
+	for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; i++)
+	{
+		if (krma_deferred[i].pending)
+		{
+			kmemcpy(msg, &krma_deferred[i].msg, KRMA_MESSAGE_SIZE);
+			krma_deferred[i].pending = false;
+
+			return (1);
+		}
+	}
+
+	return (0);
+}
+
+#endif /* KRMA_USES_PORTAL */
+
+/**
+ * @brief Replies to a request.
+ *
+ * @param msg    Target reply.
+ * @param source Node that issued the request.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+PRIVATE int krma_reply(struct krma_message * msg, int source)
+{
+	int outbox;
+	ssize_t ret;
+
+	msg->header.source = (uint8_t) knode_get_num();
+
+	if ((outbox = krma_outbox(krma_replyouts, source, KRMA_REPLY_PORT)) < 0)
+		return (outbox);
+
+	if ((ret = kmailbox_write(outbox, msg, KRMA_MESSAGE_SIZE)) < 0)
+		return ((int) ret);
+
+	return (0);
+}
+
+/**
+ * @brief Serves a request.
+ *
+ * @param msg Target request.
+ *
+ * @note The service lock must be held.
+ */
+PRIVATE void krma_serve(struct krma_message * msg)
+{
+	int source;
+	char *addr;
+	size_t size;
+#if KRMA_USES_PORTAL
+	int outportal;
+#endif
+
+	source = msg->header.source;
+
+	/* Invalid source. */
+	if (!WITHIN(source, 0, PROCESSOR_NOC_NODES_NUM))
+		return;
+
+	size = msg->header.size;
+	addr = krma_window_address(msg->header.winid, msg->header.offset, size);
+
+#if !KRMA_USES_PORTAL
+
+	/* Payloads travel in the messages. */
+	if (size > KRMA_DATA_SIZE)
+		addr = NULL;
+
+#endif
+
+	switch (msg->header.opcode)
+	{
+		case KRMA_PUT:
+		{
+#if KRMA_USES_PORTAL
+			msg->header.opcode = KRMA_PUT_REPLY;
+			msg->header.status = 0;
+
+			if ((addr == NULL) || (kportal_allow(krma_inportal, source, KRMA_DATA_PORT) < 0))
+				msg->header.status = -EFAULT;
+
+			/* The origin sends the payload once accepted. */
+			if ((krma_reply(msg, source) == 0) && (msg->header.status == 0))
+			{
+				if (kportal_read(krma_inportal, addr, size) < 0)
+					msg->header.status = -EFAULT;
+			}
+
+			if (msg->header.status < 0)
+				krma_errors[source] = true;
+#else
+			if (addr == NULL)
+				krma_errors[source] = true;
+			else
+				kmemcpy(addr, msg->data, size);
+#endif
+		} return;
+
+		case KRMA_GET:
+		{
+			msg->header.opcode = KRMA_GET_REPLY;
+			msg->header.status = (addr == NULL) ? -EFAULT : 0;
+
+#if KRMA_USES_PORTAL
+			outportal = -1;
+
+			if ((msg->header.status == 0) && ((outportal = krma_outportal(krma_replyports, source, KRMA_REPLY_DATA_PORT)) < 0))
+				msg->header.status = outportal;
+
+			/* The origin allows the payload once it gets the reply. */
+			if ((krma_reply(msg, source) == 0) && (msg->header.status == 0))
+			{
+				if (kportal_write(outportal, addr, size) < 0)
+					krma_errors[source] = true;
+			}
+#else
+			if (addr != NULL)
+				kmemcpy(msg->data, addr, size);
+
+			krma_reply(msg, source);
+#endif
+		} return;
+
+		case KRMA_FLUSH:
+		{
+			msg->header.opcode  = KRMA_FLUSH_REPLY;
+			msg->header.status  = (krma_errors[source]) ? -EFAULT : 0;
+			krma_errors[source] = false;
+
+			krma_reply(msg, source);
+		} return;
+
+		/* Unknown request. */
+		default:
+			return;
+	}
+}
+
+/**
+ * @brief Serves at most one request, without blocking.
+ *
+ * @param waiting Is the calling thread waiting for a reply?
+ *
+ * @returns The number of served requests.
+ */
+PRIVATE int krma_service(bool waiting)
+{
+	int ret;
+	struct krma_message msg;
+
+	if (!krma_is_setup)
+		return (0);
+
+	ret = 0;
+
+	spinlock_lock(&krma_service_lock);
+
+#if KRMA_USES_PORTAL
+		if (!waiting)
+			ret = krma_undefer(&msg);
+#else
+		((void) waiting);
+#endif
+
+		if ((ret == 0) && (kmailbox_tryread(krma_inbox, &msg, KRMA_MESSAGE_SIZE) == KRMA_MESSAGE_SIZE))
+		{
+			ret = 1;
+
+#if KRMA_USES_PORTAL
+			if (waiting && krma_defer(&msg))
+				ret = 0;
+#endif
+		}
+
+		if (ret)
+			krma_serve(&msg);
+
+	spinlock_unlock(&krma_service_lock);
+
+	return (ret);
+}
+
+/**
+ * @brief Waits for a reply, serving requests meanwhile.
+ *
+ * @param msg Store location for the reply.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ *
+ * @note The origin lock must be held.
+ */
+PRIVATE int krma_wait_reply(struct krma_message * msg)
+{
+	ssize_t ret;
+	struct nanvix_backoff backoff;
+
+	nanvix_backoff_init(&backoff, NANVIX_BACKOFF_DEFAULT);
+
+	/* The remote may be waiting for us as well. */
+	while ((ret = kmailbox_tryread(krma_replybox, msg, KRMA_MESSAGE_SIZE)) == -EAGAIN)
+	{
+		if (krma_service(true) == 0)
+			nanvix_backoff_wait(&backoff);
+	}
+
+	return ((ret < 0) ? (int) ret : 0);
+}
+
+/**
+ * @brief Serves the requests put aside while waiting for a reply.
+ */
+PRIVATE void krma_drain(void)
+{
+#if KRMA_USES_PORTAL
+	for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; i++)
+	{
+		while (krma_deferred[i].pending)
+			krma_service(false);
+	}
+#endif
+}
+
+/*============================================================================*
+ * krma_setup()                                                               *
+ *============================================================================*/
+
+/**
+ * @details The krma_setup() function creates the mailboxes where the
+ * local node receives RMA requests and replies, and the portals where
+ * it receives their payloads.
+ */
+PUBLIC int krma_setup(void)
+{
+	int local;
+
+	/* Already set up. */
+	if (krma_is_setup)
+		return (-EBUSY);
+
+	local = knode_get_num();
+
+	if ((krma_inbox = kmailbox_create(local, KRMA_REQUEST_PORT)) < 0)
+		return (krma_inbox);
+
+	if ((krma_replybox = kmailbox_create(local, KRMA_REPLY_PORT)) < 0)
+	{
+		kmailbox_unlink(krma_inbox);
+		return (krma_replybox);
+	}
+
+#if KRMA_USES_PORTAL
+
+	if ((krma_inportal = kportal_create(local, KRMA_DATA_PORT)) < 0)
+	{
+		kmailbox_unlink(krma_replybox);
+		kmailbox_unlink(krma_inbox);
+		return (krma_inportal);
+	}
+
+	if ((krma_replyportal = kportal_create(local, KRMA_REPLY_DATA_PORT)) < 0)
+	{
+		kportal_unlink(krma_inportal);
+		kmailbox_unlink(krma_replybox);
+		kmailbox_unlink(krma_inbox);
+		return (krma_replyportal);
+	}
+
+#endif
+
+	for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; i++)
+	{
+		krma_dirty[i]  = false;
+		krma_errors[i] = false;
+#if KRMA_USES_PORTAL
+		krma_deferred[i].pending = false;
+#endif
+	}
+
+	krma_is_setup = true;
+
+	return (0);
+}
+
+/*============================================================================*
+ * krma_cleanup()                                                             *
+ *============================================================================*/
+
+/**
+ * @details The krma_cleanup() function releases the mailboxes and
+ * portals of the RMA layer. Writes that were not flushed are discarded.
+ */
+PUBLIC int krma_cleanup(void)
+{
+	/* Not set up. */
+	if (!krma_is_setup)
+		return (-EINVAL);
+
+	krma_is_setup = false;
+
+	spinlock_lock(&krma_origin_lock);
+	spinlock_lock(&krma_service_lock);
+
+		for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; i++)
+		{
+			if (krma_outboxes[i] >= 0)
+				kmailbox_close(krma_outboxes[i]);
+
+			if (krma_replyouts[i] >= 0)
+				kmailbox_close(krma_replyouts[i]);
+
+			krma_outboxes[i]  = -1;
+			krma_replyouts[i] = -1;
+
+#if KRMA_USES_PORTAL
+			if (krma_outportals[i] >= 0)
+				kportal_close(krma_outportals[i]);
+
+			if (krma_replyports[i] >= 0)
+				kportal_close(krma_replyports[i]);
+
+			krma_outportals[i] = -1;
+			krma_replyports[i] = -1;
+#endif
+		}
+
+		kmailbox_unlink(krma_replybox);
+		kmailbox_unlink(krma_inbox);
+
+		krma_replybox = -1;
+		krma_inbox    = -1;
+
+#if KRMA_USES_PORTAL
+		kportal_unlink(krma_replyportal);
+		kportal_unlink(krma_inportal);
+
+		krma_replyportal = -1;
+		krma_inportal    = -1;
+#endif
+
+	spinlock_unlock(&krma_service_lock);
+	spinlock_unlock(&krma_origin_lock);
+
+	return (0);
+}
+
+/*============================================================================*
+ * krma_window_create()                                                       *
+ *============================================================================*/
+
+/**
+ * @details The krma_window_create() function exposes the @p size bytes
+ * at @p base to remote access.
+ */
+PUBLIC int krma_window_create(void * base, size_t size)
+{
+	int winid;
+
+	/* Invalid base. */
+	if (base == NULL)
+		return (-EINVAL);
+
+	/* Invalid size. */
+	if (size == 0)
+		return (-EINVAL);
+
+	spinlock_lock(&krma_window_lock);
+
+		for (winid = 0; winid < KRMA_WINDOW_MAX; winid++)
+		{
+			if (!krma_windows[winid].used)
+				break;
+		}
+
+		/* No window available. */
+		if (winid == KRMA_WINDOW_MAX)
+			winid = (-EAGAIN);
+		else
+		{
+			krma_windows[winid].used = true;
+			krma_windows[winid].base = base;
+			krma_windows[winid].size = size;
+		}
+
+	spinlock_unlock(&krma_window_lock);
+
+	return (winid);
+}
+
+/*============================================================================*
+ * krma_window_free()                                                         *
+ *============================================================================*/
+
+/**
+ * @details The krma_window_free() function withdraws the window @p
+ * winid from remote access.
+ */
+PUBLIC int krma_window_free(int winid)
+{
+	int ret;
+
+	/* Invalid window. */
+	if (!WITHIN(winid, 0, KRMA_WINDOW_MAX))
+		return (-EINVAL);
+
+	ret = (-EBADF);
+
+	spinlock_lock(&krma_window_lock);
+
+		if (krma_windows[winid].used)
+		{
+			krma_windows[winid].used = false;
+			ret = 0;
+		}
+
+	spinlock_unlock(&krma_window_lock);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * kput()                                                                     *
+ *============================================================================*/
+
+/**
+ * @details The kput() function writes @p size bytes of @p buffer at
+ * @p offset of the window @p winid of the node @p remote. Writes to
+ * the local node are applied at once.
+ */
+PUBLIC int kput(int remote, int winid, size_t offset, const void * buffer, size_t size)
+{
+	int ret;
+	int outbox;
+	char *addr;
+	struct krma_message msg;
+#if KRMA_USES_PORTAL
+	int outportal;
+#else
+	size_t n;
+#endif
+
+	/* Invalid remote. */
+	if (!WITHIN(remote, 0, PROCESSOR_NOC_NODES_NUM))
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if ((buffer == NULL) || (size == 0))
+		return (-EINVAL);
+
+	/* Range does not fit in a request. */
+	if (((uint64_t) offset > UINT32_MAX) || ((uint64_t) size > (UINT32_MAX - (uint64_t) offset)))
+		return (-EINVAL);
+
+	/* Not set up. */
+	if (!krma_is_setup)
+		return (-EINVAL);
+
+	/* Local window. */
+	if (remote == knode_get_num())
+	{
+		if ((addr = krma_window_address(winid, offset, size)) == NULL)
+			return (-EFAULT);
+
+		kmemcpy(addr, buffer, size);
+
+		return (0);
+	}
+
+	ret = 0;
+
+	spinlock_lock(&krma_origin_lock);
+
+		if ((outbox = krma_outbox(krma_outboxes, remote, KRMA_REQUEST_PORT)) < 0)
+		{
+			ret = outbox;
+			goto error;
+		}
+
+		msg.header.opcode = KRMA_PUT;
+		msg.header.source = (uint8_t) knode_get_num();
+		msg.header.winid  = (uint16_t) winid;
+		msg.header.status = 0;
+
+#if KRMA_USES_PORTAL
+
+		if ((outportal = krma_outportal(krma_outportals, remote, KRMA_DATA_PORT)) < 0)
+		{
+			ret = outportal;
+			goto error;
+		}
+
+		msg.header.size   = (uint32_t) size;
+		msg.header.offset = (uint32_t) offset;
+
+		if ((ret = kmailbox_write(outbox, &msg, KRMA_MESSAGE_SIZE)) < 0)
+			goto error;
+
+		krma_dirty[remote] = true;
+
+		if ((ret = krma_wait_reply(&msg)) < 0)
+			goto error;
+
+		/* Rejected writes are reported by krma_flush(). */
+		if ((msg.header.status == 0) && ((ret = kportal_write(outportal, buffer, size)) < 0))
+			goto error;
+
+#else
+
+		for (size_t i = 0; i < size; i += n)
+		{
+			n = ((size - i) < KRMA_DATA_SIZE) ? (size - i) : KRMA_DATA_SIZE;
+
+			msg.header.size   = (uint32_t) n;
+			msg.header.offset = (uint32_t) (offset + i);
+			kmemcpy(msg.data, (const char *) buffer + i, n);
+
+			if ((ret = kmailbox_write(outbox, &msg, KRMA_MESSAGE_SIZE)) < 0)
+				goto error;
+
+			krma_dirty[remote] = true;
+		}
+
+#endif
+
+		ret = 0;
+
+error:
+	spinlock_unlock(&krma_origin_lock);
+
+	krma_drain();
+
+	return (ret);
+}
+
+/*============================================================================*
+ * kget()                                                                     *
+ *============================================================================*/
+
+/**
+ * @details The kget() function reads @p size bytes at @p offset of the
+ * window @p winid of the node @p remote into @p buffer. Reads from the
+ * local node are served at once.
+ */
+PUBLIC int kget(int remote, int winid, size_t offset, void * buffer, size_t size)
+{
+	int ret;
+	int outbox;
+	char *addr;
+	struct krma_message msg;
+#if !KRMA_USES_PORTAL
+	size_t n;
+#endif
+
+	/* Invalid remote. */
+	if (!WITHIN(remote, 0, PROCESSOR_NOC_NODES_NUM))
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if ((buffer == NULL) || (size == 0))
+		return (-EINVAL);
+
+	/* Range does not fit in a request. */
+	if (((uint64_t) offset > UINT32_MAX) || ((uint64_t) size > (UINT32_MAX - (uint64_t) offset)))
+		return (-EINVAL);
+
+	/* Not set up. */
+	if (!krma_is_setup)
+		return (-EINVAL);
+
+	/* Local window. */
+	if (remote == knode_get_num())
+	{
+		if ((addr = krma_window_address(winid, offset, size)) == NULL)
+			return (-EFAULT);
+
+		kmemcpy(buffer, addr, size);
+
+		return (0);
+	}
+
+	ret = 0;
+
+	spinlock_lock(&krma_origin_lock);
+
+		if ((outbox = krma_outbox(krma_outboxes, remote, KRMA_REQUEST_PORT)) < 0)
+		{
+			ret = outbox;
+			goto error;
+		}
+
+#if KRMA_USES_PORTAL
+
+		msg.header.opcode = KRMA_GET;
+		msg.header.source = (uint8_t) knode_get_num();
+		msg.header.winid  = (uint16_t) winid;
+		msg.header.size   = (uint32_t) size;
+		msg.header.status = 0;
+		msg.header.offset = (uint32_t) offset;
+
+		if ((ret = kmailbox_write(outbox, &msg, KRMA_MESSAGE_SIZE)) < 0)
+			goto error;
+
+		if ((ret = krma_wait_reply(&msg)) < 0)
+			goto error;
+
+		/* Rejected. */
+		if ((ret = msg.header.status) < 0)
+			goto error;
+
+		/* The remote sends the payload once allowed. */
+		if ((ret = kportal_allow(krma_replyportal, remote, KRMA_REPLY_DATA_PORT)) < 0)
+			goto error;
+
+		if ((ret = kportal_read(krma_replyportal, buffer, size)) < 0)
+			goto error;
+
+#else
+
+		for (size_t i = 0; i < size; i += n)
+		{
+			n = ((size - i) < KRMA_DATA_SIZE) ? (size - i) : KRMA_DATA_SIZE;
+
+			msg.header.opcode = KRMA_GET;
+			msg.header.source = (uint8_t) knode_get_num();
+			msg.header.winid  = (uint16_t) winid;
+			msg.header.size   = (uint32_t) n;
+			msg.header.status = 0;
+			msg.header.offset = (uint32_t) (offset + i);
+
+			if ((ret = kmailbox_write(outbox, &msg, KRMA_MESSAGE_SIZE)) < 0)
+				goto error;
+
+			if ((ret = krma_wait_reply(&msg)) < 0)
+				goto error;
+
+			/* Rejected. */
+			if ((ret = msg.header.status) < 0)
+				goto error;
+
+			kmemcpy((char *) buffer + i, msg.data, n);
+		}
+
+#endif
+
+		ret = 0;
+
+error:
+	spinlock_unlock(&krma_origin_lock);
+
+	krma_drain();
+
+	return (ret);
+}
+
+/*============================================================================*
+ * krma_flush()                                                               *
+ *============================================================================*/
+
+/**
+ * @details The krma_flush() function waits until the node @p remote
+ * has applied all writes issued to it so far.
+ */
+PUBLIC int krma_flush(int remote)
+{
+	int ret;
+	int outbox;
+	struct krma_message msg;
+
+	/* Invalid remote. */
+	if (!WITHIN(remote, 0, PROCESSOR_NOC_NODES_NUM))
+		return (-EINVAL);
+
+	/* Not set up. */
+	if (!krma_is_setup)
+		return (-EINVAL);
+
+	ret = 0;
+
+	spinlock_lock(&krma_origin_lock);
+
+		/* Nothing to flush. */
+		if (!krma_dirty[remote])
+			goto error;
+
+		if ((outbox = krma_outbox(krma_outboxes, remote, KRMA_REQUEST_PORT)) < 0)
+		{
+			ret = outbox;
+			goto error;
+		}
+
+		msg.header.opcode = KRMA_FLUSH;
+		msg.header.source = (uint8_t) knode_get_num();
+		msg.header.winid  = 0;
+		msg.header.size   = 0;
+		msg.header.status = 0;
+		msg.header.offset = 0;
+
+		if ((ret = kmailbox_write(outbox, &msg, KRMA_MESSAGE_SIZE)) < 0)
+			goto error;
+
+		if ((ret = krma_wait_reply(&msg)) < 0)
+			goto error;
+
+		krma_dirty[remote] = false;
+		ret                = msg.header.status;
+
+error:
+	spinlock_unlock(&krma_origin_lock);
+
+	krma_drain();
+
+	return (ret);
+}
+
+/*============================================================================*
+ * krma_fence()                                                               *
+ *============================================================================*/
+
+/**
+ * @details The krma_fence() function waits until all remote nodes have
+ * applied the writes issued to them so far.
+ */
+PUBLIC int krma_fence(void)
+{
+	int ret;
+	int err;
+
+	ret = 0;
+
+	for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; i++)
+	{
+		if (krma_dirty[i] && ((err = krma_flush(i)) < 0))
+			ret = err;
+	}
+
+	return (ret);
+}
+
+/*============================================================================*
+ * krma_progress()                                                            *
+ *============================================================================*/
+
+/**
+ * @details The krma_progress() function serves, without blocking, at
+ * most one request that has arrived at the local node.
+ */
+PUBLIC int krma_progress(void)
+{
+	return (krma_service(false));
+}
+
+#else
+extern int make_iso_compilers_happy;
+#endif /* __TARGET_HAS_MAILBOX */
@@ -27,69 +27,107 @@
 #if __TARGET_HAS_MAILBOX
 
 #include <nanvix/sys/thread.h>
+#include <nanvix/sys/tls.h>
 #include <nanvix/sys/noc.h>
 #include <nanvix/runtime/stdikc.h>
 
 /**
- * @brief Kernel standard input mailbox.
+ * @brief Number of standard input mailboxs.
  */
-static int __stdinbox[THREAD_MAX + 1] = {
-	[0 ... THREAD_MAX] = -1
+#define __STDINBOX_MAX NANVIX_TLS_THREADS
+
+/**
+ * @brief Kernel standard input mailboxs.
+ *
+ * Entries are indexed by the port of their owner thread, which is
+ * derived from its ID. An entry is written only by its owner, so it
+ * caches the mailbox of the thread without locking. Mailboxs are created
+ * on first use, so no port is bound for threads that never
+ * communicate.
+ */
+static int __stdinbox[__STDINBOX_MAX] = {
+	[0 ... (__STDINBOX_MAX - 1)] = -1
 };
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * @details The stdinbox_get_port() function returns the port of the
+ * standard input mailbox of the calling thread. The port is derived
+ * from the ID of the thread, so remote peers can predict it.
  */
 int stdinbox_get_port(void)
 {
-	int port = (kthread_self() - (SYS_THREAD_MAX - 1));
+	int port = nanvix_tls_slot(kthread_self());
+
+	/* Out of ports. */
+	if ((port < 0) || (port >= KMAILBOX_PORT_NR))
+		return (-1);
 
-	/* Kernel thread ? 0 else port. */
-	return ((port <= 0) ? 0 : port);
+	return (port);
 }
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * @brief Gets the standard input mailbox of the calling thread,
+ * creating it on first use.
+ *
+ * @returns The standard input mailbox of the calling thread, or a
+ * negative number upon failure.
  */
-int __stdmailbox_setup(void)
+static int __stdinbox_lookup(void)
 {
-	int tid;
+	int port;
 
-	if ((tid = stdinbox_get_port()) > (THREAD_MAX + 1))
+	if ((port = stdinbox_get_port()) < 0)
 		return (-1);
 
-	if (__stdinbox[tid] >= 0)
-		return (__stdinbox[tid]);
+	/* Cached. */
+	if (LIKELY(__stdinbox[port] >= 0))
+		return (__stdinbox[port]);
 
-	__stdinbox[tid] = kmailbox_create(knode_get_num(), tid);
+	__stdinbox[port] = kmailbox_create(knode_get_num(), port);
 
-	return ((__stdinbox[tid] < 0) ? -1 : 0);
+	return ((__stdinbox[port] < 0) ? -1 : __stdinbox[port]);
 }
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * @details The __stdmailbox_setup() function creates the standard
+ * input mailbox of the calling thread, if it does not exist yet.
+ * Calling it is optional, as the mailbox is also created on first use.
+ */
+int __stdmailbox_setup(void)
+{
+	return ((__stdinbox_lookup() < 0) ? -1 : 0);
+}
+
+/**
+ * @details The __stdmailbox_cleanup() function unlinks the standard
+ * input mailbox of the calling thread.
  */
 int __stdmailbox_cleanup(void)
 {
-	int tid;
+	int ret;
+	int port;
+
+	if ((port = stdinbox_get_port()) < 0)
+		return (-1);
 
-	if ((tid = stdinbox_get_port()) > (THREAD_MAX + 1))
+	if (__stdinbox[port] < 0)
 		return (-1);
 
-	return (kmailbox_unlink(__stdinbox[tid]));
+	if ((ret = kmailbox_unlink(__stdinbox[port])) < 0)
+		return (ret);
+
+	__stdinbox[port] = -1;
+
+	return (0);
 }
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * @details The stdinbox_get() function returns the standard input
+ * mailbox of the calling thread. The mailbox is created on first use.
  */
 int stdinbox_get(void)
 {
-	int tid;
-
-	if ((tid = stdinbox_get_port()) > (THREAD_MAX + 1))
-		return (-1);
-
-	return (__stdinbox[tid]);
+	return (__stdinbox_lookup());
 }
 
 #else
@@ -27,72 +27,107 @@
 #if __TARGET_HAS_PORTAL
 
 #include <nanvix/sys/thread.h>
+#include <nanvix/sys/tls.h>
 #include <nanvix/sys/noc.h>
 #include <nanvix/runtime/stdikc.h>
 
 /**
- * @brief Kernel standard input portal.
+ * @brief Number of standard input portals.
  */
-static int __stdinportal[THREAD_MAX + 1] = {
-	[0 ... THREAD_MAX] = -1
+#define __STDINPORTAL_MAX NANVIX_TLS_THREADS
+
+/**
+ * @brief Kernel standard input portals.
+ *
+ * Entries are indexed by the port of their owner thread, which is
+ * derived from its ID. An entry is written only by its owner, so it
+ * caches the portal of the thread without locking. Portals are created
+ * on first use, so no port is bound for threads that never
+ * communicate.
+ */
+static int __stdinportal[__STDINPORTAL_MAX] = {
+	[0 ... (__STDINPORTAL_MAX - 1)] = -1
 };
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * @details The stdinportal_get_port() function returns the port of the
+ * standard input portal of the calling thread. The port is derived
+ * from the ID of the thread, so remote peers can predict it.
  */
 int stdinportal_get_port(void)
 {
-	int port = (kthread_self() - (SYS_THREAD_MAX - 1));
+	int port = nanvix_tls_slot(kthread_self());
+
+	/* Out of ports. */
+	if ((port < 0) || (port >= KPORTAL_PORT_NR))
+		return (-1);
 
-	/* Kernel thread ? 0 else port. */
-	return ((port <= 0) ? 0 : port);
+	return (port);
 }
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * @brief Gets the standard input portal of the calling thread,
+ * creating it on first use.
+ *
+ * @returns The standard input portal of the calling thread, or a
+ * negative number upon failure.
  */
-int __stdportal_setup(void)
+static int __stdinportal_lookup(void)
 {
-	int tid;
+	int port;
 
-	if ((tid = stdinportal_get_port()) > (THREAD_MAX + 1))
+	if ((port = stdinportal_get_port()) < 0)
 		return (-1);
 
-	if (__stdinportal[tid] >= 0)
-		return (__stdinportal[tid]);
+	/* Cached. */
+	if (LIKELY(__stdinportal[port] >= 0))
+		return (__stdinportal[port]);
 
-	__stdinportal[tid] = kportal_create(knode_get_num(), tid);
+	__stdinportal[port] = kportal_create(knode_get_num(), port);
 
-	return ((__stdinportal[tid] < 0) ? -1 : 0);
+	return ((__stdinportal[port] < 0) ? -1 : __stdinportal[port]);
 }
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * @details The __stdportal_setup() function creates the standard
+ * input portal of the calling thread, if it does not exist yet.
+ * Calling it is optional, as the portal is also created on first use.
+ */
+int __stdportal_setup(void)
+{
+	return ((__stdinportal_lookup() < 0) ? -1 : 0);
+}
+
+/**
+ * @details The __stdportal_cleanup() function unlinks the standard
+ * input portal of the calling thread.
  */
 int __stdportal_cleanup(void)
 {
-	int tid;
+	int ret;
+	int port;
 
-	if ((tid = stdinportal_get_port()) > (THREAD_MAX + 1))
+	if ((port = stdinportal_get_port()) < 0)
 		return (-1);
 
-	if (__stdinportal[tid] < 0)
+	if (__stdinportal[port] < 0)
 		return (-1);
 
-	return (kportal_unlink(__stdinportal[tid]));
+	if ((ret = kportal_unlink(__stdinportal[port])) < 0)
+		return (ret);
+
+	__stdinportal[port] = -1;
+
+	return (0);
 }
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * @details The stdinportal_get() function returns the standard input
+ * portal of the calling thread. The portal is created on first use.
  */
 int stdinportal_get(void)
 {
-	int tid;
-
-	if ((tid = stdinportal_get_port()) > (THREAD_MAX + 1))
-		return (-1);
-
-	return (__stdinportal[tid]);
+	return (__stdinportal_lookup());
 }
 
 #else
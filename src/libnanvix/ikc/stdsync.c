@@ -30,28 +30,55 @@
 #include <nanvix/sys/thread.h>
 #include <nanvix/runtime/stdikc.h>
 #include <nanvix/runtime/barrier.h>
+#include <nanvix/runtime/fence.h>
+#include <posix/stdbool.h>
 
 /**
- * @brief Kernel standard sync.
+ * @brief Kernel standard sync, shared by all threads of the cluster.
  */
-static barrier_t __stdbarrier[THREAD_MAX + 1] = {
-	[0 ... (THREAD_MAX)] = {
-		.leader = -1,
-		.syncs[0] = -1,
-		.syncs[1] = -1
-	},
+static barrier_t __stdbarrier = {
+	.leader = -1,
+	.syncs[0] = -1,
+	.syncs[1] = -1
 };
 
-/*
- * Build a list of the node IDs
- *
- * @param nodes
- * @param nioclusters
- * @param ncclusters
+/**
+ * @brief Fence that gathers local threads around the standard sync.
+ */
+static struct fence_t __stdfence;
+
+/**
+ * @brief Protection of the standard sync.
+ */
+static spinlock_t __stdsync_lock = SPINLOCK_UNLOCKED;
+
+/**
+ * @brief Number of threads that joined the standard sync.
+ */
+static int __stdsync_nusers = 0;
+
+/**
+ * @brief Number of threads that arrived at the current fence.
+ */
+static int __stdsync_narrived = 0;
+
+/**
+ * @brief Outcome of the last wait in the standard sync.
+ */
+static int __stdsync_ret = 0;
+
+/*============================================================================*
+ * build_node_list()                                                          *
+ *============================================================================*/
+
+/**
+ * @details The build_node_list() function stores in @p nodes the logic
+ * IDs of the first @p nioclusters IO Clusters, followed by the first
+ * @p ncclusters Compute Clusters.
  *
  * @author João Vicente Souto
  */
-static void build_node_list(int *nodes, int nioclusters, int ncclusters)
+PUBLIC void build_node_list(int *nodes, int nioclusters, int ncclusters)
 {
 	int base;
 	int step;
@@ -77,56 +104,110 @@ static void build_node_list(int *nodes, int nioclusters, int ncclusters)
 
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * @details The __stdsync_setup() function joins the calling thread to
+ * the standard sync of the local cluster. The first thread to join
+ * creates the underlying barrier, which spans all clusters. Other
+ * threads only join the local fence.
  */
 int __stdsync_setup(void)
 {
-	int tid;
+	int ret;
 	int nodes[PROCESSOR_CLUSTERS_NUM];
 
-	if ((tid = kthread_self()) > THREAD_MAX)
-		return (-1);
+	ret = 0;
+
+	spinlock_lock(&__stdsync_lock);
+
+		/* First thread creates the barrier. */
+		if (__stdsync_nusers == 0)
+		{
+			build_node_list(nodes, PROCESSOR_IOCLUSTERS_NUM, PROCESSOR_CCLUSTERS_NUM);
 
-	build_node_list(nodes, PROCESSOR_IOCLUSTERS_NUM, PROCESSOR_CCLUSTERS_NUM);
+			__stdbarrier = barrier_create(nodes, PROCESSOR_CLUSTERS_NUM);
 
-	__stdbarrier[tid] = barrier_create(nodes, PROCESSOR_CLUSTERS_NUM);
+			/* Failed to create barrier. */
+			if (!BARRIER_IS_VALID(__stdbarrier))
+			{
+				ret = (-1);
+				goto error;
+			}
+		}
 
-	/* Slave cluster. */
-	return (0);
+		__stdsync_nusers++;
+		fence_init(&__stdfence, __stdsync_nusers);
+
+error:
+	spinlock_unlock(&__stdsync_lock);
+
+	return (ret);
 }
 
 /**
- * @todo TODO: provide a detailed description for this function.
- * @bug FIXME: return value on bad cases.
+ * @details The __stdsync_cleanup() function detaches the calling
+ * thread from the standard sync of the local cluster. The last thread
+ * to leave destroys the underlying barrier.
  */
 int __stdsync_cleanup(void)
 {
-	int tid;
 	int ret;
 
-	if ((tid = kthread_self()) > THREAD_MAX)
-		return (-1);
+	ret = 0;
 
-	ret = barrier_destroy(__stdbarrier[tid]);
+	spinlock_lock(&__stdsync_lock);
+
+		/* Not joined. */
+		if (__stdsync_nusers == 0)
+		{
+			ret = (-1);
+			goto error;
+		}
+
+		/* Last thread destroys the barrier. */
+		if (--__stdsync_nusers == 0)
+		{
+			ret          = barrier_destroy(__stdbarrier);
+			__stdbarrier = BARRIER_NULL;
+		}
+		else
+			fence_init(&__stdfence, __stdsync_nusers);
+
+error:
+	spinlock_unlock(&__stdsync_lock);
 
 	return (ret);
 }
 
 /**
- * @todo TODO: provide a detailed description for this function.
- * @bug FIXME: return value on bad cases.
+ * @details The stdsync_fence() function waits until all threads that
+ * joined the standard sync in all clusters reach it. Local threads
+ * gather in a fence and only the first of them to arrive crosses the
+ * barrier on behalf of the cluster.
  */
 int stdsync_fence(void)
 {
-	int tid;
-	int ret;
+	bool leader;
 
-	if ((tid = kthread_self()) > THREAD_MAX)
+	/* Not joined. */
+	if (!BARRIER_IS_VALID(__stdbarrier))
 		return (-1);
 
-	ret = barrier_wait(__stdbarrier[tid]);
+	spinlock_lock(&__stdsync_lock);
+		leader = (__stdsync_narrived++ == 0);
+	spinlock_unlock(&__stdsync_lock);
 
-	return (ret);
+	/* Gather local threads. */
+	fence(&__stdfence);
+
+	if (leader)
+	{
+		__stdsync_ret      = barrier_wait(__stdbarrier);
+		__stdsync_narrived = 0;
+	}
+
+	/* Release local threads. */
+	fence(&__stdfence);
+
+	return (__stdsync_ret);
 }
 
 #else
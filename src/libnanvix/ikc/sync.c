@@ -26,9 +26,18 @@
 
 #if __TARGET_HAS_SYNC && !__NANVIX_IKC_USES_ONLY_MAILBOX
 
+#include <nanvix/sys/latency.h>
 #include <nanvix/sys/noc.h>
+#include <nanvix/sys/perf.h>
+#include <nanvix/sys/sync.h>
+#include <nanvix/sys/trace.h>
 #include <posix/errno.h>
 
+/**
+ * @brief Latency histograms.
+ */
+PRIVATE struct nanvix_histogram ksync_histograms[KSYNC_MAX];
+
 /*============================================================================*
  * ksync_create()                                                             *
  *============================================================================*/
@@ -60,6 +69,10 @@ int ksync_create(const int *nodes, int nnodes, int type)
 		(word_t) type
 	);
 
+	/* Discard samples of a previous sync. */
+	if (ret >= 0)
+		nanvix_histogram_reset(&ksync_histograms[ret]);
+
 	return (ret);
 }
 
@@ -94,6 +107,10 @@ int ksync_open(const int *nodes, int nnodes, int type)
 		(word_t) type
 	);
 
+	/* Discard samples of a previous sync. */
+	if (ret >= 0)
+		nanvix_histogram_reset(&ksync_histograms[ret]);
+
 	return (ret);
 }
 
@@ -107,15 +124,47 @@ int ksync_open(const int *nodes, int nnodes, int type)
 int ksync_wait(int syncid)
 {
 	int ret;
+	uint64_t t0;
+	uint64_t t1;
+
+	NANVIX_TRACE_BEGIN(NANVIX_TRACE_KSYNC_WAIT, syncid);
 
+	kclock(&t0);
 	ret = kcall1(
 		NR_sync_wait,
 		(word_t) syncid
 	);
 
+	/* Emulate the interconnect. */
+	if (ret >= 0)
+		NANVIX_LATENCY_INJECT(0);
+
+	kclock(&t1);
+
+	if (ret >= 0)
+		NANVIX_HISTOGRAM_RECORD(&ksync_histograms[syncid], t1 - t0);
+
+	NANVIX_TRACE_END(NANVIX_TRACE_KSYNC_WAIT, syncid, ret);
+
 	return (ret);
 }
 
+/*============================================================================*
+ * ksync_trywait()                                                            *
+ *============================================================================*/
+
+/**
+ * @details The ksync_trywait() function is not supported by native
+ * synchronization points, because the kernel has no way to query
+ * whether a signal has arrived without blocking.
+ */
+int ksync_trywait(int syncid)
+{
+	((void) syncid);
+
+	return (-ENOTSUP);
+}
+
 /*============================================================================*
  * ksync_signal()                                                             *
  *============================================================================*/
@@ -126,6 +175,14 @@ int ksync_wait(int syncid)
 int ksync_signal(int syncid)
 {
 	int ret;
+	bool contended;
+	uint64_t t0;
+	uint64_t t1;
+
+	contended = false;
+	NANVIX_TRACE_BEGIN(NANVIX_TRACE_KSYNC_SIGNAL, syncid);
+
+	kclock(&t0);
 
 	do
 	{
@@ -133,11 +190,39 @@ int ksync_signal(int syncid)
 			NR_sync_signal,
 			(word_t) syncid
 		);
+
+		/* Busy sync. */
+		if ((ret == -EAGAIN) && !contended)
+		{
+			contended = true;
+			NANVIX_TRACE_INSTANT(NANVIX_TRACE_LOCK_CONTENTION, syncid, 0);
+		}
 	} while (ret == -EAGAIN);
 
+	kclock(&t1);
+
+	if (ret >= 0)
+		NANVIX_HISTOGRAM_RECORD(&ksync_histograms[syncid], t1 - t0);
+
+	NANVIX_TRACE_END(NANVIX_TRACE_KSYNC_SIGNAL, syncid, ret);
+
 	return (ret);
 }
 
+/*============================================================================*
+ * ksync_signal_async()                                                       *
+ *============================================================================*/
+
+/**
+ * @details The ksync_signal_async() function emits a signal from the
+ * output sync @p syncid. The kernel has no split-phase signal, so
+ * native synchronization points are signaled synchronously.
+ */
+int ksync_signal_async(int syncid)
+{
+	return (ksync_signal(syncid));
+}
+
 /*============================================================================*
  * ksync_close()                                                              *
  *============================================================================*/
@@ -182,6 +267,51 @@ int ksync_unlink(int syncid)
  * ksync_ioctl()                                                              *
  *============================================================================*/
 
+PRIVATE int ksync_ioctl_valid(void * ptr, size_t size)
+{
+	return ((ptr != NULL) && mm_check_area(VADDR(ptr), size, UMEM_AREA));
+}
+
+#if __NANVIX_IKC_STATS
+
+/**
+ * @brief Serves a latency histogram request.
+ *
+ * @param syncid  Target sync.
+ * @param request Request.
+ * @param args    Additional arguments.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+PRIVATE int ksync_ioctl_histogram(int syncid, unsigned request, va_list args)
+{
+	struct nanvix_histogram_summary * summary;
+
+	/* Invalid sync. */
+	if (!WITHIN(syncid, 0, KSYNC_MAX))
+		return (-EINVAL);
+
+	/* Discard samples. */
+	if (request == KSYNC_IOCTL_RESET_HISTOGRAM)
+	{
+		nanvix_histogram_reset(&ksync_histograms[syncid]);
+		return (0);
+	}
+
+	summary = va_arg(args, struct nanvix_histogram_summary *);
+
+	/* Bad buffer. */
+	if (!ksync_ioctl_valid(summary, sizeof(struct nanvix_histogram_summary)))
+		return (-EFAULT);
+
+	nanvix_histogram_summary(&ksync_histograms[syncid], summary);
+
+	return (0);
+}
+
+#endif /* __NANVIX_IKC_STATS */
+
 /**
  * @details The ksync_ioctl() reads the measurement parameter associated
  * with the request id @p request of the sync @p syncid.
@@ -193,6 +323,19 @@ int ksync_ioctl(int syncid, unsigned request, ...)
 
 	va_start(args, request);
 
+		/* Latency histograms are kept in user space. */
+		if ((request == KSYNC_IOCTL_GET_HISTOGRAM) || (request == KSYNC_IOCTL_RESET_HISTOGRAM))
+		{
+#if __NANVIX_IKC_STATS
+			ret = ksync_ioctl_histogram(syncid, request, args);
+#else
+			ret = (-ENOTSUP);
+#endif /* __NANVIX_IKC_STATS */
+			va_end(args);
+
+			return (ret);
+		}
+
 		dcache_invalidate();
 
 		ret = kcall3(
@@ -219,6 +362,9 @@ int ksync_ioctl(int syncid, unsigned request, ...)
 PUBLIC void ksync_init(void)
 {
 	kprintf("[user][sync] Initializes sync module");
+
+	for (int i = 0; i < KSYNC_MAX; ++i)
+		nanvix_histogram_init(&ksync_histograms[i]);
 }
 
 #else
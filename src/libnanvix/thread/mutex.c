@@ -24,6 +24,7 @@
 
 #include <nanvix/kernel/kernel.h>
 #include <nanvix/sys/mutex.h>
+#include <nanvix/sys/trace.h>
 #include <posix/errno.h>
 
 #if (CORES_NUM > 1)
@@ -89,6 +90,7 @@ PUBLIC int nanvix_mutex_init(struct nanvix_mutex * m, struct nanvix_mutexattr *
 PUBLIC int nanvix_mutex_lock(struct nanvix_mutex * m)
 {
 	kthread_t tid;
+	bool contended;
 
 	/* Invalid mutex. */
 	if (UNLIKELY(m == NULL))
@@ -105,6 +107,8 @@ PUBLIC int nanvix_mutex_lock(struct nanvix_mutex * m)
 		return (0);
 	}
 
+	contended = false;
+
 	do
 	{
 		spinlock_lock(&m->lock);
@@ -132,6 +136,13 @@ PUBLIC int nanvix_mutex_lock(struct nanvix_mutex * m)
 
 		spinlock_unlock(&m->lock);
 
+		/* Held by another thread. */
+		if (!contended)
+		{
+			contended = true;
+			NANVIX_TRACE_INSTANT(NANVIX_TRACE_LOCK_CONTENTION, -1, m->owner);
+		}
+
 		#if (__NANVIX_MUTEX_SLEEP)
 
 			ksleep();
@@ -24,20 +24,9 @@
 
 #include <nanvix/kernel/kernel.h>
 #include <nanvix/sys/thread.h>
+#include <nanvix/sys/tls.h>
 #include <posix/errno.h>
 
-/*============================================================================*
- * kthread_self()                                                             *
- *============================================================================*/
-
-/*
- * @see sys_kthread_get_id()
- */
-kthread_t kthread_self(void)
-{
-	return (kcall0(NR_thread_get_id));
-}
-
 /*============================================================================*
  * kthread_create()                                                           *
  *============================================================================*/
@@ -81,6 +70,9 @@ int kthread_exit(void *retval)
 {
 	int ret;
 
+	/* Destroy thread-local values. */
+	nanvix_tls_cleanup();
+
 	ret = kcall1(
 		NR_thread_exit,
 		(word_t) retval
@@ -123,6 +115,9 @@ int kthread_join(
 		return (-1);
 	}
 
+	/* The block may be taken by the next thread. */
+	nanvix_tls_reset(tid);
+
 	return (ret);
 }
 
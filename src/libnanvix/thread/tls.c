@@ -0,0 +1,182 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <nanvix/sys/tls.h>
+#include <posix/stdbool.h>
+
+/**
+ * @brief Storage blocks.
+ */
+PUBLIC struct nanvix_tls_block __nanvix_tls_blocks[NANVIX_TLS_THREADS];
+
+/**
+ * @brief Keys.
+ */
+PRIVATE struct
+{
+	bool used;                          /**< Is the key in use? */
+	nanvix_tls_destructor_t destructor; /**< Destructor.        */
+} tls_keys[NANVIX_TLS_KEYS_MAX];
+
+/**
+ * @brief Lock of keys.
+ */
+PRIVATE spinlock_t tls_lock = SPINLOCK_UNLOCKED;
+
+/*============================================================================*
+ * nanvix_tls_key_create()                                                    *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_tls_key_create() function allocates a key and
+ * stores it in @p key. The value of the key is cleared in all blocks,
+ * so that values left by a previously deleted key are not visible.
+ */
+PUBLIC int nanvix_tls_key_create(nanvix_tls_key_t *key, nanvix_tls_destructor_t destructor)
+{
+	int ret;
+
+	/* Invalid store location. */
+	if (key == NULL)
+		return (-EINVAL);
+
+	ret = (-EAGAIN);
+
+	spinlock_lock(&tls_lock);
+
+		for (int i = 0; i < NANVIX_TLS_KEYS_MAX; i++)
+		{
+			if (tls_keys[i].used)
+				continue;
+
+			for (int j = 0; j < NANVIX_TLS_THREADS; j++)
+				__nanvix_tls_blocks[j].values[i] = NULL;
+
+			tls_keys[i].used       = true;
+			tls_keys[i].destructor = destructor;
+
+			*key = i;
+			ret  = 0;
+
+			break;
+		}
+
+	spinlock_unlock(&tls_lock);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * nanvix_tls_key_delete()                                                    *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_tls_key_delete() function releases the key @p
+ * key.
+ */
+PUBLIC int nanvix_tls_key_delete(nanvix_tls_key_t key)
+{
+	int ret;
+
+	/* Invalid key. */
+	if (!WITHIN(key, 0, NANVIX_TLS_KEYS_MAX))
+		return (-EINVAL);
+
+	ret = (-EINVAL);
+
+	spinlock_lock(&tls_lock);
+
+		/* Key in use. */
+		if (tls_keys[key].used)
+		{
+			tls_keys[key].used       = false;
+			tls_keys[key].destructor = NULL;
+			ret                      = 0;
+		}
+
+	spinlock_unlock(&tls_lock);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * nanvix_tls_cleanup()                                                       *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_tls_cleanup() function calls the destructor of
+ * each key that has a non-NULL value in the calling thread, and then
+ * clears the value. A destructor may set values again, which are only
+ * cleared.
+ */
+PUBLIC void nanvix_tls_cleanup(void)
+{
+	void *value;
+	nanvix_tls_destructor_t destructor;
+	struct nanvix_tls_block *block;
+
+	/* Unknown thread. */
+	if ((block = nanvix_tls_self()) == NULL)
+		return;
+
+	for (int i = 0; i < NANVIX_TLS_KEYS_MAX; i++)
+	{
+		if ((value = block->values[i]) == NULL)
+			continue;
+
+		block->values[i] = NULL;
+
+		spinlock_lock(&tls_lock);
+			destructor = (tls_keys[i].used) ? tls_keys[i].destructor : NULL;
+		spinlock_unlock(&tls_lock);
+
+		if (destructor != NULL)
+			destructor(value);
+	}
+
+	/* Values set by destructors. */
+	for (int i = 0; i < NANVIX_TLS_KEYS_MAX; i++)
+		block->values[i] = NULL;
+}
+
+/*============================================================================*
+ * nanvix_tls_reset()                                                         *
+ *============================================================================*/
+
+/**
+ * @details The nanvix_tls_reset() function clears all values of the
+ * thread @p tid.
+ */
+PUBLIC void nanvix_tls_reset(kthread_t tid)
+{
+	struct nanvix_tls_block *block;
+
+	/* Unknown thread. */
+	if ((block = nanvix_tls_block_of(tid)) == NULL)
+		return;
+
+	for (int i = 0; i < NANVIX_TLS_KEYS_MAX; i++)
+		block->values[i] = NULL;
+}
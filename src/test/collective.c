@@ -0,0 +1,271 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2018 Pedro Henrique Penna <pedrohenriquepenna@gmail.com>
+ *              2015-2016 Davidson Francis     <davidsondfgl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/sys/noc.h>
+#include <nanvix/runtime/collective.h>
+#include <posix/errno.h>
+
+#include "test.h"
+
+#if (__TARGET_HAS_PORTAL && __TARGET_HAS_SYNC)
+
+/*============================================================================*
+ * Constants                                                                  *
+ *============================================================================*/
+
+/**
+ * @name Number of elements.
+ */
+/**@{*/
+#define COLLECTIVE_COUNT       (PORTAL_SIZE / sizeof(int32_t) / NR_NODES)       /**< Small count. */
+#define COLLECTIVE_COUNT_LARGE (PORTAL_SIZE_LARGE / sizeof(int32_t) / NR_NODES) /**< Large count. */
+/**@}*/
+
+/*============================================================================*
+ * Global variables                                                           *
+ *============================================================================*/
+
+PRIVATE struct nanvix_collective coll;
+PRIVATE int32_t sendbuf[COLLECTIVE_COUNT_LARGE * NR_NODES];
+PRIVATE int32_t recvbuf[COLLECTIVE_COUNT_LARGE * NR_NODES];
+
+/*============================================================================*
+ * API Test: Broadcast                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Broadcasts @p count elements from each node.
+ */
+PRIVATE void do_collective_broadcast(size_t count)
+{
+	for (int root = 0; root < NR_NODES; root++)
+	{
+		for (size_t i = 0; i < count; i++)
+			recvbuf[i] = (coll.rank == root) ? (int32_t) (i + root) : -1;
+
+		test_assert(nanvix_collective_broadcast(&coll, recvbuf, count, NANVIX_COLLECTIVE_INT32, root) == 0);
+
+		for (size_t i = 0; i < count; i++)
+			test_assert(recvbuf[i] == (int32_t) (i + root));
+	}
+}
+
+/**
+ * @brief API Test: Broadcast
+ */
+PRIVATE void test_api_collective_broadcast(void)
+{
+	do_collective_broadcast(COLLECTIVE_COUNT);
+	do_collective_broadcast(COLLECTIVE_COUNT_LARGE * NR_NODES);
+}
+
+/*============================================================================*
+ * API Test: Scatter Gather                                                   *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Scatter Gather
+ */
+PRIVATE void test_api_collective_scatter_gather(void)
+{
+	for (size_t i = 0; i < COLLECTIVE_COUNT*NR_NODES; i++)
+		sendbuf[i] = (int32_t) i;
+
+	test_assert(nanvix_collective_scatter(&coll, sendbuf, recvbuf, COLLECTIVE_COUNT, NANVIX_COLLECTIVE_INT32, 0) == 0);
+
+	for (size_t i = 0; i < COLLECTIVE_COUNT; i++)
+		test_assert(recvbuf[i] == (int32_t) (coll.rank*COLLECTIVE_COUNT + i));
+
+	kmemcpy(sendbuf, recvbuf, COLLECTIVE_COUNT*sizeof(int32_t));
+	kmemset(recvbuf, 0, sizeof(recvbuf));
+
+	test_assert(nanvix_collective_gather(&coll, sendbuf, recvbuf, COLLECTIVE_COUNT, NANVIX_COLLECTIVE_INT32, 0) == 0);
+
+	if (coll.rank == 0)
+	{
+		for (size_t i = 0; i < COLLECTIVE_COUNT*NR_NODES; i++)
+			test_assert(recvbuf[i] == (int32_t) i);
+	}
+}
+
+/*============================================================================*
+ * API Test: Allgather                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Allgathers @p count elements from each node.
+ */
+PRIVATE void do_collective_allgather(size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		sendbuf[i] = (int32_t) (coll.rank*count + i);
+
+	test_assert(nanvix_collective_allgather(&coll, sendbuf, recvbuf, count, NANVIX_COLLECTIVE_INT32) == 0);
+
+	for (size_t i = 0; i < count*NR_NODES; i++)
+		test_assert(recvbuf[i] == (int32_t) i);
+}
+
+/**
+ * @brief API Test: Allgather
+ */
+PRIVATE void test_api_collective_allgather(void)
+{
+	do_collective_allgather(COLLECTIVE_COUNT);
+	do_collective_allgather(COLLECTIVE_COUNT_LARGE);
+}
+
+/*============================================================================*
+ * API Test: Reduce                                                           *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Reduce
+ */
+PRIVATE void test_api_collective_reduce(void)
+{
+	for (size_t i = 0; i < COLLECTIVE_COUNT; i++)
+		sendbuf[i] = (int32_t) (coll.rank + i);
+
+	test_assert(nanvix_collective_reduce(&coll, sendbuf, recvbuf, COLLECTIVE_COUNT, NANVIX_COLLECTIVE_INT32, NANVIX_COLLECTIVE_MAX, 0) == 0);
+
+	if (coll.rank == 0)
+	{
+		for (size_t i = 0; i < COLLECTIVE_COUNT; i++)
+			test_assert(recvbuf[i] == (int32_t) (NR_NODES - 1 + i));
+	}
+}
+
+/*============================================================================*
+ * API Test: Allreduce                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Sums @p count elements of all nodes.
+ */
+PRIVATE void do_collective_allreduce(size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		sendbuf[i] = (int32_t) (coll.rank + i);
+
+	test_assert(nanvix_collective_allreduce(&coll, sendbuf, recvbuf, count, NANVIX_COLLECTIVE_INT32, NANVIX_COLLECTIVE_SUM) == 0);
+
+	for (size_t i = 0; i < count; i++)
+		test_assert(recvbuf[i] == (int32_t) (NR_NODES*i + (NR_NODES*(NR_NODES - 1))/2));
+}
+
+/**
+ * @brief API Test: Allreduce
+ */
+PRIVATE void test_api_collective_allreduce(void)
+{
+	do_collective_allreduce(COLLECTIVE_COUNT);
+	do_collective_allreduce(COLLECTIVE_COUNT_LARGE * NR_NODES);
+}
+
+/*============================================================================*
+ * Fault Test: Invalid Arguments                                              *
+ *============================================================================*/
+
+/**
+ * @brief Fault Test: Invalid Arguments
+ */
+PRIVATE void test_fault_collective_invalid_args(void)
+{
+	test_assert(nanvix_collective_broadcast(NULL, recvbuf, 1, NANVIX_COLLECTIVE_INT32, 0) == -EINVAL);
+	test_assert(nanvix_collective_broadcast(&coll, recvbuf, 1, -1, 0) == -EINVAL);
+	test_assert(nanvix_collective_broadcast(&coll, recvbuf, 1, NANVIX_COLLECTIVE_INT32, -1) == -EINVAL);
+	test_assert(nanvix_collective_broadcast(&coll, recvbuf, 1, NANVIX_COLLECTIVE_INT32, NR_NODES) == -EINVAL);
+	test_assert(nanvix_collective_broadcast(&coll, NULL, 1, NANVIX_COLLECTIVE_INT32, 0) == -EINVAL);
+	test_assert(nanvix_collective_reduce(&coll, sendbuf, recvbuf, 1, NANVIX_COLLECTIVE_INT32, -1, 0) == -EINVAL);
+	test_assert(nanvix_collective_allreduce(&coll, NULL, recvbuf, 1, NANVIX_COLLECTIVE_INT32, NANVIX_COLLECTIVE_SUM) == -EINVAL);
+	test_assert(nanvix_collective_allgather(&coll, sendbuf, NULL, 1, NANVIX_COLLECTIVE_INT32) == -EINVAL);
+}
+
+/*============================================================================*
+ * Test Driver                                                                *
+ *============================================================================*/
+
+/**
+ * @brief Unit tests.
+ */
+static struct test collective_tests_api[] = {
+	{ test_api_collective_broadcast,      "[test][collective][api] broadcast      [passed]" },
+	{ test_api_collective_scatter_gather, "[test][collective][api] scatter gather [passed]" },
+	{ test_api_collective_allgather,      "[test][collective][api] allgather      [passed]" },
+	{ test_api_collective_reduce,         "[test][collective][api] reduce         [passed]" },
+	{ test_api_collective_allreduce,      "[test][collective][api] allreduce      [passed]" },
+	{ NULL,                                NULL                                             },
+};
+
+/**
+ * @brief Unit tests.
+ */
+static struct test collective_tests_fault[] = {
+	{ test_fault_collective_invalid_args, "[test][collective][fault] invalid arguments [passed]" },
+	{ NULL,                                NULL                                                  },
+};
+
+/**
+ * The test_collective() function launches testing units on the
+ * collective communication library, among the @p nnodes nodes listed
+ * in @p nodes.
+ */
+void test_collective(const int *nodes, int nnodes)
+{
+	int local;
+
+	local = knode_get_num();
+
+	test_assert(nanvix_collective_init(&coll, nodes, nnodes, 0) == 0);
+
+		/* API Tests */
+		if (local == MASTER_NODENUM)
+			nanvix_puts("--------------------------------------------------------------------------------");
+		for (unsigned i = 0; collective_tests_api[i].test_fn != NULL; i++)
+		{
+			collective_tests_api[i].test_fn();
+
+			test_barrier_nodes();
+
+			if (local == MASTER_NODENUM)
+				nanvix_puts(collective_tests_api[i].name);
+		}
+
+		/* Fault Tests */
+		if (local == MASTER_NODENUM)
+			nanvix_puts("--------------------------------------------------------------------------------");
+		for (unsigned i = 0; collective_tests_fault[i].test_fn != NULL; i++)
+		{
+			collective_tests_fault[i].test_fn();
+
+			if (local == MASTER_NODENUM)
+				nanvix_puts(collective_tests_fault[i].name);
+		}
+
+	test_assert(nanvix_collective_finalize(&coll) == 0);
+}
+
+#endif /* __TARGET_HAS_PORTAL && __TARGET_HAS_SYNC */
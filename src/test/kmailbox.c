@@ -23,9 +23,14 @@
  * SOFTWARE.
  */
 
+#include <nanvix/sys/ikcq.h>
 #include <nanvix/sys/mailbox.h>
 #include <nanvix/sys/noc.h>
+#include <nanvix/sys/poll.h>
+#include <nanvix/sys/rma.h>
+#include <nanvix/runtime/am.h>
 #include <nanvix/runtime/fence.h>
+#include <nanvix/runtime/stdikc.h>
 #include <posix/errno.h>
 
 #include "test.h"
@@ -58,6 +63,20 @@
 #define TEST_VIRTUALIZATION_MBX_NR MAILBOX_PORT_NR
 #endif
 
+/**
+ * @brief Size of the RMA window.
+ */
+#define TEST_RMA_WINDOW_SIZE (4 * KMAILBOX_MESSAGE_SIZE)
+
+/**
+ * @name Active Messages
+ */
+/**{*/
+#define TEST_AM_INCREMENT 0
+#define TEST_AM_ECHO      1
+#define TEST_AM_MISSING   2
+/**}*/
+
 /**
  * @brief Pending Messages - Unlink
  */
@@ -177,6 +196,83 @@ static void test_api_mailbox_get_latency(void)
 	test_assert(kmailbox_unlink(mbx_in) == 0);
 }
 
+/*============================================================================*
+ * API Test: Get histogram                                                    *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Mailbox Get latency histogram
+ */
+static void test_api_mailbox_get_histogram(void)
+{
+	int local;
+	int remote;
+	int mbx_in;
+	int mbx_out;
+	struct nanvix_histogram_summary summary;
+
+	local = knode_get_num();
+	remote = (local == MASTER_NODENUM) ? SLAVE_NODENUM : MASTER_NODENUM;
+
+	test_assert((mbx_in = kmailbox_create(local, 0)) >= 0);
+	test_assert((mbx_out = kmailbox_open(remote, 0)) >= 0);
+
+#if __NANVIX_IKC_STATS
+		test_assert(kmailbox_ioctl(mbx_in, KMAILBOX_IOCTL_GET_HISTOGRAM, &summary) == 0);
+		test_assert(summary.count == 0);
+		test_assert(summary.p99 == 0);
+
+		test_assert(kmailbox_ioctl(mbx_out, KMAILBOX_IOCTL_GET_HISTOGRAM, &summary) == 0);
+		test_assert(summary.count == 0);
+		test_assert(summary.p99 == 0);
+
+		test_assert(kmailbox_ioctl(mbx_in, KMAILBOX_IOCTL_RESET_HISTOGRAM) == 0);
+		test_assert(kmailbox_ioctl(mbx_out, KMAILBOX_IOCTL_RESET_HISTOGRAM) == 0);
+#else
+		/* Histograms are compiled out. */
+		test_assert(kmailbox_ioctl(mbx_in, KMAILBOX_IOCTL_GET_HISTOGRAM, &summary) == -ENOTSUP);
+		test_assert(kmailbox_ioctl(mbx_out, KMAILBOX_IOCTL_RESET_HISTOGRAM) == -ENOTSUP);
+#endif /* __NANVIX_IKC_STATS */
+
+	test_assert(kmailbox_close(mbx_out) == 0);
+	test_assert(kmailbox_unlink(mbx_in) == 0);
+}
+
+/*============================================================================*
+ * API Test: Set Backoff                                                      *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Mailbox Set Backoff
+ */
+static void test_api_mailbox_set_backoff(void)
+{
+	int local;
+	int mbx_in;
+	int policy;
+
+	local = knode_get_num();
+
+	test_assert((mbx_in = kmailbox_create(local, 0)) >= 0);
+
+		test_assert(kmailbox_ioctl(mbx_in, KMAILBOX_IOCTL_GET_BACKOFF, &policy) == 0);
+		test_assert(policy == NANVIX_BACKOFF_DEFAULT);
+
+		for (int i = 0; i < NANVIX_BACKOFF_POLICIES_NUM; i++)
+		{
+			test_assert(kmailbox_ioctl(mbx_in, KMAILBOX_IOCTL_SET_BACKOFF, i) == 0);
+			test_assert(kmailbox_ioctl(mbx_in, KMAILBOX_IOCTL_GET_BACKOFF, &policy) == 0);
+			test_assert(policy == i);
+		}
+
+		test_assert(kmailbox_ioctl(mbx_in, KMAILBOX_IOCTL_SET_BACKOFF, -1) == -EINVAL);
+		test_assert(kmailbox_ioctl(mbx_in, KMAILBOX_IOCTL_SET_BACKOFF, NANVIX_BACKOFF_POLICIES_NUM) == -EINVAL);
+
+	test_assert(kmailbox_unlink(mbx_in) == 0);
+}
+
+#if TEST_HAS_COUNTERS
+
 /*============================================================================*
  * API Test: Get counters                                                     *
  *============================================================================*/
@@ -229,6 +325,8 @@ static void test_api_mailbox_get_counters(void)
 	test_assert(kmailbox_unlink(mbx_in) == 0);
 }
 
+#endif /* TEST_HAS_COUNTERS */
+
 /*============================================================================*
  * API Test: Read Write 2 CC                                                  *
  *============================================================================*/
@@ -244,7 +342,9 @@ static void test_api_mailbox_read_write(void)
 	int mbx_out;
 	size_t volume;
 	uint64_t latency;
+#if TEST_HAS_COUNTERS
 	uint64_t counter;
+#endif
 	char message[KMAILBOX_MESSAGE_SIZE];
 
 	local  = knode_get_num();
@@ -261,10 +361,12 @@ static void test_api_mailbox_read_write(void)
 	test_assert(volume == 0);
 	test_assert(kmailbox_ioctl(mbx_out, KMAILBOX_IOCTL_GET_LATENCY, &latency) == 0);
 
+#if TEST_HAS_COUNTERS
 	test_assert(kmailbox_ioctl(mbx_in, KMAILBOX_IOCTL_GET_NREADS, &counter) == 0);
 	test_assert(counter  == 0);
 	test_assert(kmailbox_ioctl(mbx_in, KMAILBOX_IOCTL_GET_NWRITES, &counter) == 0);
 	test_assert(counter == 0);
+#endif
 
 	if (local == MASTER_NODENUM)
 	{
@@ -307,10 +409,12 @@ static void test_api_mailbox_read_write(void)
 	test_assert(volume == (NITERATIONS * KMAILBOX_MESSAGE_SIZE));
 	test_assert(kmailbox_ioctl(mbx_out, KMAILBOX_IOCTL_GET_LATENCY, &latency) == 0);
 
+#if TEST_HAS_COUNTERS
 	test_assert(kmailbox_ioctl(mbx_in, KMAILBOX_IOCTL_GET_NREADS, &counter) == 0);
 	test_assert(counter  == NITERATIONS);
 	test_assert(kmailbox_ioctl(mbx_in, KMAILBOX_IOCTL_GET_NWRITES, &counter) == 0);
 	test_assert(counter == NITERATIONS);
+#endif
 
 	test_assert(kmailbox_close(mbx_out) == 0);
 	test_assert(kmailbox_unlink(mbx_in) == 0);
@@ -598,6 +702,506 @@ static void test_api_mailbox_multiplexation_3(void)
 	}
 }
 
+/*============================================================================*
+ * API Test: Poll                                                             *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Wait on many input mailboxes at once.
+ */
+static void test_api_mailbox_poll(void)
+{
+	int local;
+	int remote;
+	int ready;
+	int mbx_in[TEST_MULTIPLEXATION2_MBX_PAIRS];
+	int mbx_out[TEST_MULTIPLEXATION2_MBX_PAIRS];
+	bool received[TEST_MULTIPLEXATION2_MBX_PAIRS];
+	char messages[TEST_MULTIPLEXATION2_MBX_PAIRS][KMAILBOX_MESSAGE_SIZE];
+	struct kpollfd fds[TEST_MULTIPLEXATION2_MBX_PAIRS];
+
+	local  = knode_get_num();
+	remote = (local == MASTER_NODENUM) ? SLAVE_NODENUM : MASTER_NODENUM;
+
+	for (unsigned i = 0; i < TEST_MULTIPLEXATION2_MBX_PAIRS; ++i)
+	{
+		test_assert((mbx_in[i] = kmailbox_create(local, i)) >= 0);
+		test_assert((mbx_out[i] = kmailbox_open(remote, i)) >= 0);
+
+		fds[i].type   = KPOLL_MAILBOX;
+		fds[i].id     = mbx_in[i];
+		fds[i].buffer = messages[i];
+		fds[i].size   = KMAILBOX_MESSAGE_SIZE;
+		received[i]   = false;
+	}
+
+	if (local == MASTER_NODENUM)
+	{
+		/* Writes data in descendant order. */
+		for (int i = (TEST_MULTIPLEXATION2_MBX_PAIRS - 1); i >= 0; --i)
+		{
+			kmemset(messages[i], i, KMAILBOX_MESSAGE_SIZE);
+
+			test_assert(kmailbox_write(mbx_out[i], messages[i], KMAILBOX_MESSAGE_SIZE) == KMAILBOX_MESSAGE_SIZE);
+		}
+	}
+	else if (local == SLAVE_NODENUM)
+	{
+		for (unsigned i = 0; i < TEST_MULTIPLEXATION2_MBX_PAIRS; ++i)
+		{
+			test_assert((ready = kwait_any(fds, TEST_MULTIPLEXATION2_MBX_PAIRS)) >= 0);
+			test_assert(fds[ready].revents == KPOLLIN);
+			test_assert(fds[ready].ret == KMAILBOX_MESSAGE_SIZE);
+			test_assert(!received[ready]);
+
+			for (unsigned j = 0; j < KMAILBOX_MESSAGE_SIZE; ++j)
+				test_assert((messages[ready][j] - ready) == 0);
+
+			received[ready] = true;
+
+			/* Stops watching the served mailbox. */
+			fds[ready].id = -1;
+		}
+
+		/* Nothing left. */
+		for (unsigned i = 0; i < TEST_MULTIPLEXATION2_MBX_PAIRS; ++i)
+			fds[i].id = mbx_in[i];
+		test_assert(kpoll(fds, TEST_MULTIPLEXATION2_MBX_PAIRS, 0) == 0);
+	}
+
+	/* Synchronization message. */
+	if (local == MASTER_NODENUM)
+	{
+		test_assert(kmailbox_read(mbx_in[0], messages[0], KMAILBOX_MESSAGE_SIZE) == KMAILBOX_MESSAGE_SIZE);
+	}
+	else
+		test_assert(kmailbox_write(mbx_out[0], messages[0], KMAILBOX_MESSAGE_SIZE) == KMAILBOX_MESSAGE_SIZE);
+
+	/* Closes the used vmailboxes. */
+	for (unsigned i = 0; i < TEST_MULTIPLEXATION2_MBX_PAIRS; ++i)
+	{
+		test_assert(kmailbox_unlink(mbx_in[i]) == 0);
+		test_assert(kmailbox_close(mbx_out[i]) == 0);
+	}
+}
+
+/*============================================================================*
+ * API Test: Completion Queue                                                 *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Submit reads and writes and reap their completions.
+ */
+static void test_api_mailbox_ikcq(void)
+{
+	int local;
+	int remote;
+	int mbx_in[TEST_MULTIPLEXATION2_MBX_PAIRS];
+	int mbx_out[TEST_MULTIPLEXATION2_MBX_PAIRS];
+	bool completed[TEST_MULTIPLEXATION2_MBX_PAIRS];
+	char messages[TEST_MULTIPLEXATION2_MBX_PAIRS][KMAILBOX_MESSAGE_SIZE];
+	struct nanvix_ikcq_sqe sqes[TEST_MULTIPLEXATION2_MBX_PAIRS];
+	struct nanvix_ikcq_cqe cqes[TEST_MULTIPLEXATION2_MBX_PAIRS];
+	static struct nanvix_ikcq q;
+
+	local  = knode_get_num();
+	remote = (local == MASTER_NODENUM) ? SLAVE_NODENUM : MASTER_NODENUM;
+
+	test_assert(nanvix_ikcq_init(&q) == 0);
+
+	for (unsigned i = 0; i < TEST_MULTIPLEXATION2_MBX_PAIRS; ++i)
+	{
+		test_assert((mbx_in[i] = kmailbox_create(local, i)) >= 0);
+		test_assert((mbx_out[i] = kmailbox_open(remote, i)) >= 0);
+
+		kmemset(messages[i], (local == MASTER_NODENUM) ? (int) i : -1, KMAILBOX_MESSAGE_SIZE);
+
+		sqes[i].opcode = (local == MASTER_NODENUM) ? NANVIX_IKCQ_MAILBOX_WRITE : NANVIX_IKCQ_MAILBOX_READ;
+		sqes[i].id     = (local == MASTER_NODENUM) ? mbx_out[i] : mbx_in[i];
+		sqes[i].buffer = messages[i];
+		sqes[i].size   = KMAILBOX_MESSAGE_SIZE;
+		sqes[i].tag    = i;
+		completed[i]   = false;
+	}
+
+	test_assert(nanvix_ikcq_submit(&q, sqes, TEST_MULTIPLEXATION2_MBX_PAIRS) == TEST_MULTIPLEXATION2_MBX_PAIRS);
+
+	test_assert(
+		nanvix_ikcq_reap(
+			&q,
+			cqes,
+			TEST_MULTIPLEXATION2_MBX_PAIRS,
+			TEST_MULTIPLEXATION2_MBX_PAIRS
+		) == TEST_MULTIPLEXATION2_MBX_PAIRS
+	);
+
+	for (unsigned i = 0; i < TEST_MULTIPLEXATION2_MBX_PAIRS; ++i)
+	{
+		test_assert(cqes[i].tag < TEST_MULTIPLEXATION2_MBX_PAIRS);
+		test_assert(cqes[i].ret == KMAILBOX_MESSAGE_SIZE);
+		test_assert(!completed[cqes[i].tag]);
+
+		completed[cqes[i].tag] = true;
+
+		for (unsigned j = 0; j < KMAILBOX_MESSAGE_SIZE; ++j)
+			test_assert((messages[cqes[i].tag][j] - cqes[i].tag) == 0);
+	}
+
+	/* Synchronization message. */
+	if (local == MASTER_NODENUM)
+	{
+		test_assert(kmailbox_read(mbx_in[0], messages[0], KMAILBOX_MESSAGE_SIZE) == KMAILBOX_MESSAGE_SIZE);
+	}
+	else
+		test_assert(kmailbox_write(mbx_out[0], messages[0], KMAILBOX_MESSAGE_SIZE) == KMAILBOX_MESSAGE_SIZE);
+
+	/* Closes the used vmailboxes. */
+	for (unsigned i = 0; i < TEST_MULTIPLEXATION2_MBX_PAIRS; ++i)
+	{
+		test_assert(kmailbox_unlink(mbx_in[i]) == 0);
+		test_assert(kmailbox_close(mbx_out[i]) == 0);
+	}
+}
+
+#if __NANVIX_IKC_COALESCING
+
+/*============================================================================*
+ * API Test: Coalescing                                                       *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Pack small messages in one frame.
+ */
+static void test_api_mailbox_coalescing(void)
+{
+	int local;
+	int remote;
+	uint64_t deadline;
+	int mbx_in[2];
+	int mbx_out[2];
+	uint64_t value;
+	char message[KMAILBOX_MESSAGE_SIZE];
+
+	local  = knode_get_num();
+	remote = (local == MASTER_NODENUM) ? SLAVE_NODENUM : MASTER_NODENUM;
+
+	for (unsigned i = 0; i < 2; ++i)
+	{
+		test_assert((mbx_in[i] = kmailbox_create(local, i)) >= 0);
+		test_assert((mbx_out[i] = kmailbox_open(remote, i)) >= 0);
+	}
+
+	/* Coalesces messages in the first pair. */
+	test_assert(kmailbox_ioctl(mbx_in[0], KMAILBOX_IOCTL_SET_COALESCING, (uint64_t) CLUSTER_FREQ) == 0);
+	test_assert(kmailbox_ioctl(mbx_out[0], KMAILBOX_IOCTL_SET_COALESCING, (uint64_t) CLUSTER_FREQ) == 0);
+	test_assert(kmailbox_ioctl(mbx_out[0], KMAILBOX_IOCTL_GET_COALESCING, &deadline) == 0);
+	test_assert(deadline == CLUSTER_FREQ);
+
+	/* Too large. */
+	test_assert(kmailbox_write(mbx_out[0], message, KMAILBOX_MESSAGE_SIZE) == -EINVAL);
+
+	if (local == MASTER_NODENUM)
+	{
+		for (uint64_t i = 0; i < NITERATIONS; ++i)
+			test_assert(kmailbox_write(mbx_out[0], &i, sizeof(uint64_t)) == sizeof(uint64_t));
+
+		test_assert(kmailbox_flush(mbx_out[0]) == 0);
+	}
+	else if (local == SLAVE_NODENUM)
+	{
+		for (uint64_t i = 0; i < NITERATIONS; ++i)
+		{
+			test_assert(kmailbox_read(mbx_in[0], &value, sizeof(uint64_t)) == sizeof(uint64_t));
+			test_assert(value == i);
+		}
+	}
+
+	/* Synchronization message. */
+	if (local == MASTER_NODENUM)
+	{
+		test_assert(kmailbox_read(mbx_in[1], message, KMAILBOX_MESSAGE_SIZE) == KMAILBOX_MESSAGE_SIZE);
+	}
+	else
+		test_assert(kmailbox_write(mbx_out[1], message, KMAILBOX_MESSAGE_SIZE) == KMAILBOX_MESSAGE_SIZE);
+
+	/* Closes the used vmailboxes. */
+	for (unsigned i = 0; i < 2; ++i)
+	{
+		test_assert(kmailbox_unlink(mbx_in[i]) == 0);
+		test_assert(kmailbox_close(mbx_out[i]) == 0);
+	}
+}
+#endif /* __NANVIX_IKC_COALESCING */
+
+/*============================================================================*
+ * API Test: Local Delivery                                                   *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Local Delivery
+ */
+static void test_api_mailbox_local(void)
+{
+	int local;
+	int mbx_in;
+	int mbx_out;
+	uint64_t value;
+
+	local = knode_get_num();
+
+	test_assert((mbx_in = kmailbox_create(local, 0)) >= 0);
+	test_assert((mbx_out = kmailbox_open(local, 0)) >= 0);
+
+	/* Fills the ring, then drains it. */
+	for (uint64_t i = 0; i < KMAILBOX_LOCAL_RING_SIZE; ++i)
+		test_assert(kmailbox_write(mbx_out, &i, sizeof(uint64_t)) == sizeof(uint64_t));
+
+	for (uint64_t i = 0; i < KMAILBOX_LOCAL_RING_SIZE; ++i)
+	{
+		test_assert(kmailbox_read(mbx_in, &value, sizeof(uint64_t)) == sizeof(uint64_t));
+		test_assert(value == i);
+	}
+
+	/* Empty ring. */
+	test_assert(kmailbox_tryread(mbx_in, &value, sizeof(uint64_t)) == -EAGAIN);
+
+	for (uint64_t i = 0; i < NITERATIONS; ++i)
+	{
+		test_assert(kmailbox_write(mbx_out, &i, sizeof(uint64_t)) == sizeof(uint64_t));
+		test_assert(kmailbox_tryread(mbx_in, &value, sizeof(uint64_t)) == sizeof(uint64_t));
+		test_assert(value == i);
+	}
+
+	test_assert(kmailbox_close(mbx_out) == 0);
+	test_assert(kmailbox_unlink(mbx_in) == 0);
+}
+
+/*============================================================================*
+ * API Test: Local Delivery Nodes                                             *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Local delivery to the same port of two nodes.
+ */
+static void test_api_mailbox_local_nodes(void)
+{
+	int nodes[2];
+	int mbx_ins[2];
+	int mbx_outs[2];
+	int spare;
+	int value;
+
+	nodes[0] = knode_get_num();
+	nodes[1] = nodes[0] + 1;
+
+	test_assert((mbx_ins[0] = kmailbox_create(nodes[0], 0)) >= 0);
+	test_assert((mbx_outs[0] = kmailbox_open(nodes[0], 0)) >= 0);
+
+	/* The ring of the port is owned by the first node. */
+	test_assert((spare = kmailbox_open(nodes[0], 1)) >= 0);
+	test_assert(kmailbox_local_bind(spare, nodes[1], 0, false) == -EBUSY);
+	test_assert(kmailbox_local_bind(spare, -1, -1, true) == 0);
+	test_assert(kmailbox_close(spare) == 0);
+
+	/* The cluster spans a second NoC node. */
+	if (!KNODE_NUM_IS_CLUSTER_WIDE && node_is_local(nodes[1]))
+	{
+		test_assert((mbx_ins[1] = kmailbox_create(nodes[1], 0)) >= 0);
+		test_assert((mbx_outs[1] = kmailbox_open(nodes[1], 0)) >= 0);
+
+		/* Each node gets its own messages. */
+		for (int i = 0; i < 2; ++i)
+			test_assert(kmailbox_write(mbx_outs[i], &i, sizeof(int)) == sizeof(int));
+
+		for (int i = 1; i >= 0; --i)
+		{
+			test_assert(kmailbox_read(mbx_ins[i], &value, sizeof(int)) == sizeof(int));
+			test_assert(value == i);
+		}
+
+		test_assert(kmailbox_close(mbx_outs[1]) == 0);
+		test_assert(kmailbox_unlink(mbx_ins[1]) == 0);
+	}
+
+	test_assert(kmailbox_close(mbx_outs[0]) == 0);
+	test_assert(kmailbox_unlink(mbx_ins[0]) == 0);
+}
+
+/*============================================================================*
+ * API Test: RMA                                                              *
+ *============================================================================*/
+
+/**
+ * @brief API Test: One-sided put and get.
+ */
+static void test_api_mailbox_rma(void)
+{
+	int local;
+	int remote;
+	int winid;
+	int mbx_in;
+	int mbx_out;
+	char message[KMAILBOX_MESSAGE_SIZE];
+	static char window[TEST_RMA_WINDOW_SIZE];
+	static char buffer[TEST_RMA_WINDOW_SIZE];
+
+	local  = knode_get_num();
+	remote = (local == MASTER_NODENUM) ? SLAVE_NODENUM : MASTER_NODENUM;
+
+	test_assert(krma_setup() == 0);
+	test_assert((winid = krma_window_create(window, TEST_RMA_WINDOW_SIZE)) >= 0);
+	test_assert((mbx_in = kmailbox_create(local, 0)) >= 0);
+	test_assert((mbx_out = kmailbox_open(remote, 0)) >= 0);
+
+	kmemset(window, 0, TEST_RMA_WINDOW_SIZE);
+
+	/* Local window. */
+	kmemset(buffer, 1, TEST_RMA_WINDOW_SIZE);
+	test_assert(kput(local, winid, 0, buffer, TEST_RMA_WINDOW_SIZE) == 0);
+	test_assert(kget(local, winid, 0, message, KMAILBOX_MESSAGE_SIZE) == 0);
+	test_assert(message[KMAILBOX_MESSAGE_SIZE - 1] == 1);
+	test_assert(kput(local, winid, 1, buffer, TEST_RMA_WINDOW_SIZE) == -EFAULT);
+
+	if (local == MASTER_NODENUM)
+	{
+		for (int i = 0; i < TEST_RMA_WINDOW_SIZE; ++i)
+			buffer[i] = (char) i;
+
+		test_assert(kput(remote, winid, 0, buffer, TEST_RMA_WINDOW_SIZE) == 0);
+		test_assert(krma_flush(remote) == 0);
+
+		kmemset(buffer, 0, TEST_RMA_WINDOW_SIZE);
+		test_assert(kget(remote, winid, 0, buffer, TEST_RMA_WINDOW_SIZE) == 0);
+
+		for (int i = 0; i < TEST_RMA_WINDOW_SIZE; ++i)
+			test_assert(buffer[i] == (char) i);
+
+		/* Rejected put. */
+		test_assert(kput(remote, winid, TEST_RMA_WINDOW_SIZE, buffer, 1) == 0);
+		test_assert(krma_flush(remote) == -EFAULT);
+		test_assert(kget(remote, winid, TEST_RMA_WINDOW_SIZE, buffer, 1) == -EFAULT);
+
+		/* Synchronization message. */
+		test_assert(kmailbox_write(mbx_out, message, KMAILBOX_MESSAGE_SIZE) == KMAILBOX_MESSAGE_SIZE);
+	}
+	else
+	{
+		/* Serves requests until the master is done. */
+		while (kmailbox_tryread(mbx_in, message, KMAILBOX_MESSAGE_SIZE) == -EAGAIN)
+			krma_progress();
+
+		for (int i = 0; i < TEST_RMA_WINDOW_SIZE; ++i)
+			test_assert(window[i] == (char) i);
+	}
+
+	test_assert(kmailbox_close(mbx_out) == 0);
+	test_assert(kmailbox_unlink(mbx_in) == 0);
+	test_assert(krma_window_free(winid) == 0);
+	test_assert(krma_cleanup() == 0);
+}
+
+/*============================================================================*
+ * API Test: Active Messages                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Number of increments run.
+ */
+PRIVATE volatile int test_am_count;
+
+/**
+ * @brief Active message handler that increments a counter.
+ */
+PRIVATE ssize_t test_am_increment(int source, const void * payload, size_t size, void * reply)
+{
+	((void) source);
+	((void) payload);
+	((void) size);
+	((void) reply);
+
+	test_am_count++;
+
+	return (0);
+}
+
+/**
+ * @brief Active message handler that echoes its payload.
+ */
+PRIVATE ssize_t test_am_echo(int source, const void * payload, size_t size, void * reply)
+{
+	((void) source);
+
+	kmemcpy(reply, payload, size);
+
+	return ((ssize_t) size);
+}
+
+/**
+ * @brief API Test: Active Messages
+ */
+static void test_api_mailbox_am(void)
+{
+	int local;
+	int remote;
+	int port;
+	int remote_port;
+	int mbx_in;
+	int mbx_out;
+	uint64_t value;
+	char message[KMAILBOX_MESSAGE_SIZE];
+
+	local  = knode_get_num();
+	remote = (local == MASTER_NODENUM) ? SLAVE_NODENUM : MASTER_NODENUM;
+
+	test_am_count = 0;
+
+	test_assert(am_register(TEST_AM_INCREMENT, test_am_increment) == 0);
+	test_assert(am_register(TEST_AM_ECHO, test_am_echo) == 0);
+	test_assert(am_register(TEST_AM_ECHO, test_am_echo) == -EBUSY);
+
+	/* Ports of handler threads are exchanged on port 0. */
+	test_assert((mbx_in = kmailbox_create(local, 0)) >= 0);
+	test_assert((mbx_out = kmailbox_open(remote, 0)) >= 0);
+	test_assert((port = am_thread_start()) >= 0);
+
+	kmemcpy(message, &port, sizeof(int));
+	test_assert(kmailbox_write(mbx_out, message, KMAILBOX_MESSAGE_SIZE) == KMAILBOX_MESSAGE_SIZE);
+	test_assert(kmailbox_read(mbx_in, message, KMAILBOX_MESSAGE_SIZE) == KMAILBOX_MESSAGE_SIZE);
+	kmemcpy(&remote_port, message, sizeof(int));
+
+	if (local == MASTER_NODENUM)
+	{
+		for (int i = 0; i < NITERATIONS; ++i)
+			test_assert(am_send(remote, remote_port, TEST_AM_INCREMENT, NULL, 0) == 0);
+
+		for (uint64_t i = 0; i < NITERATIONS; ++i)
+		{
+			test_assert(am_call(remote, remote_port, TEST_AM_ECHO, &i, sizeof(uint64_t), &value, sizeof(uint64_t)) == sizeof(uint64_t));
+			test_assert(value == i);
+		}
+
+		test_assert(am_call(remote, remote_port, TEST_AM_MISSING, NULL, 0, NULL, 0) == -ENOTSUP);
+
+		/* Releases the inbox that received the replies. */
+		test_assert(__stdmailbox_cleanup() == 0);
+
+		/* Synchronization message. */
+		test_assert(kmailbox_write(mbx_out, message, KMAILBOX_MESSAGE_SIZE) == KMAILBOX_MESSAGE_SIZE);
+	}
+	else
+	{
+		test_assert(kmailbox_read(mbx_in, message, KMAILBOX_MESSAGE_SIZE) == KMAILBOX_MESSAGE_SIZE);
+		test_assert(test_am_count == NITERATIONS);
+	}
+
+	test_assert(am_thread_stop() == 0);
+	test_assert(am_cleanup() == 0);
+	test_assert(kmailbox_close(mbx_out) == 0);
+	test_assert(kmailbox_unlink(mbx_in) == 0);
+	test_assert(am_unregister(TEST_AM_ECHO) == 0);
+	test_assert(am_unregister(TEST_AM_INCREMENT) == 0);
+}
+
 /*============================================================================*
  * API Test: Pending Messages - Unlink                                        *
  *============================================================================*/
@@ -2278,12 +2882,25 @@ static struct test mailbox_tests_api[] = {
 	{ test_api_mailbox_open_close,         "[test][mailbox][api] mailbox open close         [passed]" },
 	{ test_api_mailbox_get_volume,         "[test][mailbox][api] mailbox get volume         [passed]" },
 	{ test_api_mailbox_get_latency,        "[test][mailbox][api] mailbox get latency        [passed]" },
+	{ test_api_mailbox_get_histogram,      "[test][mailbox][api] mailbox get histogram      [passed]" },
+	{ test_api_mailbox_set_backoff,        "[test][mailbox][api] mailbox set backoff        [passed]" },
+#if TEST_HAS_COUNTERS
 	{ test_api_mailbox_get_counters,       "[test][mailbox][api] mailbox get counters       [passed]" },
+#endif
 	{ test_api_mailbox_read_write,         "[test][mailbox][api] mailbox read write         [passed]" },
 	{ test_api_mailbox_virtualization,     "[test][mailbox][api] mailbox virtualization     [passed]" },
 	{ test_api_mailbox_multiplexation,     "[test][mailbox][api] mailbox multiplexation     [passed]" },
 	{ test_api_mailbox_multiplexation_2,   "[test][mailbox][api] mailbox multiplexation 2   [passed]" },
 	{ test_api_mailbox_multiplexation_3,   "[test][mailbox][api] mailbox multiplexation 3   [passed]" },
+	{ test_api_mailbox_poll,               "[test][mailbox][api] mailbox poll               [passed]" },
+	{ test_api_mailbox_ikcq,               "[test][mailbox][api] mailbox completion queue   [passed]" },
+#if __NANVIX_IKC_COALESCING
+	{ test_api_mailbox_coalescing,         "[test][mailbox][api] mailbox coalescing         [passed]" },
+#endif
+	{ test_api_mailbox_local,              "[test][mailbox][api] mailbox local delivery     [passed]" },
+	{ test_api_mailbox_local_nodes,        "[test][mailbox][api] mailbox local nodes        [passed]" },
+	{ test_api_mailbox_rma,                "[test][mailbox][api] mailbox rma                [passed]" },
+	{ test_api_mailbox_am,                 "[test][mailbox][api] mailbox active messages    [passed]" },
 	{ test_api_mailbox_pending_msg_unlink, "[test][mailbox][api] mailbox pending msg unlink [passed]" },
 	{ test_api_mailbox_msg_forwarding,     "[test][mailbox][api] mailbox message forwarding [passed]" },
 	{ NULL,                                 NULL                                                      },
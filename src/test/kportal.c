@@ -25,6 +25,8 @@
 
 #include <nanvix/sys/portal.h>
 #include <nanvix/sys/noc.h>
+#include <nanvix/sys/pchannel.h>
+#include <nanvix/sys/progress.h>
 #include <nanvix/runtime/fence.h>
 #include <posix/errno.h>
 
@@ -190,6 +192,8 @@ static void test_api_portal_get_latency(void)
 	test_assert(kportal_unlink(portal_in) == 0);
 }
 
+#if TEST_HAS_COUNTERS
+
 /*============================================================================*
  * API Test: Get counters                                                     *
  *============================================================================*/
@@ -242,6 +246,8 @@ static void test_api_portal_get_counters(void)
 	test_assert(kportal_unlink(portal_in) == 0);
 }
 
+#endif /* TEST_HAS_COUNTERS */
+
 /*============================================================================*
  * API Test: Read Write                                                       *
  *============================================================================*/
@@ -257,7 +263,9 @@ static void test_api_portal_read_write(void)
 	int portal_out;
 	size_t volume;
 	uint64_t latency;
+#if TEST_HAS_COUNTERS
 	uint64_t counter;
+#endif
 
 	local  = knode_get_num();
 	remote = (local == MASTER_NODENUM) ? SLAVE_NODENUM : MASTER_NODENUM;
@@ -275,10 +283,12 @@ static void test_api_portal_read_write(void)
 	test_assert(kportal_ioctl(portal_out, KPORTAL_IOCTL_GET_LATENCY, &latency) == 0);
 	test_assert(latency == 0);
 
+#if TEST_HAS_COUNTERS
 	test_assert(kportal_ioctl(portal_in, KPORTAL_IOCTL_GET_NREADS, &counter) == 0);
 	test_assert(counter == 0);
 	test_assert(kportal_ioctl(portal_in, KPORTAL_IOCTL_GET_NWRITES, &counter) == 0);
 	test_assert(counter == 0);
+#endif
 
 	if (local == MASTER_NODENUM)
 	{
@@ -323,10 +333,12 @@ static void test_api_portal_read_write(void)
 	test_assert(volume == (NITERATIONS * PORTAL_SIZE));
 	test_assert(kportal_ioctl(portal_out, KPORTAL_IOCTL_GET_LATENCY, &latency) == 0);
 
+#if TEST_HAS_COUNTERS
 	test_assert(kportal_ioctl(portal_in, KPORTAL_IOCTL_GET_NREADS, &counter) == 0);
 	test_assert(counter == NITERATIONS);
 	test_assert(kportal_ioctl(portal_in, KPORTAL_IOCTL_GET_NWRITES, &counter) == 0);
 	test_assert(counter == NITERATIONS);
+#endif
 
 	test_assert(kportal_close(portal_out) == 0);
 	test_assert(kportal_unlink(portal_in) == 0);
@@ -411,6 +423,149 @@ static void test_api_portal_read_write_large(void)
 	test_assert(kportal_unlink(portal_in) == 0);
 }
 
+#if __NANVIX_IKC_USES_ONLY_MAILBOX
+
+/*============================================================================*
+ * API Test: Read Write Progress                                              *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Read Write with the progress engine.
+ */
+static void test_api_portal_read_write_progress(void)
+{
+	int local;
+	int remote;
+	int portal_in;
+	int portal_out;
+
+	local  = knode_get_num();
+	remote = (local == MASTER_NODENUM) ? SLAVE_NODENUM : MASTER_NODENUM;
+
+	test_assert(!nanvix_ikc_progress_is_running());
+	test_assert(nanvix_ikc_progress_start() == 0);
+	test_assert(nanvix_ikc_progress_start() == -EBUSY);
+	test_assert(nanvix_ikc_progress_is_running());
+
+	test_assert((portal_in = kportal_create(local, 0)) >= 0);
+	test_assert((portal_out = kportal_open(local, remote, 0)) >= 0);
+
+	if (local == MASTER_NODENUM)
+	{
+		for (unsigned i = 0; i < NITERATIONS; i++)
+		{
+			kmemset(message, 0, PORTAL_SIZE_LARGE);
+
+			test_assert(kportal_allow(portal_in, remote, 0) == 0);
+			test_assert(kportal_read(portal_in, message, PORTAL_SIZE_LARGE) == PORTAL_SIZE_LARGE);
+
+			for (unsigned j = 0; j < PORTAL_SIZE_LARGE; ++j)
+				test_assert(message[j] == 1);
+
+			kmemset(message, 2, PORTAL_SIZE_LARGE);
+
+			test_assert(kportal_write(portal_out, message, PORTAL_SIZE_LARGE) == PORTAL_SIZE_LARGE);
+		}
+	}
+	else
+	{
+		for (unsigned i = 0; i < NITERATIONS; i++)
+		{
+			kmemset(message, 1, PORTAL_SIZE_LARGE);
+
+			test_assert(kportal_write(portal_out, message, PORTAL_SIZE_LARGE) == PORTAL_SIZE_LARGE);
+
+			kmemset(message, 0, PORTAL_SIZE_LARGE);
+
+			test_assert(kportal_allow(portal_in, remote, 0) == 0);
+			test_assert(kportal_read(portal_in, message, PORTAL_SIZE_LARGE) == PORTAL_SIZE_LARGE);
+
+			for (unsigned j = 0; j < PORTAL_SIZE_LARGE; ++j)
+				test_assert(message[j] == 2);
+		}
+	}
+
+	test_assert(kportal_close(portal_out) == 0);
+	test_assert(kportal_unlink(portal_in) == 0);
+
+	test_assert(nanvix_ikc_progress_stop() == 0);
+	test_assert(nanvix_ikc_progress_stop() == -EINVAL);
+	test_assert(!nanvix_ikc_progress_is_running());
+}
+
+#endif /* __NANVIX_IKC_USES_ONLY_MAILBOX */
+
+/*============================================================================*
+ * API Test: Persistent Channels                                              *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Persistent Channels
+ */
+static void test_api_portal_persistent(void)
+{
+	int local;
+	int remote;
+	int ch_in;
+	int ch_out;
+
+	local  = knode_get_num();
+	remote = (local == MASTER_NODENUM) ? SLAVE_NODENUM : MASTER_NODENUM;
+
+	/* Negotiates both channels, in opposite orders to not deadlock. */
+	if (local == MASTER_NODENUM)
+	{
+		test_assert((ch_out = kpchannel_send_init(local, remote, 0, message, PORTAL_SIZE_LARGE)) >= 0);
+		test_assert((ch_in = kpchannel_recv_init(local, remote, 0, message, PORTAL_SIZE_LARGE)) >= 0);
+	}
+	else
+	{
+		test_assert((ch_in = kpchannel_recv_init(local, remote, 0, message, PORTAL_SIZE_LARGE)) >= 0);
+		test_assert((ch_out = kpchannel_send_init(local, remote, 0, message, PORTAL_SIZE_LARGE)) >= 0);
+	}
+
+	test_assert(kpchannel_complete(ch_in) == -EINVAL);
+
+	for (unsigned i = 0; i < NITERATIONS; i++)
+	{
+		if (local == MASTER_NODENUM)
+		{
+			kmemset(message, 0, PORTAL_SIZE_LARGE);
+
+			test_assert(kpchannel_start(ch_in) == 0);
+			test_assert(kpchannel_start(ch_in) == -EBUSY);
+			test_assert(kpchannel_complete(ch_in) == PORTAL_SIZE_LARGE);
+
+			for (unsigned j = 0; j < PORTAL_SIZE_LARGE; ++j)
+				test_assert(message[j] == 1);
+
+			kmemset(message, 2, PORTAL_SIZE_LARGE);
+
+			test_assert(kpchannel_start(ch_out) == 0);
+			test_assert(kpchannel_complete(ch_out) == PORTAL_SIZE_LARGE);
+		}
+		else
+		{
+			kmemset(message, 1, PORTAL_SIZE_LARGE);
+
+			test_assert(kpchannel_start(ch_out) == 0);
+			test_assert(kpchannel_complete(ch_out) == PORTAL_SIZE_LARGE);
+
+			kmemset(message, 0, PORTAL_SIZE_LARGE);
+
+			test_assert(kpchannel_start(ch_in) == 0);
+			test_assert(kpchannel_complete(ch_in) == PORTAL_SIZE_LARGE);
+
+			for (unsigned j = 0; j < PORTAL_SIZE_LARGE; ++j)
+				test_assert(message[j] == 2);
+		}
+	}
+
+	test_assert(kpchannel_free(ch_out) == 0);
+	test_assert(kpchannel_free(ch_in) == 0);
+	test_assert(kpchannel_free(ch_in) == -EBADF);
+}
+
 /*============================================================================*
  * API Test: Virtualization                                                   *
  *============================================================================*/
@@ -2437,9 +2592,15 @@ static struct test portal_tests_api[] = {
 	{ test_api_portal_open_close,             "[test][portal][api] portal open close             [passed]" },
 	{ test_api_portal_get_volume,             "[test][portal][api] portal get volume             [passed]" },
 	{ test_api_portal_get_latency,            "[test][portal][api] portal get latency            [passed]" },
+#if TEST_HAS_COUNTERS
 	{ test_api_portal_get_counters,           "[test][portal][api] portal get counters           [passed]" },
+#endif
 	{ test_api_portal_read_write,             "[test][portal][api] portal read write             [passed]" },
 	{ test_api_portal_read_write_large,       "[test][portal][api] portal read write large       [passed]" },
+#if __NANVIX_IKC_USES_ONLY_MAILBOX
+	{ test_api_portal_read_write_progress,    "[test][portal][api] portal read write progress    [passed]" },
+#endif
+	{ test_api_portal_persistent,             "[test][portal][api] portal persistent channels    [passed]" },
 	{ test_api_portal_virtualization,         "[test][portal][api] portal virtualization         [passed]" },
 	{ test_api_portal_multiplexation,         "[test][portal][api] portal multiplexation         [passed]" },
 	{ test_api_portal_allow,                  "[test][portal][api] portal allow                  [passed]" },
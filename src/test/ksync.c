@@ -25,6 +25,7 @@
 
 #include <nanvix/sys/sync.h>
 #include <nanvix/sys/noc.h>
+#include <nanvix/runtime/barrier.h>
 #include <posix/errno.h>
 
 #include "test.h"
@@ -171,6 +172,8 @@ static void test_api_sync_get_latency(void)
 	test_assert(ksync_unlink(syncin) == 0);
 }
 
+#if TEST_HAS_COUNTERS
+
 /*============================================================================*
  * API Test: Get counters                                                     *
  *============================================================================*/
@@ -229,6 +232,8 @@ static void test_api_sync_get_counters(void)
 	test_assert(ksync_unlink(syncin) == 0);
 }
 
+#endif /* TEST_HAS_COUNTERS */
+
 /*============================================================================*
  * API Test: Virtualization                                                   *
  *============================================================================*/
@@ -298,7 +303,9 @@ void test_api_sync_signal_wait(void)
 	int nodenum;
 	int nodes[NR_NODES];
 	uint64_t latency;
+#if TEST_HAS_COUNTERS
 	uint64_t counter;
+#endif
 
 	nodenum = knode_get_num();
 	nodes[0] = MASTER_NODENUM;
@@ -321,10 +328,12 @@ void test_api_sync_signal_wait(void)
 		test_assert(ksync_ioctl(syncout, KSYNC_IOCTL_GET_LATENCY, &latency) == 0);
 		test_assert(latency == 0);
 
+#if TEST_HAS_COUNTERS
 		test_assert(ksync_ioctl(syncout, KSYNC_IOCTL_GET_NWAITS, &counter) == 0);
 		test_assert(counter == 0);
 		test_assert(ksync_ioctl(syncout, KSYNC_IOCTL_GET_NSIGNALS, &counter) == 0);
 		test_assert(counter == 0);
+#endif
 
 		for (int i = 0; i < NITERATIONS; i++)
 		{
@@ -342,10 +351,12 @@ void test_api_sync_signal_wait(void)
 		test_assert(ksync_ioctl(syncout, KSYNC_IOCTL_GET_LATENCY, &latency) == 0);
 		test_assert(latency == 0);
 
+#if TEST_HAS_COUNTERS
 		test_assert(ksync_ioctl(syncout, KSYNC_IOCTL_GET_NWAITS, &counter) == 0);
 		test_assert(counter == 0);
 		test_assert(ksync_ioctl(syncout, KSYNC_IOCTL_GET_NSIGNALS, &counter) == 0);
 		test_assert(counter == 0);
+#endif
 
 		test_delay(1, CLUSTER_FREQ);
 
@@ -359,15 +370,108 @@ void test_api_sync_signal_wait(void)
 	test_assert(ksync_ioctl(syncin, KSYNC_IOCTL_GET_LATENCY, &latency) == 0);
 	test_assert(ksync_ioctl(syncout, KSYNC_IOCTL_GET_LATENCY, &latency) == 0);
 
+#if TEST_HAS_COUNTERS
 	test_assert(ksync_ioctl(syncout, KSYNC_IOCTL_GET_NWAITS, &counter) == 0);
 	test_assert(counter == NITERATIONS);
 	test_assert(ksync_ioctl(syncout, KSYNC_IOCTL_GET_NSIGNALS, &counter) == 0);
 	test_assert(counter == NITERATIONS);
+#endif
+
+	test_assert(ksync_close(syncout) == 0);
+	test_assert(ksync_unlink(syncin) == 0);
+}
+
+/*============================================================================*
+ * API Test: Signal Async                                                     *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Synchronization Point Asynchronous Signal
+ */
+void test_api_sync_signal_async(void)
+{
+	int syncin;
+	int syncout;
+	int nodenum;
+	int nodes[NR_NODES];
+
+	nodenum = knode_get_num();
+	nodes[0] = MASTER_NODENUM;
+
+	for (int i = 0, j = 1; i < NR_NODES; i++)
+	{
+		if (nodenums[i] == MASTER_NODENUM)
+			continue;
+
+		nodes[j++] = nodenums[i];
+	}
+
+	if (nodenum != MASTER_NODENUM)
+	{
+		test_assert((syncin = ksync_create(nodes, NR_NODES, SYNC_ONE_TO_ALL)) >= 0);
+		test_assert((syncout = ksync_open(nodes, NR_NODES, SYNC_ALL_TO_ONE)) >= 0);
+
+		for (int i = 0; i < NITERATIONS; i++)
+		{
+			test_assert(ksync_wait(syncin) == 0);
+			test_assert(ksync_signal_async(syncout) == 0);
+		}
+	}
+	else
+	{
+		test_assert((syncin = ksync_create(nodes, NR_NODES, SYNC_ALL_TO_ONE)) >= 0);
+		test_assert((syncout = ksync_open(nodes, NR_NODES, SYNC_ONE_TO_ALL)) >= 0);
+
+		test_delay(1, CLUSTER_FREQ);
+
+		for (int i = 0; i < NITERATIONS; i++)
+		{
+			test_assert(ksync_signal_async(syncout) == 0);
+			test_assert(ksync_wait(syncin) == 0);
+		}
+	}
 
 	test_assert(ksync_close(syncout) == 0);
 	test_assert(ksync_unlink(syncin) == 0);
 }
 
+/*============================================================================*
+ * API Test: Split-Phase Barrier                                              *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Split-Phase Barrier
+ */
+void test_api_sync_barrier_arrive(void)
+{
+	int nodes[NR_NODES];
+	barrier_t barrier;
+
+	nodes[0] = MASTER_NODENUM;
+
+	for (int i = 0, j = 1; i < NR_NODES; i++)
+	{
+		if (nodenums[i] == MASTER_NODENUM)
+			continue;
+
+		nodes[j++] = nodenums[i];
+	}
+
+	barrier = barrier_create(nodes, NR_NODES);
+	test_assert(BARRIER_IS_VALID(barrier));
+
+		for (int i = 0; i < NITERATIONS; i++)
+		{
+			test_assert(barrier_arrive(barrier) == 0);
+			test_assert(barrier_wait_arrived(barrier) == 0);
+		}
+
+		/* Mixes with whole barriers. */
+		test_assert(barrier_wait(barrier) == 0);
+
+	test_assert(barrier_destroy(barrier) == 0);
+}
+
 /*============================================================================*
  * API Test: Multiplexation                                                   *
  *============================================================================*/
@@ -864,6 +968,8 @@ void test_fault_sync_invalid_signal(void)
 {
 	test_assert(ksync_signal(-1) == -EINVAL);
 	test_assert(ksync_signal(KSYNC_MAX) == -EINVAL);
+	test_assert(ksync_signal_async(-1) == -EINVAL);
+	test_assert(ksync_signal_async(KSYNC_MAX) == -EINVAL);
 }
 
 /*============================================================================*
@@ -894,6 +1000,7 @@ void test_fault_sync_bad_signal(void)
 	test_assert((syncid = ksync_create(nodes, NR_NODES, SYNC_ALL_TO_ONE)) >= 0);
 
 		test_assert(ksync_signal(syncid) == -EBADF);
+		test_assert(ksync_signal_async(syncid) == -EBADF);
 
 	test_assert(ksync_unlink(syncid) == 0);
 }
@@ -1030,9 +1137,13 @@ static struct test sync_tests_api[] = {
 	{ test_api_sync_create_unlink,  "[test][sync][api] sync create/unlink  [passed]" },
 	{ test_api_sync_open_close,     "[test][sync][api] sync open/close     [passed]" },
 	{ test_api_sync_get_latency,    "[test][sync][api] sync get latency    [passed]" },
+#if TEST_HAS_COUNTERS
 	{ test_api_sync_get_counters,   "[test][sync][api] sync get counters   [passed]" },
+#endif
 	{ test_api_sync_virtualization, "[test][sync][api] sync virtualization [passed]" },
 	{ test_api_sync_signal_wait,    "[test][sync][api] sync wait           [passed]" },
+	{ test_api_sync_signal_async,   "[test][sync][api] sync signal async   [passed]" },
+	{ test_api_sync_barrier_arrive, "[test][sync][api] sync barrier arrive [passed]" },
 	{ test_api_sync_multiplexation, "[test][sync][api] sync multiplexation [passed]" },
 	{ NULL,                          NULL                                            },
 };
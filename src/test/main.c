@@ -132,6 +132,7 @@ void ___start(int argc, const char *argv[])
 			test_page_mgmt();
 			test_thread_mgmt();
 			test_thread_sleep();
+			test_tls();
 		#if (CORES_NUM > 1)
 			test_mutex();
 			test_semaphore();
@@ -143,6 +144,7 @@ void ___start(int argc, const char *argv[])
 			test_signal();
 		#endif /* __unix64__ */
 
+			test_trace();
 			test_noc();
 		}
 
@@ -175,6 +177,12 @@ void ___start(int argc, const char *argv[])
 					test_ikc();
 				#endif
 
+				test_barrier_nodes();
+
+				#if __TARGET_HAS_PORTAL
+					test_collective(_nodenums, NR_NODES);
+				#endif
+
 				/* Waits everyone finishes the routines. */
 				test_barrier_nodes();
 
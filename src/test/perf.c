@@ -23,6 +23,7 @@
  */
 
 #include <nanvix/sys/perf.h>
+#include <nanvix/runtime/perfsession.h>
 #include <posix/stdint.h>
 #include "test.h"
 
@@ -66,14 +67,111 @@ void test_api_nanvix_perf_read(void)
 	nanvix_perf_read(0);
 }
 
+/*============================================================================*
+ * Performance Monitoring Sessions                                            *
+ *============================================================================*/
+
+/**
+ * @brief Performance monitoring session used in the tests.
+ */
+static struct nanvix_perf_session session;
+
+/**
+ * @brief Finds an event that may be monitored in the underlying core.
+ *
+ * @returns An event that may be monitored, or -1 if there is none.
+ */
+static int test_perf_supported_event(void)
+{
+	for (int i = 0; i < PERF_EVENTS_MAX; i++)
+	{
+		if (nanvix_perf_query(i) > 0)
+			return (i);
+	}
+
+	return (-1);
+}
+
+/**
+ * @brief API Test: Start/Stop Performance Monitoring Session
+ */
+void test_api_nanvix_perf_session_start_stop(void)
+{
+	int events[1];
+	struct nanvix_perf_result results[NANVIX_PERF_SESSION_EVENTS_MAX];
+
+	/* No event to watch. */
+	if ((events[0] = test_perf_supported_event()) < 0)
+		return;
+
+	test_assert(nanvix_perf_session_init(&session, events, 1) == 0);
+	test_assert(nanvix_perf_session_start(&session) == 0);
+	test_assert(nanvix_perf_session_stop(&session) == 0);
+
+	test_assert(nanvix_perf_session_results(&session, NANVIX_PERF_SESSION_ALL, results) == 1);
+	test_assert(results[0].event == events[0]);
+	test_assert(results[0].nruns == 1);
+	test_assert(results[0].nsamples == 1);
+	test_assert(results[0].estimate == results[0].value);
+
+#if (TEST_PERF_VERBOSE)
+	test_assert(nanvix_perf_session_print(&session, NANVIX_PERF_SESSION_ALL) == 0);
+#endif
+}
+
+/**
+ * @brief API Test: Multiplex Performance Monitoring Session
+ */
+void test_api_nanvix_perf_session_multiplex(void)
+{
+	int event;
+	int nevents;
+	int events[NANVIX_PERF_SESSION_EVENTS_MAX];
+	struct nanvix_perf_result results[NANVIX_PERF_SESSION_EVENTS_MAX];
+
+	/* Not enough events to multiplex. */
+	if (NANVIX_PERF_SESSION_EVENTS_MAX <= NANVIX_PERF_SESSION_MONITORS)
+		return;
+
+	/* No event to watch. */
+	if ((event = test_perf_supported_event()) < 0)
+		return;
+
+	nevents = NANVIX_PERF_SESSION_MONITORS + 1;
+	for (int i = 0; i < nevents; i++)
+		events[i] = event;
+
+	test_assert(nanvix_perf_session_init(&session, events, nevents) == 0);
+
+	/* One run for each group of events. */
+	for (int i = 0; i < 2; i++)
+	{
+		test_assert(nanvix_perf_session_start(&session) == 0);
+		test_assert(nanvix_perf_session_stop(&session) == 0);
+	}
+
+	test_assert(nanvix_perf_session_results(&session, NANVIX_PERF_SESSION_ALL, results) == nevents);
+	for (int i = 0; i < nevents; i++)
+	{
+		test_assert(results[i].nruns == 2);
+		test_assert(results[i].nsamples == 1);
+	}
+
+	test_assert(nanvix_perf_session_reset(&session) == 0);
+	test_assert(nanvix_perf_session_results(&session, NANVIX_PERF_SESSION_ALL, results) == nevents);
+	test_assert(results[0].nruns == 0);
+}
+
 /**
  * @brief API tests.
  */
 static struct test perf_tests_api[] = {
-	{ test_api_nanvix_perf_query,      "[test][perf][api] query performance monitoring capabilities [passed]" },
-	{ test_api_nanvix_perf_start_stop, "[test][perf][api] start/stop performance monitor            [passed]" },
-	{ test_api_nanvix_perf_read,       "[test][perf][api] read performance monitor                  [passed]" },
-	{ NULL,                             NULL                                                                  },
+	{ test_api_nanvix_perf_query,              "[test][perf][api] query performance monitoring capabilities [passed]" },
+	{ test_api_nanvix_perf_start_stop,         "[test][perf][api] start/stop performance monitor            [passed]" },
+	{ test_api_nanvix_perf_read,               "[test][perf][api] read performance monitor                  [passed]" },
+	{ test_api_nanvix_perf_session_start_stop, "[test][perf][api] start/stop performance session            [passed]" },
+	{ test_api_nanvix_perf_session_multiplex,  "[test][perf][api] multiplex performance session             [passed]" },
+	{ NULL,                                    NULL                                                                  },
 };
 
 #endif
@@ -25,6 +25,7 @@
 #ifndef _TEST_H_
 #define _TEST_H_
 
+	#include <nanvix/sys/counters.h>
 	#include <nanvix/sys/thread.h>
 
 	/**
@@ -67,6 +68,11 @@
 	 */
 	#define NITERATIONS 10
 
+	/**
+	 * @brief Are communicator counters kept?
+	 */
+	#define TEST_HAS_COUNTERS (!__NANVIX_IKC_USES_ONLY_MAILBOX || __NANVIX_IKC_STATS)
+
 	/**
 	 * @brief Number of threads to spawn in stress tests.
 	 */
@@ -115,6 +121,8 @@
 	extern void test_condition_variables(void);
 	extern void test_mutex(void);
 	extern void test_perf(void);
+	extern void test_trace(void);
+	extern void test_tls(void);
 	extern void test_signal(void);
 	extern void test_network(void);
 	extern void test_noc(void);
@@ -122,6 +130,7 @@
 	extern void test_mailbox(void);
 	extern void test_portal(void);
 	extern void test_ikc(void);
+	extern void test_collective(const int *nodes, int nnodes);
 	extern void test_semaphore(void);
 
 	/**@}*/
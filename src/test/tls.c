@@ -0,0 +1,262 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <nanvix/sys/thread.h>
+#include <nanvix/sys/tls.h>
+#include "test.h"
+
+/**
+ * @brief Dummy values.
+ */
+PRIVATE int tls_values[NTHREADS + 1];
+
+/**
+ * @brief Values destroyed by the destructor.
+ */
+PRIVATE int *tls_destroyed[NTHREADS];
+
+/**
+ * @brief Key used by threads.
+ */
+PRIVATE nanvix_tls_key_t tls_key;
+
+/**
+ * @brief Records a destroyed value.
+ *
+ * @param value Destroyed value.
+ */
+PRIVATE void tls_destructor(void *value)
+{
+	int *p = value;
+
+	tls_destroyed[p - tls_values] = p;
+}
+
+/*============================================================================*
+ * API Tests                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Create/Delete Keys
+ */
+PRIVATE void test_api_tls_key_create_delete(void)
+{
+	nanvix_tls_key_t key;
+
+	test_assert(nanvix_tls_key_create(&key, NULL) == 0);
+	test_assert(nanvix_tls_get(key) == NULL);
+
+	test_assert(nanvix_tls_set(key, &tls_values[0]) == 0);
+	test_assert(nanvix_tls_get(key) == &tls_values[0]);
+
+	test_assert(nanvix_tls_key_delete(key) == 0);
+
+	/* Reused keys start cleared. */
+	test_assert(nanvix_tls_key_create(&key, NULL) == 0);
+	test_assert(nanvix_tls_get(key) == NULL);
+	test_assert(nanvix_tls_key_delete(key) == 0);
+}
+
+#if (CORES_NUM > 1)
+
+/**
+ * @brief Sets and checks a thread-local value.
+ *
+ * @param arg Value.
+ */
+PRIVATE void * task_tls_set_get(void *arg)
+{
+	test_assert(nanvix_tls_get(tls_key) == NULL);
+
+	for (int i = 0; i < NITERATIONS; i++)
+	{
+		test_assert(nanvix_tls_set(tls_key, arg) == 0);
+		test_assert(nanvix_tls_get(tls_key) == arg);
+	}
+
+	return (NULL);
+}
+
+/**
+ * @brief Sets a thread-local value and exits.
+ *
+ * @param arg Value.
+ */
+PRIVATE void * task_tls_exit(void *arg)
+{
+	test_assert(nanvix_tls_set(tls_key, arg) == 0);
+
+	kthread_exit(NULL);
+
+	return (NULL);
+}
+
+/**
+ * @brief API Test: Thread-Local Values
+ */
+PRIVATE void test_api_tls_threads(void)
+{
+	int nthreads;
+	kthread_t tids[NTHREADS];
+
+	nthreads = (NTHREADS < (CORES_NUM - 1)) ? NTHREADS : (CORES_NUM - 1);
+
+	test_assert(nanvix_tls_key_create(&tls_key, NULL) == 0);
+	test_assert(nanvix_tls_set(tls_key, &tls_values[NTHREADS]) == 0);
+
+	for (int i = 0; i < nthreads; i++)
+		test_assert(kthread_create(&tids[i], task_tls_set_get, &tls_values[i]) == 0);
+
+	for (int i = 0; i < nthreads; i++)
+		test_assert(kthread_join(tids[i], NULL) == 0);
+
+	/* Not changed by other threads. */
+	test_assert(nanvix_tls_get(tls_key) == &tls_values[NTHREADS]);
+
+	test_assert(nanvix_tls_key_delete(tls_key) == 0);
+}
+
+/**
+ * @brief API Test: Destructors
+ */
+PRIVATE void test_api_tls_destructor(void)
+{
+	int nthreads;
+	kthread_t tids[NTHREADS];
+
+	nthreads = (NTHREADS < (CORES_NUM - 1)) ? NTHREADS : (CORES_NUM - 1);
+
+	for (int i = 0; i < nthreads; i++)
+		tls_destroyed[i] = NULL;
+
+	test_assert(nanvix_tls_key_create(&tls_key, tls_destructor) == 0);
+
+	for (int i = 0; i < nthreads; i++)
+		test_assert(kthread_create(&tids[i], task_tls_exit, &tls_values[i]) == 0);
+
+	for (int i = 0; i < nthreads; i++)
+		test_assert(kthread_join(tids[i], NULL) == 0);
+
+	for (int i = 0; i < nthreads; i++)
+		test_assert(tls_destroyed[i] == &tls_values[i]);
+
+	test_assert(nanvix_tls_key_delete(tls_key) == 0);
+}
+
+#endif /* CORES_NUM > 1 */
+
+/*============================================================================*
+ * Fault Tests                                                                *
+ *============================================================================*/
+
+/**
+ * @brief Fault Test: Invalid Keys
+ */
+PRIVATE void test_fault_tls_invalid_key(void)
+{
+	nanvix_tls_key_t key;
+
+	test_assert(nanvix_tls_key_create(NULL, NULL) == -EINVAL);
+	test_assert(nanvix_tls_key_delete(-1) == -EINVAL);
+	test_assert(nanvix_tls_key_delete(NANVIX_TLS_KEYS_MAX) == -EINVAL);
+	test_assert(nanvix_tls_set(-1, &tls_values[0]) == -EINVAL);
+	test_assert(nanvix_tls_set(NANVIX_TLS_KEYS_MAX, &tls_values[0]) == -EINVAL);
+	test_assert(nanvix_tls_get(-1) == NULL);
+	test_assert(nanvix_tls_get(NANVIX_TLS_KEYS_MAX) == NULL);
+
+	/* Deleted twice. */
+	test_assert(nanvix_tls_key_create(&key, NULL) == 0);
+	test_assert(nanvix_tls_key_delete(key) == 0);
+	test_assert(nanvix_tls_key_delete(key) == -EINVAL);
+
+	/* Threads out of the slots. */
+	test_assert(nanvix_tls_slot(SYS_THREAD_MAX - 1 + NANVIX_TLS_THREADS) < 0);
+	test_assert(nanvix_tls_block_of(SYS_THREAD_MAX - 1 + NANVIX_TLS_THREADS) == NULL);
+}
+
+/**
+ * @brief Fault Test: Too Many Keys
+ */
+PRIVATE void test_fault_tls_too_many_keys(void)
+{
+	nanvix_tls_key_t key;
+	nanvix_tls_key_t keys[NANVIX_TLS_KEYS_MAX];
+
+	for (int i = 0; i < NANVIX_TLS_KEYS_MAX; i++)
+		test_assert(nanvix_tls_key_create(&keys[i], NULL) == 0);
+
+	test_assert(nanvix_tls_key_create(&key, NULL) == -EAGAIN);
+
+	for (int i = 0; i < NANVIX_TLS_KEYS_MAX; i++)
+		test_assert(nanvix_tls_key_delete(keys[i]) == 0);
+}
+
+/*============================================================================*
+ * Test Driver                                                                *
+ *============================================================================*/
+
+/**
+ * @brief API tests.
+ */
+PRIVATE struct test tls_tests_api[] = {
+	{ test_api_tls_key_create_delete, "[test][tls][api] create/delete keys            [passed]" },
+#if (CORES_NUM > 1)
+	{ test_api_tls_threads,           "[test][tls][api] thread-local values           [passed]" },
+	{ test_api_tls_destructor,        "[test][tls][api] destructors                   [passed]" },
+#endif
+	{ NULL,                            NULL                                                    },
+};
+
+/**
+ * @brief Fault tests.
+ */
+PRIVATE struct test tls_tests_fault[] = {
+	{ test_fault_tls_invalid_key,   "[test][tls][fault] invalid keys                [passed]" },
+	{ test_fault_tls_too_many_keys, "[test][tls][fault] too many keys               [passed]" },
+	{ NULL,                          NULL                                                    },
+};
+
+/**
+ * The test_tls() function launches testing units on the thread-local
+ * storage facility.
+ */
+PUBLIC void test_tls(void)
+{
+	/* API Tests */
+	nanvix_puts("--------------------------------------------------------------------------------");
+	for (int i = 0; tls_tests_api[i].test_fn != NULL; i++)
+	{
+		tls_tests_api[i].test_fn();
+		nanvix_puts(tls_tests_api[i].name);
+	}
+
+	/* Fault Tests */
+	nanvix_puts("--------------------------------------------------------------------------------");
+	for (int i = 0; tls_tests_fault[i].test_fn != NULL; i++)
+	{
+		tls_tests_fault[i].test_fn();
+		nanvix_puts(tls_tests_fault[i].name);
+	}
+}
@@ -0,0 +1,145 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/sys/trace.h>
+#include <posix/stdint.h>
+#include "test.h"
+
+#if (__NANVIX_IKC_TRACE)
+
+/**
+ * @brief Size of the dump buffer.
+ */
+#define TEST_TRACE_DUMP_SIZE                                     \
+	(sizeof(struct nanvix_trace_header)                        + \
+	 sizeof(struct nanvix_trace_thread)                        + \
+	 NANVIX_TRACE_BUFFER_SIZE*sizeof(struct nanvix_trace_event))
+
+/**
+ * @brief Dump buffer.
+ */
+static char dump[TEST_TRACE_DUMP_SIZE];
+
+/*============================================================================*
+ * API Tests                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Emit/Dump Trace Events
+ */
+static void test_api_nanvix_trace_emit_dump(void)
+{
+	ssize_t size;
+	struct nanvix_trace_header *header;
+	struct nanvix_trace_thread *thread;
+	struct nanvix_trace_event *events;
+
+	nanvix_trace_reset();
+
+	test_assert(nanvix_trace_dump(NULL, 0) == sizeof(struct nanvix_trace_header));
+
+	nanvix_trace_emit(NANVIX_TRACE_KPORTAL_WRITE, NANVIX_TRACE_PHASE_BEGIN, 1, 0);
+	nanvix_trace_emit(NANVIX_TRACE_KPORTAL_WRITE, NANVIX_TRACE_PHASE_END, 1, 64);
+
+	size = nanvix_trace_dump(dump, sizeof(dump));
+	test_assert(size == nanvix_trace_dump(NULL, 0));
+	test_assert(nanvix_trace_dump(dump, size - 1) < 0);
+
+	header = (struct nanvix_trace_header *) dump;
+	thread = (struct nanvix_trace_thread *) (header + 1);
+	events = (struct nanvix_trace_event *) (thread + 1);
+
+	test_assert(header->magic == NANVIX_TRACE_MAGIC);
+	test_assert(header->version == NANVIX_TRACE_VERSION);
+	test_assert(header->nthreads == 1);
+	test_assert(thread->nevents == 2);
+	test_assert(events[0].type == NANVIX_TRACE_KPORTAL_WRITE);
+	test_assert(events[0].phase == NANVIX_TRACE_PHASE_BEGIN);
+	test_assert(events[1].phase == NANVIX_TRACE_PHASE_END);
+	test_assert(events[1].arg == 64);
+	test_assert(events[0].timestamp <= events[1].timestamp);
+
+	nanvix_trace_reset();
+}
+
+/**
+ * @brief API Test: Overwrite Oldest Trace Events
+ */
+static void test_api_nanvix_trace_overwrite(void)
+{
+	struct nanvix_trace_header *header;
+	struct nanvix_trace_thread *thread;
+	struct nanvix_trace_event *events;
+
+	nanvix_trace_reset();
+
+	for (int i = 0; i < (NANVIX_TRACE_BUFFER_SIZE + 2); i++)
+		nanvix_trace_emit(NANVIX_TRACE_CHUNK_SEND, NANVIX_TRACE_PHASE_INSTANT, 0, i);
+
+	test_assert(nanvix_trace_dump(dump, sizeof(dump)) == sizeof(dump));
+
+	header = (struct nanvix_trace_header *) dump;
+	thread = (struct nanvix_trace_thread *) (header + 1);
+	events = (struct nanvix_trace_event *) (thread + 1);
+
+	test_assert(thread->nevents == NANVIX_TRACE_BUFFER_SIZE);
+	test_assert(events[0].arg == 2);
+	test_assert(events[NANVIX_TRACE_BUFFER_SIZE - 1].arg == (NANVIX_TRACE_BUFFER_SIZE + 1));
+
+	nanvix_trace_reset();
+}
+
+/**
+ * @brief API tests.
+ */
+static struct test trace_tests_api[] = {
+	{ test_api_nanvix_trace_emit_dump, "[test][trace][api] emit/dump trace events     [passed]" },
+	{ test_api_nanvix_trace_overwrite, "[test][trace][api] overwrite oldest events    [passed]" },
+	{ NULL,                            NULL                                                    },
+};
+
+#endif /* __NANVIX_IKC_TRACE */
+
+/*============================================================================*
+ * Test Driver                                                                *
+ *============================================================================*/
+
+/**
+ * The test_trace() function launches testing units on the tracing
+ * facility of IKC operations.
+ */
+void test_trace(void)
+{
+#if (__NANVIX_IKC_TRACE)
+
+	/* API Tests */
+	nanvix_puts("--------------------------------------------------------------------------------");
+	for (int i = 0; trace_tests_api[i].test_fn != NULL; i++)
+	{
+		trace_tests_api[i].test_fn();
+		nanvix_puts(trace_tests_api[i].name);
+	}
+
+#endif /* __NANVIX_IKC_TRACE */
+}